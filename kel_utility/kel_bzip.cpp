@@ -5,6 +5,7 @@
 #include "zlib.h"
 
 #include <fstream>
+#include <cstring>
 
 #include "kel_bzip.h"
 #include "kel_exec_env.h"
@@ -525,3 +526,219 @@ void kel::BGZReader::assembleRecords() {
 
 
 
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Block gzip writer.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+bool kel::BGZWriter::open(const std::string &file_name) {
+
+  close();
+
+  try {
+
+    file_name_ = file_name;
+    bgz_file_.open(file_name_, std::ios::binary | std::ios::trunc);
+    if (not bgz_file_.good()) {
+
+      ExecEnv::log().error("BGZWriter::open; I/O error; could not open file: {}", file_name);
+      compression_error_ = true;
+      return false;
+
+    }
+
+  }
+  catch (std::exception const &e) {
+
+    ExecEnv::log().error("BGZWriter::open; File: {} unexpected I/O exception: {}", file_name, e.what());
+    compression_error_ = true;
+    return false;
+
+  }
+
+  compression_error_ = false;
+  block_buffer_.reserve(MAX_BLOCK_DATA_);
+
+  return true;
+
+}
+
+
+bool kel::BGZWriter::write(std::string_view text) {
+
+  if (not bgz_file_.is_open()) {
+
+    ExecEnv::log().error("BGZWriter::write; file is not open");
+    return false;
+
+  }
+
+  while (not text.empty()) {
+
+    size_t copy_size = std::min(text.size(), MAX_BLOCK_DATA_ - block_buffer_.size());
+    block_buffer_.append(text.substr(0, copy_size));
+    text.remove_prefix(copy_size);
+
+    if (block_buffer_.size() >= MAX_BLOCK_DATA_) {
+
+      queueBlock();
+
+    }
+
+  }
+
+  return not compression_error_;
+
+}
+
+
+bool kel::BGZWriter::close() {
+
+  if (not bgz_file_.is_open()) {
+
+    return not compression_error_;
+
+  }
+
+  if (not block_buffer_.empty()) {
+
+    queueBlock();
+
+  }
+
+  writeBlocks(0);
+  bgz_file_.write(reinterpret_cast<const char*>(BGZReader::EOF_MARKER_), BGZReader::EOF_MARKER_SIZE_);
+  if (not bgz_file_.good()) {
+
+    ExecEnv::log().error("BGZWriter::close; I/O error writing EOF marker to file: {}", file_name_);
+    compression_error_ = true;
+
+  }
+
+  bgz_file_.close();
+
+  return not compression_error_;
+
+}
+
+
+void kel::BGZWriter::queueBlock() {
+
+  std::string block_data;
+  block_data.swap(block_buffer_);
+  block_buffer_.reserve(MAX_BLOCK_DATA_);
+
+  pending_blocks_.push_back(compress_threads_.enqueueTask(&BGZWriter::compressBlock, std::move(block_data)));
+  writeBlocks(max_pending_blocks_);
+
+}
+
+
+void kel::BGZWriter::writeBlocks(size_t max_pending) {
+
+  while (pending_blocks_.size() > max_pending) {
+
+    std::vector<std::byte> gzip_block = pending_blocks_.front().get();
+    pending_blocks_.pop_front();
+
+    if (gzip_block.empty()) {
+
+      compression_error_ = true;
+      continue;
+
+    }
+
+    bgz_file_.write(reinterpret_cast<const char*>(gzip_block.data()), static_cast<std::streamsize>(gzip_block.size()));
+    if (not bgz_file_.good()) {
+
+      ExecEnv::log().error("BGZWriter::writeBlocks; I/O error writing to file: {}", file_name_);
+      compression_error_ = true;
+
+    }
+
+  }
+
+}
+
+
+// The gzip header and trailer are written around the raw deflate data.
+std::vector<std::byte> kel::BGZWriter::compressBlock(std::string block_data) {
+
+  std::vector<std::byte> gzip_block(MAX_BLOCK_SIZE_);
+  size_t compressed_size{0};
+
+  // Incompressible data is stored (level 0), which always fits the block.
+  if (not deflateBlock(block_data, Z_DEFAULT_COMPRESSION, gzip_block, compressed_size)
+      and not deflateBlock(block_data, Z_NO_COMPRESSION, gzip_block, compressed_size)) {
+
+    ExecEnv::log().error("BGZWriter::compressBlock; unable to deflate block, uncompressed size: {}", block_data.size());
+    return {};
+
+  }
+
+  const size_t block_size = GZIP_HEADER_SIZE_ + compressed_size + BGZReader::TRAILER_SIZE_;
+
+  GZHeaderblock header_block{};
+  header_block.block_id_1 = BGZReader::BLOCK_ID1_;
+  header_block.block_id_2 = BGZReader::BLOCK_ID2_;
+  header_block.compression_method = BGZReader::COMPRESSION_;
+  header_block.flags = BGZReader::FLAGS_;
+  header_block.mtime = 0;
+  header_block.extra_flags = 0;
+  header_block.operating_system = OPERATING_SYSTEM_;
+  header_block.length_extra_blocks = BGZReader::EXTRA_LENGTH_;
+  header_block.subfield_id_1 = BGZReader::SUBFIELD_ID1_;
+  header_block.subfield_id_2 = BGZReader::SUBFIELD_ID2_;
+  header_block.subfield_length = BGZReader::SUBFIELD_LENGTH_;
+  header_block.block_size = static_cast<uint16_t>(block_size - 1);
+
+  GZTrailerBlock trailer_block{};
+  trailer_block.crc_check = ::crc32(0, reinterpret_cast<const Bytef*>(block_data.data()), static_cast<uInt>(block_data.size()));
+  trailer_block.uncompressed_size = static_cast<uint32_t>(block_data.size());
+
+  std::memcpy(gzip_block.data(), &header_block, GZIP_HEADER_SIZE_);
+  std::memcpy(gzip_block.data() + GZIP_HEADER_SIZE_ + compressed_size, &trailer_block, BGZReader::TRAILER_SIZE_);
+  gzip_block.resize(block_size);
+
+  return gzip_block;
+
+}
+
+
+bool kel::BGZWriter::deflateBlock( const std::string& block_data,
+                                   int level,
+                                   std::vector<std::byte>& gzip_block,
+                                   size_t& compressed_size) {
+
+  z_stream_s zlib_params{};
+  zlib_params.zalloc = Z_NULL;
+  zlib_params.zfree = Z_NULL;
+  zlib_params.opaque = nullptr;
+
+  int return_code = ::deflateInit2(&zlib_params, level, Z_DEFLATED, DEFLATE_WINDOW_FLAG_, DEFLATE_MEMORY_LEVEL_, Z_DEFAULT_STRATEGY);
+  if (return_code != Z_OK) {
+
+    std::string zlib_msg = zlib_params.msg != nullptr ? zlib_params.msg : "no msg";
+    ExecEnv::log().error("BGZWriter::deflateBlock; ::deflateInit2() fail, return code: {}, msg: {}", return_code, zlib_msg);
+    return false;
+
+  }
+
+  const size_t max_compressed_size = MAX_BLOCK_SIZE_ - GZIP_HEADER_SIZE_ - BGZReader::TRAILER_SIZE_;
+  zlib_params.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(block_data.data()));
+  zlib_params.avail_in = static_cast<uInt>(block_data.size());
+  zlib_params.next_out = reinterpret_cast<Bytef*>(gzip_block.data() + GZIP_HEADER_SIZE_);
+  zlib_params.avail_out = static_cast<uInt>(max_compressed_size);
+
+  // Z_BUF_ERROR or Z_OK if the deflated block does not fit.
+  return_code = ::deflate(&zlib_params, Z_FINISH);
+  compressed_size = max_compressed_size - zlib_params.avail_out;
+  ::deflateEnd(&zlib_params);
+
+  return return_code == Z_STREAM_END;
+
+}
@@ -10,7 +10,10 @@
 
 
 #include <string>
+#include <string_view>
 #include <memory>
+#include <deque>
+#include <cstddef>
 
 
 namespace kellerberrin {   //  organization::project level namespace
@@ -173,6 +176,69 @@ private:
   // Assemble records last + first and queue as complete records.
   void assembleRecords();
 
+  // The writer uses the block format constants.
+  friend class BGZWriter;
+
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The Block gzip (.bgz) compression object, the inverse of BGZReader.
+// Text is buffered into blocks of at most MAX_BLOCK_DATA_ bytes, each block is deflated by a thread pool
+// and the compressed blocks are written to the file in order, followed by the bgz EOF marker on close().
+// The number of blocks waiting to be written is bounded so memory use does not grow with the file size.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class BGZWriter {
+
+public:
+
+  explicit BGZWriter(size_t thread_count = BGZReader::DEFAULT_THREADS) : compress_threads_(thread_count),
+                                                                         max_pending_blocks_(thread_count * PENDING_PER_THREAD_) {}
+  ~BGZWriter() { close(); }
+
+  bool open(const std::string &file_name);
+
+  // Append text to the file, complete blocks are queued for compression.
+  bool write(std::string_view text);
+  bool writeLine(std::string_view line) { return write(line) and write(EOL_TEXT_); }
+
+  // Compress and write any buffered text and the EOF marker.
+  bool close();
+
+  [[nodiscard]] bool good() const { return not compression_error_; }
+
+private:
+
+  std::string file_name_;
+  std::ofstream bgz_file_;
+  ThreadPool compress_threads_;
+  size_t max_pending_blocks_;
+  std::string block_buffer_;
+  std::deque<std::future<std::vector<std::byte>>> pending_blocks_;
+  // Flag set if problems compressing or writing a gzip block.
+  bool compression_error_{false};
+
+  // Less than the maximum so that an incompressible block can be stored (level 0) within the block size limit.
+  constexpr static const size_t MAX_BLOCK_DATA_{0xff00};
+  constexpr static const size_t MAX_BLOCK_SIZE_{65536};
+  constexpr static const size_t PENDING_PER_THREAD_{4};
+  constexpr static const int DEFLATE_WINDOW_FLAG_{-15};  // Raw deflate, the gzip header and trailer are written explicitly.
+  constexpr static const int DEFLATE_MEMORY_LEVEL_{8};
+  constexpr static const uint8_t OPERATING_SYSTEM_{0xff};  // Unknown, as the EOF marker.
+  // sizeof(GZHeaderblock) includes 2 bytes of tail padding (the struct is 4 byte aligned), the header is 18 bytes.
+  constexpr static const size_t GZIP_HEADER_SIZE_{offsetof(GZHeaderblock, block_size) + sizeof(uint16_t)};
+  constexpr static const char* EOL_TEXT_{"\n"};
+
+  void queueBlock();
+  // Write completed blocks until no more than max_pending blocks are queued.
+  void writeBlocks(size_t max_pending);
+  // Thread pool worker function, returns the complete gzip block or an empty vector on error.
+  [[nodiscard]] static std::vector<std::byte> compressBlock(std::string block_data);
+  // Raw deflate into the gzip block after the header, false if the deflated data does not fit the block.
+  [[nodiscard]] static bool deflateBlock(const std::string& block_data, int level, std::vector<std::byte>& gzip_block, size_t& compressed_size);
 
 };
 
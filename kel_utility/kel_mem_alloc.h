@@ -62,6 +62,52 @@ private:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Counts the allocations and de-allocations of a subsystem (object type, data structure etc).
+// Objects report their own sizes, so the byte counts are estimates of the memory actually held.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class AllocationCounter {
+
+public:
+
+  AllocationCounter() = default;
+  ~AllocationCounter() = default;
+
+  void allocate(size_t bytes) {
+
+    allocated_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+
+  }
+
+  void deallocate(size_t bytes) {
+
+    deallocated_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    deallocations_.fetch_add(1, std::memory_order_relaxed);
+
+  }
+
+  [[nodiscard]] size_t allocatedBytes() const { return allocated_bytes_.load(std::memory_order_relaxed); }
+  [[nodiscard]] size_t deallocatedBytes() const { return deallocated_bytes_.load(std::memory_order_relaxed); }
+  [[nodiscard]] size_t allocations() const { return allocations_.load(std::memory_order_relaxed); }
+  [[nodiscard]] size_t deallocations() const { return deallocations_.load(std::memory_order_relaxed); }
+  // Currently held.
+  [[nodiscard]] size_t liveBytes() const { return allocatedBytes() - deallocatedBytes(); }
+  [[nodiscard]] size_t liveAllocations() const { return allocations() - deallocations(); }
+
+private:
+
+  std::atomic<size_t> allocated_bytes_{0};
+  std::atomic<size_t> deallocated_bytes_{0};
+  std::atomic<size_t> allocations_{0};
+  std::atomic<size_t> deallocations_{0};
+
+};
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // A polymorphic allocator for use with std::allocate_shared
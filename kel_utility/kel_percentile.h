@@ -10,6 +10,8 @@
 #include <map>
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <optional>
 
 namespace kellerberrin {   //  organization level namespace
 
@@ -222,6 +224,315 @@ void Percentile<Sortable, Payload>::conditionalSort() const {
 }
 
 
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// A mergeable streaming quantile sketch (KLL) with bounded memory for when the payload is not required.
+// Values are held exactly until the sketch exceeds the exact threshold, after which levels of the sketch are compacted;
+// a value at level h represents 2^h observations. The compaction offset alternates deterministically per level,
+// so the sketch is reproducible for a given sequence of additions and merges.
+// Thread local sketches can be accumulated independently and merged.
+// In exact mode percentile() returns the same value as Percentile::percentile().
+//
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Sortable>
+class QuantileSketch {
+
+public:
+
+  explicit QuantileSketch(size_t accuracy = DEFAULT_ACCURACY_, size_t exact_threshold = DEFAULT_EXACT_THRESHOLD_)
+  : accuracy_(std::max(accuracy, MIN_LEVEL_CAPACITY_)), exact_threshold_(exact_threshold), levels_(1) {}
+  ~QuantileSketch() = default;
+
+  void addElement(Sortable value) { levels_.front().push_back(std::move(value)); ++count_; need_sort_ = true; conditionalCompress(); }
+
+  // Merge another sketch into this sketch, the other sketch is unchanged.
+  void merge(const QuantileSketch& other);
+
+  // The number of observations added to the sketch (including merged sketches).
+  [[nodiscard]] size_t count() const { return count_; }
+  // True if no compaction has occurred and all values are held exactly.
+  [[nodiscard]] bool isExact() const { return exact_; }
+  // Number of values actually retained.
+  [[nodiscard]] size_t retained() const;
+
+  // Get the (approximate) value that corresponds to the percentile. std::nullopt if an empty sketch.
+  [[nodiscard]] std::optional<Sortable> percentile(double percentile_value) const;
+
+  // Given a value, the (approximate) number of observations >= to the value.
+  [[nodiscard]] size_t findGEQCount(const Sortable& find_value) const;
+
+private:
+
+  constexpr static const size_t DEFAULT_ACCURACY_{200};
+  constexpr static const size_t DEFAULT_EXACT_THRESHOLD_{1024};
+  constexpr static const size_t MIN_LEVEL_CAPACITY_{2};
+  constexpr static const double LEVEL_DECAY_{2.0 / 3.0};
+
+  size_t accuracy_;
+  size_t exact_threshold_;
+  size_t count_{0};
+  bool exact_{true};
+  std::vector<std::vector<Sortable>> levels_;
+  std::vector<bool> compact_offset_;
+
+  // A const access may require the weighted values to be re-sorted (if the sketch has been updated).
+  mutable std::vector<std::pair<Sortable, size_t>> sorted_values_;  // .second is the cumulative weight.
+  mutable bool need_sort_{true};
+
+  [[nodiscard]] size_t levelCapacity(size_t level) const;
+  [[nodiscard]] size_t sketchCapacity() const;
+  void conditionalCompress();
+  void compactLevel(size_t level);
+  void conditionalSort() const;
+
+};
+
+
+template <typename Sortable>
+void QuantileSketch<Sortable>::merge(const QuantileSketch& other) {
+
+  if (levels_.size() < other.levels_.size()) {
+
+    levels_.resize(other.levels_.size());
+
+  }
+
+  for (size_t level = 0; level < other.levels_.size(); ++level) {
+
+    levels_[level].insert(levels_[level].end(), other.levels_[level].begin(), other.levels_[level].end());
+
+  }
+
+  count_ += other.count_;
+  exact_ = exact_ and other.exact_;
+  need_sort_ = true;
+
+  conditionalCompress();
+
+}
+
+
+template <typename Sortable>
+size_t QuantileSketch<Sortable>::retained() const {
+
+  size_t retained_count{0};
+  for (auto const& level : levels_) {
+
+    retained_count += level.size();
+
+  }
+
+  return retained_count;
+
+}
+
+
+// The top level has the accuracy capacity and lower levels decay geometrically.
+template <typename Sortable>
+size_t QuantileSketch<Sortable>::levelCapacity(size_t level) const {
+
+  const size_t depth = levels_.size() - level - 1;
+  const double capacity = static_cast<double>(accuracy_) * std::pow(LEVEL_DECAY_, static_cast<double>(depth));
+
+  return std::max(MIN_LEVEL_CAPACITY_, static_cast<size_t>(std::ceil(capacity)));
+
+}
+
+
+template <typename Sortable>
+size_t QuantileSketch<Sortable>::sketchCapacity() const {
+
+  size_t capacity{0};
+  for (size_t level = 0; level < levels_.size(); ++level) {
+
+    capacity += levelCapacity(level);
+
+  }
+
+  return std::max(capacity, exact_threshold_);
+
+}
+
+
+// Compact the lowest over capacity level until the sketch is within capacity.
+template <typename Sortable>
+void QuantileSketch<Sortable>::conditionalCompress() {
+
+  while (retained() > sketchCapacity()) {
+
+    for (size_t level = 0; level < levels_.size(); ++level) {
+
+      if (levels_[level].size() >= levelCapacity(level)) {
+
+        compactLevel(level);
+        break;
+
+      }
+
+    }
+
+  }
+
+}
+
+
+// Every second sorted value of the level is promoted (with double weight) to the next level.
+// An odd value remains at the current level.
+template <typename Sortable>
+void QuantileSketch<Sortable>::compactLevel(size_t level) {
+
+  if (level + 1 >= levels_.size()) {
+
+    levels_.emplace_back();
+
+  }
+
+  if (compact_offset_.size() < levels_.size()) {
+
+    compact_offset_.resize(levels_.size(), false);
+
+  }
+
+  std::vector<Sortable>& compact_level = levels_[level];
+  std::sort(compact_level.begin(), compact_level.end());
+
+  std::optional<Sortable> odd_value;
+  if (compact_level.size() % 2 != 0) {
+
+    odd_value = std::move(compact_level.back());
+    compact_level.pop_back();
+
+  }
+
+  const size_t offset = compact_offset_[level] ? 1 : 0;
+  compact_offset_[level] = not compact_offset_[level];
+
+  std::vector<Sortable>& next_level = levels_[level + 1];
+  for (size_t index = offset; index < compact_level.size(); index += 2) {
+
+    next_level.push_back(std::move(compact_level[index]));
+
+  }
+
+  compact_level.clear();
+  if (odd_value) {
+
+    compact_level.push_back(std::move(odd_value.value()));
+
+  }
+
+  exact_ = false;
+  need_sort_ = true;
+
+}
+
+
+// Sort the retained values and accumulate their weights.
+template <typename Sortable>
+void QuantileSketch<Sortable>::conditionalSort() const {
+
+  if (not need_sort_) {
+
+    return;
+
+  }
+
+  sorted_values_.clear();
+  for (size_t level = 0; level < levels_.size(); ++level) {
+
+    const size_t weight = size_t{1} << level;
+    for (auto const& value : levels_[level]) {
+
+      sorted_values_.emplace_back(value, weight);
+
+    }
+
+  }
+
+  std::sort(sorted_values_.begin(), sorted_values_.end(), [](const std::pair<Sortable, size_t>& a,
+                                                             const std::pair<Sortable, size_t>& b) -> bool { return a.first < b.first; });
+
+  size_t cumulative_weight{0};
+  for (auto& [value, weight] : sorted_values_) {
+
+    cumulative_weight += weight;
+    weight = cumulative_weight;
+
+  }
+
+  need_sort_ = false;
+
+}
+
+
+// The rank is calculated as Percentile::index() and the value with cumulative weight greater than the rank is returned.
+template <typename Sortable>
+std::optional<Sortable> QuantileSketch<Sortable>::percentile(double percentile_value) const {
+
+  if (count_ == 0) {
+
+    return std::nullopt;
+
+  }
+
+  if (percentile_value < 0 or percentile_value > 1) {
+
+    ExecEnv::log().error("QuantileSketch::percentile, specified percentile value: {} is out of range", percentile_value);
+    percentile_value = std::clamp(percentile_value, 0.0, 1.0);
+
+  }
+
+  conditionalSort();
+
+  const size_t total_weight = sorted_values_.back().second;
+  long rank = std::lround((static_cast<double>(total_weight) * percentile_value) - 0.5);
+  rank = std::clamp<long>(rank, 0, static_cast<long>(total_weight) - 1);
+
+  auto result = std::upper_bound( sorted_values_.begin(),
+                                  sorted_values_.end(),
+                                  static_cast<size_t>(rank),
+                                  [](size_t rank_weight, const std::pair<Sortable, size_t>& value) -> bool { return rank_weight < value.second; });
+
+  if (result == sorted_values_.end()) {
+
+    return sorted_values_.back().first;
+
+  }
+
+  return result->first;
+
+}
+
+
+template <typename Sortable>
+size_t QuantileSketch<Sortable>::findGEQCount(const Sortable& find_value) const {
+
+  if (count_ == 0) {
+
+    return 0;
+
+  }
+
+  conditionalSort();
+
+  auto result = std::lower_bound( sorted_values_.begin(),
+                                  sorted_values_.end(),
+                                  find_value,
+                                  [](const std::pair<Sortable, size_t>& value, const Sortable& find) -> bool { return value.first < find; });
+
+  if (result == sorted_values_.begin()) {
+
+    return sorted_values_.back().second;
+
+  }
+
+  return sorted_values_.back().second - std::prev(result)->second;
+
+}
+
+
 } // namespace
 
 
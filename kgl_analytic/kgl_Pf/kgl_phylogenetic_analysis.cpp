@@ -403,12 +403,11 @@ bool kgl::GenomicMutation::outputDNASequenceCSV(const std::string &file_name,
         out_file << CSV_delimiter;
 
 
+        // The variant maps of all genomes are applied to a single reference coding sequence.
+        std::vector<OffsetVariantMap> variant_map_vector;
         for(const auto& [genome, genome_ptr] : pop_variant_ptr->getMap()) {
 
-          DNA5SequenceCoding reference_sequence;
-          DNA5SequenceCoding mutant_sequence;
           OffsetVariantMap variant_map;
-
           if (not genome_ptr->getSortedVariants( contig,
                                                  VariantPhase::HAPLOID_PHASED,
                                                  sequence_ptr->start(),
@@ -421,64 +420,69 @@ bool kgl::GenomicMutation::outputDNASequenceCSV(const std::string &file_name,
 
           }
 
+          variant_map_vector.push_back(std::move(variant_map));
 
-          if (GenomeMutation::mutantCodingDNA( contig,
-                                               gene_ptr->id(),
-                                               sequence,
-                                               genome_db,
-                                               variant_map,
-                                               reference_sequence,
-                                               mutant_sequence)) {
+        }
 
+        std::shared_ptr<const CodingReference> coding_reference_ptr;
+        std::vector<DNA5SequenceCoding> mutant_sequence_vector;
+        if (not GenomeMutation::mutantCodingBatch( contig_ptr,
+                                                   sequence_ptr,
+                                                   variant_map_vector,
+                                                   coding_reference_ptr,
+                                                   mutant_sequence_vector)) {
 
-            switch(analysis_type) {
+          ExecEnv::log().error("outputDNASequenceCSV(), Error Processing sequence: {}", sequence);
+          return false;
 
-              case SequenceAnalysisType::DNA: {
+        }
 
-                CompareDistance_t DNA_distance;
-                DNA_distance = dna_distance_metric->coding_distance(reference_sequence, mutant_sequence);
-                out_file << DNA_distance << CSV_delimiter;
+        const DNA5SequenceCoding& reference_sequence = coding_reference_ptr->referenceSequence();
+        for (size_t index = 0; index < variant_map_vector.size(); ++index) {
 
-              }
-                break;
+          const OffsetVariantMap& variant_map = variant_map_vector[index];
+          const DNA5SequenceCoding& mutant_sequence = mutant_sequence_vector[index];
 
-              case SequenceAnalysisType::SIZE:
-                out_file << mutant_sequence.length() << CSV_delimiter;
-                break;
+          switch(analysis_type) {
 
-              case SequenceAnalysisType::VARIANT:
-                out_file << variant_map.size() << CSV_delimiter;
-                break;
+            case SequenceAnalysisType::DNA: {
 
-              case SequenceAnalysisType::SNP: {
+              CompareDistance_t DNA_distance;
+              DNA_distance = dna_distance_metric->coding_distance(reference_sequence, mutant_sequence);
+              out_file << DNA_distance << CSV_delimiter;
 
-                size_t snp_count = 0;
-                for (auto variant : variant_map) {
+            }
+              break;
 
-                  if (variant.second->isSNP()) ++snp_count;
+            case SequenceAnalysisType::SIZE:
+              out_file << mutant_sequence.length() << CSV_delimiter;
+              break;
 
-                }
+            case SequenceAnalysisType::VARIANT:
+              out_file << variant_map.size() << CSV_delimiter;
+              break;
 
-                out_file << variant_map.size() << CSV_delimiter;
+            case SequenceAnalysisType::SNP: {
 
-              }
-                break;
+              size_t snp_count = 0;
+              for (auto variant : variant_map) {
 
-              case SequenceAnalysisType::ENTROPY:
-                out_file << SequenceComplexity::alphabetEntropy<CodingDNA5>(mutant_sequence, mutant_sequence.countSymbols()) << CSV_delimiter;
-                break;
+                if (variant.second->isSNP()) ++snp_count;
 
-              case SequenceAnalysisType::LEMPEL_ZIV:
-                out_file << SequenceComplexity::complexityLempelZiv(mutant_sequence) << CSV_delimiter;
-                break;
+              }
 
-            }
+              out_file << variant_map.size() << CSV_delimiter;
 
+            }
+              break;
 
-          } else {
+            case SequenceAnalysisType::ENTROPY:
+              out_file << SequenceComplexity::alphabetEntropy<CodingDNA5>(mutant_sequence, mutant_sequence.countSymbols()) << CSV_delimiter;
+              break;
 
-            ExecEnv::log().error("outputDNASequenceCSV(), Error Processing sequence: {}", sequence);
-            return false;
+            case SequenceAnalysisType::LEMPEL_ZIV:
+              out_file << SequenceComplexity::complexityLempelZiv(mutant_sequence) << CSV_delimiter;
+              break;
 
           }
 
@@ -835,24 +839,21 @@ bool kgl::GenomicMutation::outputDNAMutationCSV(const std::string &file_name,
 
   };
 
-  std::vector<GenomeMap> genome_vector;
-  for( auto [genome, genome_ptr] : pop_variant_ptr->getMap()) {
-
-    ExecEnv::log().info("outputMutationCSV(), Processing genome: {}", genome);
-    size_t sequence_count = 0;
-
-    sequence_count++;
-    OffsetVariantMap variant_map;
+  // Get the coding sequence.
+  std::shared_ptr<const CodingSequence> coding_sequence_ptr;
+  if (not contig_opt.value()->getCodingSequence(gene_id, sequence_id, coding_sequence_ptr)) {
 
-    // Get the coding sequence.
-    std::shared_ptr<const CodingSequence> coding_sequence_ptr;
-    if (not contig_opt.value()->getCodingSequence(gene_id, sequence_id, coding_sequence_ptr)) {
+    ExecEnv::log().warn("GenomicMutation::outputAminoMutationCSV,  Could not find a coding sequence for gene: {}, sequence: {}", gene_id, sequence_id);
+    return false;
 
-      ExecEnv::log().warn("GenomicMutation::outputAminoMutationCSV,  Could not find a coding sequence for gene: {}, sequence: {}", gene_id, sequence_id);
-      return false;
+  }
 
-    }
+  // The variant maps of all genomes are applied to a single reference coding sequence.
+  std::vector<GenomeId_t> genome_id_vector;
+  std::vector<OffsetVariantMap> variant_map_vector;
+  for( auto [genome, genome_ptr] : pop_variant_ptr->getMap()) {
 
+    OffsetVariantMap variant_map;
     if (not genome_ptr->getSortedVariants( contig_id,
                                            VariantPhase::HAPLOID_PHASED,
                                            coding_sequence_ptr->start(),
@@ -864,15 +865,33 @@ bool kgl::GenomicMutation::outputDNAMutationCSV(const std::string &file_name,
 
     }
 
-    DNA5SequenceCoding reference_sequence;
-    DNA5SequenceCoding mutant_sequence;
-    if (GenomeMutation::mutantCodingDNA( contig_id,
-                                         gene_id,
-                                         sequence_id,
-                                         genome_db,
-                                         variant_map,
-                                         reference_sequence,
-                                         mutant_sequence)) {
+    genome_id_vector.push_back(genome);
+    variant_map_vector.push_back(std::move(variant_map));
+
+  }
+
+  std::shared_ptr<const CodingReference> coding_reference_ptr;
+  std::vector<DNA5SequenceCoding> mutant_sequence_vector;
+  bool mutation_result = GenomeMutation::mutantCodingBatch( contig_opt.value(),
+                                                            coding_sequence_ptr,
+                                                            variant_map_vector,
+                                                            coding_reference_ptr,
+                                                            mutant_sequence_vector);
+
+  std::vector<GenomeMap> genome_vector;
+  for (size_t index = 0; index < genome_id_vector.size(); ++index) {
+
+    const GenomeId_t& genome = genome_id_vector[index];
+    ExecEnv::log().info("outputMutationCSV(), Processing genome: {}", genome);
+    size_t sequence_count = 0;
+
+    sequence_count++;
+    const OffsetVariantMap& variant_map = variant_map_vector[index];
+
+    if (mutation_result) {
+
+      const DNA5SequenceCoding& reference_sequence = coding_reference_ptr->referenceSequence();
+      const DNA5SequenceCoding& mutant_sequence = mutant_sequence_vector[index];
 
       for (auto variant : variant_map) {
 
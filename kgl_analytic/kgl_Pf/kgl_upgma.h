@@ -11,11 +11,15 @@
 
 #include "kgl_upgma_node.h"
 #include "kgl_sequence_offset.h"
+#include "kgl_statistics_nj.h"
+#include "kgl_genome_search.h"
 
 
 namespace kellerberrin::genome {   //  organization::project level namespace
 
 
+// The distance_tree argument selects the tree algorithm, UPGMAMatrix or ChainUPGMATree (kgl_statistics_upgma.h),
+// or NeighbourJoiningTree (kgl_statistics_nj.h) which does not assume a molecular clock.
 
 // Variadic function to combine the UPGMAMatrix and UPGMADistanceNode to produce a population tree.
 // We are comparing contigs across genomes. The distance metric will be based on the difference in
@@ -201,6 +205,11 @@ void VarGeneFamilyTree( DistanceTree& distance_tree,
   DNA5SequenceLinear i_5_promoter_rev = DNA5SequenceLinear::downConvertToLinear(i_5_promoter.codingSequence(StrandSense::REVERSE));
 //  i_5_promoter_ptr = i_5_promoter_ptr_rev;
 
+  // All three promoters are found in a single pass over each intron.
+  const std::vector<std::string> promoter_motifs{ i_promoter.getSequenceAsString(),
+                                                  i_complement_promoter.getSequenceAsString(),
+                                                  i_5_promoter.getSequenceAsString() };
+
   intron << "Gene" << delimiter
          << "description" << delimiter
          << "Symbolic" << delimiter
@@ -293,26 +302,12 @@ void VarGeneFamilyTree( DistanceTree& distance_tree,
 
 
                   std::stringstream pss;
-                  std::vector<ContigOffset_t> offset_vec = intron_seq_ptr.findAll(i_promoter);
-                  for (auto offset : offset_vec) {
-
-                    pss << offset << ":";
-
-                  }
-
                   std::stringstream css;
-                  offset_vec = intron_seq_ptr.findAll(i_complement_promoter);
-                  for (auto offset : offset_vec) {
-
-                    css << offset << ":";
-
-                  }
-
                   std::stringstream fss;
-                  offset_vec = intron_seq_ptr.findAll(i_5_promoter);
-                  for (auto offset : offset_vec) {
+                  std::array<std::stringstream*, 3> promoter_streams{&pss, &css, &fss};
+                  for (auto const& match : GenomeMotifSearch::exactSearch(intron_seq_ptr, promoter_motifs)) {
 
-                    fss << offset << ":";
+                    *promoter_streams[match.motif_index] << match.offset << ":";
 
                   }
 
@@ -103,6 +103,9 @@ public:
   void writeNode(std::ostream& outfile) const override;
   // Pure Virtual calculates the distance between nodes.
   DistanceType_t distance(std::shared_ptr<const VirtualDistanceNode> distance_node) const override;
+  // Batch distance calculation.
+  [[nodiscard]] std::optional<std::string> batchSequence() const override { return mutated_protein_.getSequenceAsString(); }
+  [[nodiscard]] const SequenceDistance* batchMetric() const override { return sequence_distance_.get(); }
 
   static bool geneFamily(std::shared_ptr<const GeneFeature> gene_ptr,
                          std::shared_ptr<const GenomeReference> genome_db_ptr,
@@ -231,6 +234,9 @@ public:
 
   // Pure Virtual calculates the distance between nodes.
   DistanceType_t distance(std::shared_ptr<const VirtualDistanceNode> distance_node) const override;
+  // Batch distance calculation.
+  [[nodiscard]] std::optional<std::string> batchSequence() const override { return linear_sequence_.getSequenceAsString(); }
+  [[nodiscard]] const SequenceDistance* batchMetric() const override { return sequence_distance_.get(); }
 
 
 private:
@@ -271,6 +277,9 @@ public:
 
   // Pure Virtual calculates the distance between nodes.
   DistanceType_t distance(std::shared_ptr<const VirtualDistanceNode> distance_node) const override;
+  // Batch distance calculation.
+  [[nodiscard]] std::optional<std::string> batchSequence() const override { return amino_sequence_.getSequenceAsString(); }
+  [[nodiscard]] const SequenceDistance* batchMetric() const override { return sequence_distance_.get(); }
 
 private:
 
@@ -41,6 +41,7 @@ bool kgl::InbreedAnalysis::initializeAnalysis(const std::string& work_directory,
 
   }
 
+  resource_ptr_ = resource_ptr;
   work_directory_ = work_directory;
   for (auto const& parameter : InbreedArguments::extractParameters(named_parameters)) {
 
@@ -116,7 +117,11 @@ bool kgl::InbreedAnalysis::iterationAnalysis() {
 
     // Set the allele frequency source for this population.
     param_output.getParameters().lociiArguments().frequencySource(unphased_population_->dataSource());
-    ExecuteInbreedingAnalysis::executeAnalysis(diploid_population_, unphased_population_, genealogy_data_, param_output);
+    ExecuteInbreedingAnalysis::executeAnalysis( diploid_population_,
+                                                unphased_population_,
+                                                genealogy_data_,
+                                                param_output,
+                                                resource_ptr_->threadPool());
 
   }
 
@@ -55,6 +55,8 @@ private:
   std::shared_ptr<const PopulationDB> diploid_population_;
   std::shared_ptr<const PopulationDB> unphased_population_;
   std::shared_ptr<const HsGenomeGenealogyData> genealogy_data_;
+  // Holds the shared analysis thread pool.
+  std::shared_ptr<const AnalysisResources> resource_ptr_;
 
   // Write to output files.
   bool writeResults();
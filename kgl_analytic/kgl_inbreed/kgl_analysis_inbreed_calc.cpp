@@ -91,36 +91,15 @@ std::optional<kgl::InbreedingAlgorithm> kgl::InbreedingCalculation::namedAlgorit
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-double kgl::InbreedingCalculation::logLikelihood(std::vector<double>& x, std::vector<AlleleFreqInfo>& data) {
+double kgl::InbreedingCalculation::logLikelihood(std::vector<double>& x, std::vector<double>& grad, LocusFrequencyArrays& data) {
 
-  double log_prob_sum{0.0};
-  double f = x[0];
-  static const double small_prob{1e-10};
+  double derivative{0.0};
+  double log_prob_sum = data.logLikelihood(x[0], derivative);
 
-  for (auto const& allele_freq : data) {
+  // The gradient vector is empty if the optimization algorithm does not use derivatives.
+  if (not grad.empty()) {
 
-    switch(allele_freq.alleleType()) {
-
-      case AlleleClassType::MAJOR_HOMOZYGOUS:
-      case AlleleClassType::MINOR_HOMOZYGOUS: {
-        double freq_sqd = allele_freq.firstAllele().frequency() * allele_freq.firstAllele().frequency();
-        double prob = (f * allele_freq.firstAllele().frequency()) + ((1.0 - f) * freq_sqd);
-        prob = std::clamp<double>(prob, small_prob, 1.0);
-        log_prob_sum += std::log(prob);
-      }
-        break;
-
-      case AlleleClassType::MINOR_HETEROZYGOUS:
-      case AlleleClassType::MAJOR_HETEROZYGOUS: {
-
-        double prob = 2 * (1.0 - f) * allele_freq.firstAllele().frequency() * allele_freq.secondAllele().frequency();
-        prob = std::clamp<double>(prob, small_prob, 1.0);
-        log_prob_sum += std::log(prob);
-
-      }
-        break;
-
-    }
+    grad[0] = derivative;
 
   }
 
@@ -131,7 +110,7 @@ double kgl::InbreedingCalculation::logLikelihood(std::vector<double>& x, std::ve
 kel::Optimize kgl::InbreedingCalculation::createLogLikelihoodOptimizer() {
 
   const size_t parameter_dimension = 1;
-  Optimize optimizer(OptimizationAlgorithm::LN_NELDERMEAD, parameter_dimension, OptimizationType::MAXIMIZE);
+  Optimize optimizer(OptimizationAlgorithm::LD_MMA, parameter_dimension, OptimizationType::MAXIMIZE);
   std::vector<double> lower_bound{-1.0};
   std::vector<double> upper_bound{1.0};
   optimizer.boundingHypercube(upper_bound, lower_bound);
@@ -154,7 +133,7 @@ kgl::LocusResults
 kgl::InbreedingCalculation::processLogLikelihood(const GenomeId_t& genome_id,
                                                  const std::shared_ptr<const ContigDB>& contig_ptr,
                                                  const std::string& super_population_field,
-                                                 const std::shared_ptr<const ContigDB>& locus_list ) {
+                                                 const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies ) {
 
   // Only want SNP variants.
   auto snp_contig_ptr = contig_ptr->filterVariants(SNPFilter());
@@ -164,10 +143,8 @@ kgl::InbreedingCalculation::processLogLikelihood(const GenomeId_t& genome_id,
   // The real  distribution [upper, lower] used to as a start point for the loglike algorithm.
   UniformRealDistribution initialize_distribution(INIT_UPPER_, INIT_LOWER_);
   // Get the locus frequencies.
-  auto [frequency_vector, locus_results] = generateFrequencies(genome_id,
-                                                               contig_ptr,
-                                                               super_population_field,
-                                                               locus_list );
+  auto [frequency_vector, locus_results] = generateFrequencies(genome_id, contig_ptr, *locus_frequencies);
+  LocusFrequencyArrays frequency_arrays(frequency_vector);
 
   double updated_coefficient{0.0};
   Optimize likelihood_optimizer = createLogLikelihoodOptimizer();
@@ -181,9 +158,9 @@ kgl::InbreedingCalculation::processLogLikelihood(const GenomeId_t& genome_id,
     double initial_f = initialize_distribution.random(entropy_mt.generator());
     coefficient.push_back(initial_f);
 
-    auto [result_code, value, iterations] = likelihood_optimizer.optimize<std::vector<AlleleFreqInfo>>( coefficient,
-                                                                                                        frequency_vector,
-                                                                                                        &logLikelihood);
+    auto [result_code, value, iterations] = likelihood_optimizer.optimize<LocusFrequencyArrays>( coefficient,
+                                                                                                 frequency_arrays,
+                                                                                                 &logLikelihood);
 
     if (not Optimize::returnSuccess(result_code)) {
 
@@ -216,6 +193,246 @@ kgl::InbreedingCalculation::processLogLikelihood(const GenomeId_t& genome_id,
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The batched loglikelihood inbreeding algorithm.
+// The loglikelihood is concave in f away from clamped locii, so a maximum is a root of the derivative.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// The log likelihood is continuous and concave between the homozygous clamp bounds. At a clamp bound the derivative
+// jumps up, so an interval has an interior maximum only if the derivative is negative at its upper end.
+// The warm start is used for the interval above the last clamp bound, which holds the maximum for most genomes.
+std::optional<double> kgl::InbreedingCalculation::newtonLogLikelihood(const LocusFrequencyArrays& frequency_arrays, double initial_f) {
+
+  const double lower_f{-1.0};
+  const double upper_f{1.0 - NEWTON_MARGIN_};
+  const std::vector<double>& clamp_bounds = frequency_arrays.clampBounds();
+  // Intervals are offset from the clamp bounds by NEWTON_TOLERANCE_ so the bounding locus is unambiguously (un)clamped.
+  const double concave_f = clamp_bounds.empty() ? lower_f : std::min(clamp_bounds.back() + NEWTON_TOLERANCE_, upper_f);
+
+  auto concave_opt = bracketedNewton(frequency_arrays, concave_f, upper_f, initial_f);
+  if (not concave_opt) {
+
+    return std::nullopt;
+
+  }
+
+  double derivative{0.0};
+  double maximum_f = concave_opt.value();
+  double maximum_likelihood = clamp_bounds.empty() ? 0.0 : frequency_arrays.logLikelihood(maximum_f, derivative);
+
+  double interval_lower = lower_f;
+  for (auto clamp_bound : clamp_bounds) {
+
+    const double interval_upper = std::min(clamp_bound, upper_f) - NEWTON_TOLERANCE_;
+    if (interval_upper > interval_lower and frequency_arrays.derivatives(interval_upper).first < 0.0) {
+
+      auto interval_opt = bracketedNewton(frequency_arrays, interval_lower, interval_upper, 0.5 * (interval_lower + interval_upper));
+      if (interval_opt) {
+
+        double likelihood = frequency_arrays.logLikelihood(interval_opt.value(), derivative);
+        if (likelihood > maximum_likelihood) {
+
+          maximum_likelihood = likelihood;
+          maximum_f = interval_opt.value();
+
+        }
+
+      }
+
+    }
+
+    interval_lower = std::max(interval_lower, clamp_bound + NEWTON_TOLERANCE_);
+
+  }
+
+  return maximum_f;
+
+}
+
+
+// A Newton step is taken where the second derivative is negative and stays in the bracket, otherwise the bracket is bisected.
+std::optional<double> kgl::InbreedingCalculation::bracketedNewton( const LocusFrequencyArrays& frequency_arrays,
+                                                                   double lower_f,
+                                                                   double upper_f,
+                                                                   double initial_f) {
+
+  // The maximum is at a bound if the derivative does not change sign.
+  if (frequency_arrays.derivatives(lower_f).first <= 0.0) {
+
+    return lower_f;
+
+  }
+
+  if (frequency_arrays.derivatives(upper_f).first >= 0.0) {
+
+    return upper_f;
+
+  }
+
+  double f = std::clamp<double>(initial_f, lower_f, upper_f);
+  for (size_t iteration = 0; iteration < MAXIMUM_ITERATIONS_; ++iteration) {
+
+    auto [first_derivative, second_derivative] = frequency_arrays.derivatives(f);
+    if (first_derivative == 0.0) {
+
+      return f;
+
+    }
+
+    if (first_derivative > 0.0) {
+
+      lower_f = f;
+
+    } else {
+
+      upper_f = f;
+
+    }
+
+    double next_f = second_derivative < 0.0 ? f - (first_derivative / second_derivative) : 0.5 * (lower_f + upper_f);
+    if (not (next_f > lower_f and next_f < upper_f)) {
+
+      next_f = 0.5 * (lower_f + upper_f);
+
+    }
+
+    if (std::fabs(next_f - f) < NEWTON_TOLERANCE_ or (upper_f - lower_f) < NEWTON_TOLERANCE_) {
+
+      return next_f;
+
+    }
+
+    f = next_f;
+
+  }
+
+  return std::nullopt;
+
+}
+
+
+std::vector<kgl::LocusResults>
+kgl::InbreedingCalculation::processLogLikelihoodBatch(const GenomeContigVector& genome_contigs,
+                                                      const std::string& super_population_field,
+                                                      const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies ) {
+
+  std::vector<LocusResults> batch_results;
+  batch_results.reserve(genome_contigs.size());
+
+  double coefficient_sum{0.0};
+  size_t solved_count{0};
+  for (auto const& [genome_id, contig_ptr] : genome_contigs) {
+
+    auto [frequency_vector, locus_results] = generateFrequencies(genome_id, contig_ptr, *locus_frequencies);
+    LocusFrequencyArrays frequency_arrays(frequency_vector);
+
+    // Warm start from the mean of the genomes already solved.
+    double initial_f = solved_count > 0 ? coefficient_sum / static_cast<double>(solved_count) : 0.0;
+    auto coefficient_opt = newtonLogLikelihood(frequency_arrays, initial_f);
+    if (coefficient_opt) {
+
+      locus_results.inbred_allele_sum = coefficient_opt.value();
+      coefficient_sum += coefficient_opt.value();
+      ++solved_count;
+
+    } else {
+
+      ExecEnv::log().warn( "InbreedingCalculation::processLogLikelihoodBatch, Genome: {}, iterations: {} Loglikelihood Inbreeding algorithm did not converge",
+                           locus_results.genome, MAXIMUM_ITERATIONS_);
+      locus_results.inbred_allele_sum = 0.0;
+
+    }
+
+    ExecEnv::log().info("LogLikelihoodBatch: Genome: {}, Super: {}, Het: {}, Hom: {}, Allele Count: {}, IBD Inbreeding: {}",
+                        locus_results.genome, super_population_field, locus_results.major_hetero_count,
+                        locus_results.minor_homo_count, locus_results.total_allele_count, locus_results.inbred_allele_sum);
+
+    batch_results.push_back(locus_results);
+
+  }
+
+  return batch_results;
+
+}
+
+
+kgl::LocusResults
+kgl::InbreedingCalculation::processLogLikelihoodNewton(const GenomeId_t& genome_id,
+                                                       const std::shared_ptr<const ContigDB>& contig_ptr,
+                                                       const std::string& super_population_field,
+                                                       const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies ) {
+
+  GenomeContigVector genome_contigs{ { genome_id, contig_ptr } };
+
+  return processLogLikelihoodBatch(genome_contigs, super_population_field, locus_frequencies).front();
+
+}
+
+
+void kgl::InbreedingBatchQueue::addGenome( const GenomeId_t& genome_id,
+                                           const std::shared_ptr<const ContigDB>& contig_ptr,
+                                           const std::string& super_population_field,
+                                           const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies,
+                                           PendingResults& pending_results) {
+
+  auto& batch_ptr = batch_map_[locus_frequencies.get()];
+  if (not batch_ptr) {
+
+    batch_ptr = std::make_shared<GenomeBatch>();
+    batch_ptr->super_population_field = super_population_field;
+    batch_ptr->locus_frequencies = locus_frequencies;
+
+  }
+
+  batch_ptr->genome_contigs.emplace_back(genome_id, contig_ptr);
+  batch_ptr->promises.emplace_back();
+  pending_results.push_back(batch_ptr->promises.back().get_future());
+
+  if (batch_ptr->genome_contigs.size() >= BATCH_SIZE_) {
+
+    thread_pool_.enqueueWork(&InbreedingBatchQueue::processBatch, batch_ptr);
+    batch_ptr = nullptr;
+
+  }
+
+}
+
+
+void kgl::InbreedingBatchQueue::queueBatches() {
+
+  for (auto& [locus_frequencies, batch_ptr] : batch_map_) {
+
+    if (batch_ptr) {
+
+      thread_pool_.enqueueWork(&InbreedingBatchQueue::processBatch, batch_ptr);
+
+    }
+
+  }
+
+  batch_map_.clear();
+
+}
+
+
+void kgl::InbreedingBatchQueue::processBatch(const std::shared_ptr<GenomeBatch>& batch_ptr) {
+
+  std::vector<LocusResults> batch_results = InbreedingCalculation::processLogLikelihoodBatch( batch_ptr->genome_contigs,
+                                                                                             batch_ptr->super_population_field,
+                                                                                             batch_ptr->locus_frequencies);
+
+  for (size_t index = 0; index < batch_ptr->promises.size(); ++index) {
+
+    batch_ptr->promises[index].set_value(batch_results[index]);
+
+  }
+
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // This is the Hall maximum expectation algorithm
@@ -226,7 +443,7 @@ kgl::LocusResults
 kgl::InbreedingCalculation::processHallME( const GenomeId_t& genome_id,
                                            const std::shared_ptr<const ContigDB>& contig_ptr,
                                            const std::string& super_population_field,
-                                           const std::shared_ptr<const ContigDB>& locus_list ) {
+                                           const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies ) {
 
   // Only want SNP variants.
   auto snp_contig_ptr = contig_ptr->filterVariants(SNPFilter());
@@ -236,10 +453,9 @@ kgl::InbreedingCalculation::processHallME( const GenomeId_t& genome_id,
   // The real unit distribution [upper, 0] used to as a start point for the EM algorithm.
   UniformRealDistribution initialize_distribution(INIT_UPPER_, 0);
   // Get the locus frequencies.
-  auto [frequency_vector, locus_results] = generateFrequencies(genome_id,
-                                                               contig_ptr,
-                                                               super_population_field,
-                                                               locus_list );
+  auto [frequency_vector, locus_results] = generateFrequencies(genome_id, contig_ptr, *locus_frequencies);
+  LocusFrequencyArrays frequency_arrays(frequency_vector);
+  const std::vector<double>& homozygous_freqs = frequency_arrays.homozygousFrequencies();
 
   double updated_coefficient{0.0};
   double inbreed_coefficient;
@@ -257,32 +473,19 @@ kgl::InbreedingCalculation::processHallME( const GenomeId_t& genome_id,
       inbreed_coefficient = updated_coefficient;
       double expectation_sum = 0.0;
 
-      for (auto const& allele_freq : frequency_vector) {
-
-        switch(allele_freq.alleleType()) {
-
-          case AlleleClassType::MAJOR_HOMOZYGOUS:
-          case AlleleClassType::MINOR_HOMOZYGOUS: {
+      // Heterozygous locii do not contribute to the expectation.
+      for (auto freq : homozygous_freqs) {
 
-            double denominator = (inbreed_coefficient + ((1.0-inbreed_coefficient) * allele_freq.firstAllele().frequency()));
-            if (denominator != 0) {
+        double denominator = (inbreed_coefficient + ((1.0-inbreed_coefficient) * freq));
+        if (denominator != 0) {
 
-              expectation_sum += inbreed_coefficient / denominator;
-
-            }
-
-          }
-            break;
-
-          case AlleleClassType::MAJOR_HETEROZYGOUS:
-          case AlleleClassType::MINOR_HETEROZYGOUS:
-            break;
+          expectation_sum += inbreed_coefficient / denominator;
 
         }
 
       }
 
-      updated_coefficient = expectation_sum / static_cast<double>(frequency_vector.size());
+      updated_coefficient = expectation_sum / static_cast<double>(frequency_arrays.locusCount());
 
     } while(not converge_retry.checkRetry(updated_coefficient));
 
@@ -319,13 +522,10 @@ kgl::LocusResults
 kgl::InbreedingCalculation::processSimple(const GenomeId_t& genome_id,
                                           const std::shared_ptr<const ContigDB>& contig_ptr,
                                           const std::string& super_population_field,
-                                          const std::shared_ptr<const ContigDB>& locus_list) {
+                                          const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies) {
 
   // Get the locus frequencies.
-  auto [frequency_vector, locus_results] = generateFrequencies( genome_id,
-                                                                contig_ptr,
-                                                                super_population_field,
-                                                                locus_list);
+  auto [frequency_vector, locus_results] = generateFrequencies(genome_id, contig_ptr, *locus_frequencies);
   const bool calc_hetero{false}; // Which calculation to use.
   double heterozygous_inbreeding{0.0};
   double homozygous_inbreeding{0.0};
@@ -343,8 +543,8 @@ kgl::InbreedingCalculation::processSimple(const GenomeId_t& genome_id,
       // Homozygous inbreeding
     homozygous_inbreeding = (observed_homozygous - expected_homozygous) / (static_cast<double>(locus_results.total_allele_count) - expected_homozygous);
 
-    ExecEnv::log().info("Simple: Genome: {}, Exp Het: {}, Exp Hom: {}, Exp Het + Hom: {}, Obs Het: {}, Obs Hom: {}, Obs Het + Hom: {}, Het F: {}, Hom F: {}",
-                        locus_results.genome, expected_heterozygous, expected_homozygous, (expected_heterozygous + expected_homozygous),
+    ExecEnv::log().info("Simple: Genome: {}, Super: {}, Exp Het: {}, Exp Hom: {}, Exp Het + Hom: {}, Obs Het: {}, Obs Hom: {}, Obs Het + Hom: {}, Het F: {}, Hom F: {}",
+                        locus_results.genome, super_population_field, expected_heterozygous, expected_homozygous, (expected_heterozygous + expected_homozygous),
                         observed_heterozygous, observed_homozygous, locus_results.total_allele_count,
                         heterozygous_inbreeding, homozygous_inbreeding);
 
@@ -375,50 +575,34 @@ kgl::LocusResults
 kgl::InbreedingCalculation::processRitlandLocus(const GenomeId_t &genome_id,
                                            const std::shared_ptr<const ContigDB>& contig_ptr,
                                            const std::string& super_population_field,
-                                           const std::shared_ptr<const ContigDB>& locus_list ) {
+                                           const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies ) {
 
   // Ignore rare homozygous combinations, as these 'blow up' the ratio below.
   constexpr const static double minimum_frequency{0.001};
 
   size_t sum_allele{0};
   double locus_allele_sum{0.0};
-  auto [frequency_vector, locus_results] = generateFrequencies( genome_id,
-                                                                contig_ptr,
-                                                                super_population_field,
-                                                                locus_list);
-
-  for (auto const& allele_freq : frequency_vector) {
+  auto [frequency_vector, locus_results] = generateFrequencies(genome_id, contig_ptr, *locus_frequencies);
 
-    switch(allele_freq.alleleType()) {
+  LocusFrequencyArrays frequency_arrays(frequency_vector);
 
-      case AlleleClassType::MAJOR_HOMOZYGOUS:
-      case AlleleClassType::MINOR_HOMOZYGOUS: {
+  for (auto freq : frequency_arrays.homozygousFrequencies()) {
 
-        if (allele_freq.firstAllele().frequency() > minimum_frequency) {
-          // This ratio becomes unstable for low frequency homozygous alleles.
-          double ratio = (1.0 / allele_freq.firstAllele().frequency());
-          locus_allele_sum += ratio;
-          locus_allele_sum -= 1.0;
-          ++sum_allele;
-
-        }
-
-      }
-        break;
-
-      case AlleleClassType::MAJOR_HETEROZYGOUS:
-      case AlleleClassType::MINOR_HETEROZYGOUS: {
-
-        locus_allele_sum -= 1.0;
-        ++sum_allele;
-
-      }
-        break;
+    if (freq > minimum_frequency) {
+      // This ratio becomes unstable for low frequency homozygous alleles.
+      double ratio = (1.0 / freq);
+      locus_allele_sum += ratio;
+      locus_allele_sum -= 1.0;
+      ++sum_allele;
 
     }
 
   }
 
+  // Each heterozygous locus contributes -1.
+  locus_allele_sum -= static_cast<double>(frequency_arrays.heterozygousFrequencies().size());
+  sum_allele += frequency_arrays.heterozygousFrequencies().size();
+
 
   locus_results.inbred_allele_sum = (sum_allele > 0 ? locus_allele_sum / static_cast<double>(sum_allele) : 0.0);
 
@@ -11,6 +11,7 @@
 #include "kgl_analysis_inbreed_output.h"
 
 #include <list>
+#include <future>
 
 namespace kellerberrin::genome {   //  organization::project level namespace
 
@@ -32,7 +33,10 @@ namespace kellerberrin::genome {   //  organization::project level namespace
 using InbreedingAlgorithm = std::function<LocusResults(const GenomeId_t& genome_id,
                                                        const std::shared_ptr<const ContigDB>& contig_ptr,
                                                        const std::string& super_population_field,
-                                                       const std::shared_ptr<const ContigDB>& locus_list )>;
+                                                       const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies )>;
+
+// The genomes (contigs) of a batch that share a super population locus list.
+using GenomeContigVector = std::vector<std::pair<GenomeId_t, std::shared_ptr<const ContigDB>>>;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -81,29 +85,45 @@ public:
   [[nodiscard]] static LocusResults processRitlandLocus( const ContigId_t& genome_id,
                                                          const std::shared_ptr<const ContigDB>& contig_ptr,
                                                          const std::string& super_population_field,
-                                                         const std::shared_ptr<const ContigDB>& locus_list );
+                                                         const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies );
   
   [[nodiscard]] static LocusResults processSimple(const ContigId_t& contig_id,
                                                   const std::shared_ptr<const ContigDB>& contig_ptr,
                                                   const std::string& super_population_field,
-                                                  const std::shared_ptr<const ContigDB>& locus_list );
+                                                  const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies );
 
   [[nodiscard]] static LocusResults processHallME( const GenomeId_t& genome_id,
                                                   const std::shared_ptr<const ContigDB>& contig_ptr,
                                                   const std::string& super_population_field,
-                                                  const std::shared_ptr<const ContigDB>& locus_list );
+                                                  const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies );
 
   // The loglikelihood algorithm.
   [[nodiscard]] static LocusResults processLogLikelihood(const GenomeId_t& genome_id,
                                                          const std::shared_ptr<const ContigDB>& contig_ptr,
                                                          const std::string& super_population_field,
-                                                         const std::shared_ptr<const ContigDB>& locus_list );
+                                                         const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies );
+
+  // The loglikelihood maximized by a bracketed Newton iteration on the analytic derivative, a batch of one genome.
+  [[nodiscard]] static LocusResults processLogLikelihoodNewton(const GenomeId_t& genome_id,
+                                                               const std::shared_ptr<const ContigDB>& contig_ptr,
+                                                               const std::string& super_population_field,
+                                                               const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies );
+
+  // Batched Newton loglikelihood. The locus frequencies are shared by the batch and each genome is
+  // warm started from the mean coefficient of the genomes already solved.
+  [[nodiscard]] static std::vector<LocusResults> processLogLikelihoodBatch(const GenomeContigVector& genome_contigs,
+                                                                           const std::string& super_population_field,
+                                                                           const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies );
 
   // Algorithm key used in the the algorithm selection map.
   inline static const std::string RITLAND_LOCUS_F{"RitlandLocus"};
   inline static const std::string SIMPLE_F{"Simple"};
   inline static const std::string HALL_ME_IBD{"HallME"};
   inline static const std::string LOGLIKELIHOOD_F{"Loglikelihood"};
+  inline static const std::string LOGLIKELIHOOD_BATCH_F{"LoglikelihoodBatch"};
+
+  // True if the named algorithm should be queued as genome batches (InbreedingBatchQueue).
+  [[nodiscard]] static bool batchAlgorithm(const std::string& algorithm_name) { return algorithm_name == LOGLIKELIHOOD_BATCH_F; }
 
   static const std::map<std::string, InbreedingAlgorithm>& algoMap() { return inbreeding_algo_map_; }
   static std::optional<InbreedingAlgorithm> namedAlgorithm(const std::string& algorithm_name);
@@ -114,7 +134,8 @@ private:
       {RITLAND_LOCUS_F, processRitlandLocus},
       {SIMPLE_F,        processSimple},
       {HALL_ME_IBD,     processHallME},
-      {LOGLIKELIHOOD_F, processLogLikelihood}
+      {LOGLIKELIHOOD_F, processLogLikelihood},
+      {LOGLIKELIHOOD_BATCH_F, processLogLikelihoodNewton}
   };
 
   // The initial guess for the Hall expectation maximization algorithm.
@@ -125,16 +146,73 @@ private:
   constexpr static const size_t MAXIMUM_ITERATIONS_ = 1000;
   constexpr static const size_t MAX_RETRIES_ = 50;
   constexpr static const size_t MIN_RETRIES_ = 5;
+  // The Newton iteration is bracketed on [-1, 1 - NEWTON_MARGIN_], heterozygous locii are all clamped at f = 1.
+  constexpr static const double NEWTON_MARGIN_ = 1E-06;
+  constexpr static const double NEWTON_TOLERANCE_ = 1E-08;
 
   [[nodiscard]] static Optimize createLogLikelihoodOptimizer();
 
   [[nodiscard]] static std::pair<std::vector<AlleleFreqInfo>, LocusResults>
   generateFrequencies(const GenomeId_t& genome_id,
                       const std::shared_ptr<const ContigDB>& contig_ptr,
-                      const std::string& super_population_field,
-                      const std::shared_ptr<const ContigDB>& locus_list);
+                      const LocusFrequencyVector& locus_frequencies);
+
+  // The maximum likelihood inbreeding coefficient, std::nullopt if the iteration does not converge.
+  [[nodiscard]] static std::optional<double> newtonLogLikelihood(const LocusFrequencyArrays& frequency_arrays, double initial_f);
+  // A local maximum in [lower_f, upper_f].
+  [[nodiscard]] static std::optional<double> bracketedNewton( const LocusFrequencyArrays& frequency_arrays,
+                                                              double lower_f,
+                                                              double upper_f,
+                                                              double initial_f);
+
+  // The log likelihood objective and derivative for the optimizer.
+  [[nodiscard]] static double logLikelihood(std::vector<double>& x, std::vector<double>& grad, LocusFrequencyArrays& data);
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Groups the genomes that share locus frequencies (contig and super population) into batches of up to
+// BATCH_SIZE_ genomes and queues each batch on the thread pool as a single task.
+// The result of each genome is returned as a future in the order the genomes were added.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+class InbreedingBatchQueue {
+
+public:
+
+  explicit InbreedingBatchQueue(ThreadPool& thread_pool) : thread_pool_(thread_pool) {}
+  ~InbreedingBatchQueue() = default;
+
+  void addGenome( const GenomeId_t& genome_id,
+                  const std::shared_ptr<const ContigDB>& contig_ptr,
+                  const std::string& super_population_field,
+                  const std::shared_ptr<const LocusFrequencyVector>& locus_frequencies,
+                  PendingResults& pending_results);
+
+  // Queue the remaining partial batches, must be called after the last genome is added.
+  void queueBatches();
+
+private:
+
+  struct GenomeBatch {
+
+    std::string super_population_field;
+    std::shared_ptr<const LocusFrequencyVector> locus_frequencies;
+    GenomeContigVector genome_contigs;
+    std::vector<std::promise<LocusResults>> promises;
+
+  };
+
+  ThreadPool& thread_pool_;
+  // Keyed by the shared locus frequencies.
+  std::map<const LocusFrequencyVector*, std::shared_ptr<GenomeBatch>> batch_map_;
+
+  constexpr static const size_t BATCH_SIZE_ = 64;
 
-  [[nodiscard]] static double logLikelihood(std::vector<double>& x, std::vector<AlleleFreqInfo>& data);
+  static void processBatch(const std::shared_ptr<GenomeBatch>& batch_ptr);
 
 };
 
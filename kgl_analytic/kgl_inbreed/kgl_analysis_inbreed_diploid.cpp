@@ -18,7 +18,8 @@ namespace kgl = kellerberrin::genome;
 bool kgl::InbreedingAnalysis::populationInbreeding(std::shared_ptr<const PopulationDB> unphased_ptr,
                                                    const PopulationDB& diploid_population,
                                                    const HsGenomeGenealogyData& ped_data,
-                                                   InbreedParamOutput& param_output) {
+                                                   InbreedParamOutput& param_output,
+                                                   ThreadPool& thread_pool) {
 
 
 
@@ -44,78 +45,74 @@ bool kgl::InbreedingAnalysis::populationInbreeding(std::shared_ptr<const Populat
   // Get the size of the contig.
   auto [contig_id, contig_ptr] = *contig_map->getMap().begin();
 
+  // Table the unphased locus frequencies once, all the sample regions index the table.
+  ContigLocusTableMap locus_tables = InbreedSampling::getPopulationLocusTables(unphased_ptr, thread_pool);
+  const ContigLocusTable& locus_table = *locus_tables.at(contig_id);
+
   InbreedingParameters local_params = param_output.getParameters();
-  std::vector<ContigOffset_t> locii_vector = RetrieveLociiVector::getLociiCount(contig_ptr,
+  std::vector<ContigOffset_t> locii_vector = RetrieveLociiVector::getLociiCount(locus_table,
                                                                                 FrequencyDatabaseRead::SUPER_POP_ALL_,
                                                                                 local_params.lociiArguments());
   local_params.lociiArguments().upperOffset(locii_vector.back());
 
+  std::vector<std::pair<std::string, PendingResults>> pending_columns;
   while ( local_params.lociiArguments().upperOffset() < param_output.getParameters().lociiArguments().upperOffset()
           and locii_vector.size() >= 100) {
 
-    ResultsMap results_map = populationInbreedingSample( unphased_ptr,
-                                                         diploid_population,
-                                                         ped_data,
-                                                         local_params);
-
     // Generate a string to identify these results.
     std::string result_ident = InbreedingResultColumn::generateIdent( contig_id,
                                                                       local_params.lociiArguments().lowerOffset(),
                                                                       local_params.lociiArguments().upperOffset());
 
-    // Store the inbreeding results.
-    param_output.addColumn(InbreedingResultColumn(result_ident, results_map));
+    // Queue the inbreeding calculations, the results are retrieved after all the sample regions have been queued.
+    ContigLocusMap contig_locus_map = InbreedSampling::getPopulationLocusMap(locus_tables, local_params.lociiArguments(), thread_pool);
+    pending_columns.emplace_back(result_ident, queueResults(contig_locus_map, diploid_population, ped_data, local_params, thread_pool));
 
     local_params.lociiArguments().lowerOffset(local_params.lociiArguments().upperOffset());
-    locii_vector = RetrieveLociiVector::getLociiCount(contig_ptr,
+    locii_vector = RetrieveLociiVector::getLociiCount(locus_table,
                                                       FrequencyDatabaseRead::SUPER_POP_ALL_,
                                                       local_params.lociiArguments());
     local_params.lociiArguments().upperOffset(locii_vector.back());
 
   }
 
-  return true;
-
-}
+  // Store the inbreeding results.
+  for (auto& [result_ident, pending_results] : pending_columns) {
 
+    param_output.addColumn(result_ident, pending_results);
 
+  }
 
-kgl::ResultsMap kgl::InbreedingAnalysis::populationInbreedingSample( std::shared_ptr<const PopulationDB> unphased_ptr,
-                                                                     const PopulationDB& diploid_population,
-                                                                     const HsGenomeGenealogyData& ped_data,
-                                                                     const InbreedingParameters& parameters) {
-
-  ContigLocusMap contig_locus_map = InbreedSampling::getPopulationLocusMap(unphased_ptr, parameters.lociiArguments());
-
-  ResultsMap results_map = processResults(contig_locus_map, diploid_population, ped_data, parameters);
-
-  return results_map;
+  return true;
 
 }
 
 
 
-kgl::ResultsMap kgl::InbreedingAnalysis::processResults( const ContigLocusMap& contig_locus_map,
-                                                         const PopulationDB& diploid_population,
-                                                         const HsGenomeGenealogyData& ped_data,
-                                                         const InbreedingParameters& parameters) {
+kgl::PendingResults kgl::InbreedingAnalysis::queueResults( const ContigLocusMap& contig_locus_map,
+                                                          const PopulationDB& diploid_population,
+                                                          const HsGenomeGenealogyData& ped_data,
+                                                          const InbreedingParameters& parameters,
+                                                          ThreadPool& thread_pool) {
 
-  ResultsMap results_map;
+  PendingResults future_vector;
   // Retrieve the algorithm function object.
   auto algorithm_opt = InbreedingCalculation::namedAlgorithm(parameters.inbreedingAlgorthim());
 
   if (not algorithm_opt) {
 
     ExecEnv::log().error("InbreedingAnalysis::populationInbreeding, Inbreeding algorithm not found: {}", parameters.inbreedingAlgorthim());
-    return results_map;
+    return future_vector;
 
   }
 
+  // Batched algorithms share the locus frequencies and are queued as genome batches.
+  const bool batch_algorithm = InbreedingCalculation::batchAlgorithm(parameters.inbreedingAlgorthim());
+  InbreedingBatchQueue batch_queue(thread_pool);
+
+  // Queue all contigs on the thread pool to calculate inbreeding and relatedness.
   for (auto const& [genome_contig_id, locus_map] : contig_locus_map) {
 
-    // Use a thread pool to calculate inbreeding and relatedness.
-    ThreadPool thread_pool(ThreadPool::defaultThreads());
-    std::vector<std::future<LocusResults>> future_vector;
     for (auto const&[genome_id, genome_ptr] : diploid_population.getMap()) {
 
       auto contig_opt = genome_ptr->getContig(genome_contig_id);
@@ -137,31 +134,32 @@ kgl::ResultsMap kgl::InbreedingAnalysis::processResults( const ContigLocusMap& c
           continue;
 
         }
-        auto const& [super_pop_id, locus_list] = *locus_result;
+        auto const& [super_pop_id, sampled_locii] = *locus_result;
 
-        std::future<LocusResults> future = thread_pool.enqueueTask(algorithm_opt.value(),
-                                                                   genome_id,
-                                                                   contig_opt.value(),
-                                                                   super_pop_id,
-                                                                   locus_list );
-        future_vector.push_back(std::move(future));
+        if (batch_algorithm) {
 
-      }
+          batch_queue.addGenome(genome_id, contig_opt.value(), super_pop_id, sampled_locii.locus_frequencies, future_vector);
 
-    }
+        } else {
 
-    // Retrieve the thread results into a map.
-    for (auto &future : future_vector) {
+          std::future<LocusResults> future = thread_pool.enqueueTask(algorithm_opt.value(),
+                                                                     genome_id,
+                                                                     contig_opt.value(),
+                                                                     super_pop_id,
+                                                                     sampled_locii.locus_frequencies );
+          future_vector.push_back(std::move(future));
 
-      auto locus_results = future.get();
-      ExecEnv::log().info("Processed Diploid genome: {} for inbreeding and relatedness", locus_results.genome);
-      results_map[locus_results.genome] = locus_results;
+        }
+
+      }
 
     }
 
   } // all contigs.
 
-  return results_map;
+  batch_queue.queueBatches();
+
+  return future_vector;
 
 }
 
@@ -33,20 +33,17 @@ public:
   static bool populationInbreeding(std::shared_ptr<const PopulationDB> unphased_ptr,
                                    const PopulationDB& diploid_population,
                                    const HsGenomeGenealogyData& ped_data,
-                                   InbreedParamOutput& param_output);
+                                   InbreedParamOutput& param_output,
+                                   ThreadPool& thread_pool);
 
 private:
 
-  [[nodiscard]] static ResultsMap populationInbreedingSample( std::shared_ptr<const PopulationDB> unphased_ptr,
-                                                              const PopulationDB& diploid_population,
-                                                              const HsGenomeGenealogyData& ped_data,
-                                                              const InbreedingParameters& parameters);
-
-  // Use a threadpool to calculate the inbreeding coefficients.
-  [[nodiscard]] static ResultsMap processResults( const ContigLocusMap& contig_locus_map,
-                                                  const PopulationDB& diploid_population,
-                                                  const HsGenomeGenealogyData& ped_data,
-                                                  const InbreedingParameters& parameters);
+  // Queue the inbreeding coefficient calculations on the analysis thread pool.
+  [[nodiscard]] static PendingResults queueResults( const ContigLocusMap& contig_locus_map,
+                                                    const PopulationDB& diploid_population,
+                                                    const HsGenomeGenealogyData& ped_data,
+                                                    const InbreedingParameters& parameters,
+                                                    ThreadPool& thread_pool);
 
 };
 
@@ -16,7 +16,8 @@ namespace kgl = kellerberrin::genome;
 bool kgl::ExecuteInbreedingAnalysis::executeAnalysis(std::shared_ptr<const PopulationDB> diploid_population,
                                                      std::shared_ptr<const PopulationDB> unphased_population,
                                                      std::shared_ptr<const HsGenomeGenealogyData> ped_data,
-                                                     InbreedParamOutput& parameters) {
+                                                     InbreedParamOutput& parameters,
+                                                     ThreadPool& thread_pool) {
 
 
   if (parameters.getParameters().analyzeSynthetic()) {
@@ -29,7 +30,7 @@ bool kgl::ExecuteInbreedingAnalysis::executeAnalysis(std::shared_ptr<const Popul
 
     }
 
-    return processSynthetic(unphased_population, parameters);
+    return processSynthetic(unphased_population, parameters, thread_pool);
 
   } else {
 
@@ -41,7 +42,7 @@ bool kgl::ExecuteInbreedingAnalysis::executeAnalysis(std::shared_ptr<const Popul
 
     }
 
-    return processDiploid(diploid_population, unphased_population, ped_data, parameters);
+    return processDiploid(diploid_population, unphased_population, ped_data, parameters, thread_pool);
 
   }
 
@@ -52,10 +53,11 @@ bool kgl::ExecuteInbreedingAnalysis::executeAnalysis(std::shared_ptr<const Popul
 bool kgl::ExecuteInbreedingAnalysis::processDiploid(std::shared_ptr<const PopulationDB> diploid_population,
                                                     std::shared_ptr<const PopulationDB> unphased_population,
                                                     std::shared_ptr<const HsGenomeGenealogyData> ped_data,
-                                                    InbreedParamOutput& parameters) {
+                                                    InbreedParamOutput& parameters,
+                                                    ThreadPool& thread_pool) {
 
 
-  InbreedingAnalysis::populationInbreeding( unphased_population, *diploid_population, *ped_data, parameters);
+  InbreedingAnalysis::populationInbreeding( unphased_population, *diploid_population, *ped_data, parameters, thread_pool);
 
   return true;
 
@@ -63,9 +65,10 @@ bool kgl::ExecuteInbreedingAnalysis::processDiploid(std::shared_ptr<const Popula
 
 // Perform an inbreeding analysis of a synthetic population.
 bool kgl::ExecuteInbreedingAnalysis::processSynthetic(std::shared_ptr<const PopulationDB> unphased_population,
-                                                      InbreedParamOutput& parameters) {
+                                                      InbreedParamOutput& parameters,
+                                                     ThreadPool& thread_pool) {
 
-  SyntheticAnalysis::syntheticInbreeding(unphased_population, parameters);
+  SyntheticAnalysis::syntheticInbreeding(unphased_population, parameters, thread_pool);
 
   return true;
 
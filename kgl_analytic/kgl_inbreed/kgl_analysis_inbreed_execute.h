@@ -33,16 +33,19 @@ public:
   static bool executeAnalysis(std::shared_ptr<const PopulationDB> diploid_population,
                               std::shared_ptr<const PopulationDB> unphased_population,
                               std::shared_ptr<const HsGenomeGenealogyData> ped_data,
-                              InbreedParamOutput& param_output);
+                              InbreedParamOutput& param_output,
+                              ThreadPool& thread_pool);
 
 private:
 
   static bool processDiploid(std::shared_ptr<const PopulationDB> diploid_population,
                              std::shared_ptr<const PopulationDB> unphased_population,
                              std::shared_ptr<const HsGenomeGenealogyData> ped_data,
-                             InbreedParamOutput& param_output);
+                             InbreedParamOutput& param_output,
+                             ThreadPool& thread_pool);
   static bool processSynthetic(std::shared_ptr<const PopulationDB> unphased_population,
-                               InbreedParamOutput& param_output);
+                               InbreedParamOutput& param_output,
+                               ThreadPool& thread_pool);
 
 };
 
@@ -9,6 +9,8 @@
 
 #include <fstream>
 #include <algorithm>
+#include <array>
+#include <cmath>
 
 namespace kgl = kellerberrin::genome;
 namespace kel = kellerberrin;
@@ -424,11 +426,250 @@ kgl::AlleleFreqVector::selectMinorHeterozygous(double unit_rand, const AlleleCla
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+kgl::LocusFrequencyArrays::LocusFrequencyArrays(const std::vector<AlleleFreqInfo>& frequency_vector) {
+
+  for (auto const& allele_freq : frequency_vector) {
+
+    switch(allele_freq.alleleType()) {
+
+      case AlleleClassType::MAJOR_HOMOZYGOUS:
+      case AlleleClassType::MINOR_HOMOZYGOUS: {
+
+        const double p = allele_freq.firstAllele().frequency();
+        homozygous_freq_.push_back(p);
+        // The locus probability p^2 + f.(p - p^2) is clamped below this coefficient.
+        const double slope = p - (p * p);
+        if (slope > 0.0) {
+
+          const double clamp_bound = (MIN_PROBABILITY_ - (p * p)) / slope;
+          if (clamp_bound > -1.0 and clamp_bound < 1.0) {
+
+            clamp_bounds_.push_back(clamp_bound);
+
+          }
+
+        }
+
+      }
+        break;
+
+      case AlleleClassType::MINOR_HETEROZYGOUS:
+      case AlleleClassType::MAJOR_HETEROZYGOUS: {
+
+        double expected_freq = 2.0 * allele_freq.firstAllele().frequency() * allele_freq.secondAllele().frequency();
+        heterozygous_freq_.push_back(expected_freq);
+        heterozygous_min_ = std::min(heterozygous_min_, expected_freq);
+        heterozygous_max_ = std::max(heterozygous_max_, expected_freq);
+        if (expected_freq > 0.0) {
+
+          heterozygous_log_sum_ += std::log(expected_freq);
+
+        }
+
+      }
+        break;
+
+    }
+
+  }
+
+  std::sort(clamp_bounds_.begin(), clamp_bounds_.end());
+
+}
+
+
+double kgl::LocusFrequencyArrays::logLikelihood(double f, double& derivative) const {
+
+  double homozygous_derivative{0.0};
+  double heterozygous_derivative{0.0};
+  double log_likelihood = homozygousLikelihood(f, homozygous_derivative) + heterozygousLikelihood(f, heterozygous_derivative);
+  derivative = homozygous_derivative + heterozygous_derivative;
+
+  return log_likelihood;
+
+}
+
+
+// The homozygous probability is f.p + (1 - f).p^2 = p^2 + f.(p - p^2).
+// The lane loops have no loop carried dependencies between lanes and are vectorized by the compiler.
+double kgl::LocusFrequencyArrays::homozygousLikelihood(double f, double& derivative) const {
+
+  const double* freq = homozygous_freq_.data();
+  const size_t locus_count = homozygous_freq_.size();
+  constexpr const size_t block_size = SIMD_LANES_ * PRODUCT_BLOCK_;
+
+  double log_sum{0.0};
+  std::array<double, SIMD_LANES_> lane_derivative{};
+  size_t index{0};
+  for (; index + block_size <= locus_count; index += block_size) {
+
+    std::array<double, SIMD_LANES_> lane_product;
+    lane_product.fill(1.0);
+    for (size_t block_index = index; block_index < index + block_size; block_index += SIMD_LANES_) {
+
+      for (size_t lane = 0; lane < SIMD_LANES_; ++lane) {
+
+        const double p = freq[block_index + lane];
+        const double p_sqd = p * p;
+        const double slope = p - p_sqd;
+        const double prob = p_sqd + (f * slope);
+        const double clamped_prob = std::clamp<double>(prob, MIN_PROBABILITY_, 1.0);
+        lane_product[lane] *= clamped_prob;
+        lane_derivative[lane] += (prob == clamped_prob) ? slope / clamped_prob : 0.0;
+
+      }
+
+    }
+
+    for (auto product : lane_product) {
+
+      log_sum += std::log(product);
+
+    }
+
+  }
+
+  derivative = 0.0;
+  for (auto lane_sum : lane_derivative) {
+
+    derivative += lane_sum;
+
+  }
+
+  // Remaining locii.
+  for (; index < locus_count; ++index) {
+
+    const double p = freq[index];
+    const double p_sqd = p * p;
+    const double slope = p - p_sqd;
+    const double prob = p_sqd + (f * slope);
+    const double clamped_prob = std::clamp<double>(prob, MIN_PROBABILITY_, 1.0);
+    log_sum += std::log(clamped_prob);
+    derivative += (prob == clamped_prob) ? slope / clamped_prob : 0.0;
+
+  }
+
+  return log_sum;
+
+}
+
+
+// Unclamped homozygous locii contribute slope / prob and -(slope / prob)^2, heterozygous locii -1/(1 - f) and -1/(1 - f)^2.
+std::pair<double, double> kgl::LocusFrequencyArrays::derivatives(double f) const {
+
+  const double* freq = homozygous_freq_.data();
+  const size_t locus_count = homozygous_freq_.size();
+
+  std::array<double, SIMD_LANES_> lane_first{};
+  std::array<double, SIMD_LANES_> lane_second{};
+  size_t index{0};
+  for (; index + SIMD_LANES_ <= locus_count; index += SIMD_LANES_) {
+
+    for (size_t lane = 0; lane < SIMD_LANES_; ++lane) {
+
+      const double p = freq[index + lane];
+      const double p_sqd = p * p;
+      const double slope = p - p_sqd;
+      const double prob = p_sqd + (f * slope);
+      const bool unclamped = prob >= MIN_PROBABILITY_ and prob <= 1.0;
+      const double ratio = unclamped ? slope / prob : 0.0;
+      lane_first[lane] += ratio;
+      lane_second[lane] -= ratio * ratio;
+
+    }
+
+  }
+
+  double first_derivative{0.0};
+  double second_derivative{0.0};
+  for (size_t lane = 0; lane < SIMD_LANES_; ++lane) {
+
+    first_derivative += lane_first[lane];
+    second_derivative += lane_second[lane];
+
+  }
+
+  // Remaining locii.
+  for (; index < locus_count; ++index) {
+
+    const double p = freq[index];
+    const double p_sqd = p * p;
+    const double slope = p - p_sqd;
+    const double prob = p_sqd + (f * slope);
+    const bool unclamped = prob >= MIN_PROBABILITY_ and prob <= 1.0;
+    const double ratio = unclamped ? slope / prob : 0.0;
+    first_derivative += ratio;
+    second_derivative -= ratio * ratio;
+
+  }
+
+  const double complement = 1.0 - f;
+  if (complement * heterozygous_min_ >= MIN_PROBABILITY_ and complement * heterozygous_max_ <= 1.0) {
+
+    const auto heterozygous_count = static_cast<double>(heterozygous_freq_.size());
+    first_derivative -= heterozygous_count / complement;
+    second_derivative -= heterozygous_count / (complement * complement);
+
+  } else {
+
+    for (auto expected_freq : heterozygous_freq_) {
+
+      const double prob = complement * expected_freq;
+      if (prob >= MIN_PROBABILITY_ and prob <= 1.0) {
+
+        first_derivative -= 1.0 / complement;
+        second_derivative -= 1.0 / (complement * complement);
+
+      }
+
+    }
+
+  }
+
+  return { first_derivative, second_derivative };
+
+}
+
+
+// The heterozygous probability is (1 - f).2pq.
+double kgl::LocusFrequencyArrays::heterozygousLikelihood(double f, double& derivative) const {
+
+  if (heterozygous_freq_.empty()) {
+
+    derivative = 0.0;
+    return 0.0;
+
+  }
+
+  const double complement = 1.0 - f;
+  const auto locus_count = static_cast<double>(heterozygous_freq_.size());
+  if (complement * heterozygous_min_ >= MIN_PROBABILITY_ and complement * heterozygous_max_ <= 1.0) {
+
+    derivative = -locus_count / complement;
+    return (locus_count * std::log(complement)) + heterozygous_log_sum_;
+
+  }
+
+  double log_sum{0.0};
+  derivative = 0.0;
+  for (auto expected_freq : heterozygous_freq_) {
+
+    const double prob = complement * expected_freq;
+    const double clamped_prob = std::clamp<double>(prob, MIN_PROBABILITY_, 1.0);
+    log_sum += std::log(clamped_prob);
+    derivative += (prob == clamped_prob) ? -expected_freq / clamped_prob : 0.0;
+
+  }
+
+  return log_sum;
+
+}
+
+
 std::pair<std::vector<kgl::AlleleFreqInfo>, kgl::LocusResults>
 kgl::InbreedingCalculation::generateFrequencies(const GenomeId_t& genome_id,
                                                 const std::shared_ptr<const ContigDB>& contig_ptr,
-                                                const std::string& super_population_field,
-                                                const std::shared_ptr<const ContigDB>& locus_list) {
+                                                const LocusFrequencyVector& locus_frequencies) {
 
   std::vector<AlleleFreqInfo> frequency_vector;
   LocusResults locus_results;
@@ -437,18 +678,10 @@ kgl::InbreedingCalculation::generateFrequencies(const GenomeId_t& genome_id,
   // Diploid contig, only want SNP variants.
   auto snp_contig_ptr = contig_ptr->filterVariants(SNPFilter());
 
-  // For all offsets.
-  for (auto const& [offset, offset_ptr] : locus_list->getMap()) {
-
-    // Get the allele frequencies.
-    const OffsetDBArray& locus_variant_array = offset_ptr->getVariantArray();
-
-    AlleleFreqVector allele_freq_vector(locus_variant_array, super_population_field);
-    if (not allele_freq_vector.checkValidAlleleVector()) {
+  // For all valid offsets.
+  for (auto const& [offset, allele_freq_vector, class_frequencies] : locus_frequencies) {
 
-      continue; // Next locus.
-
-    }
+    const size_t previous_count = frequency_vector.size();
 
     // Check the diploid genome for any minor alleles at this location.
     auto diploid_variant_opt = snp_contig_ptr->findOffsetArray(offset);
@@ -544,19 +777,22 @@ kgl::InbreedingCalculation::generateFrequencies(const GenomeId_t& genome_id,
 
     }
 
+    // Accumulate the tabled allele class frequencies of the sampled locus.
+    if (frequency_vector.size() > previous_count) {
+
+      locus_results.major_homo_freq += class_frequencies.majorHomozygous();
+      locus_results.minor_homo_freq += class_frequencies.minorHomozygous();
+      locus_results.major_hetero_freq += class_frequencies.majorHeterozygous();
+      locus_results.minor_hetero_freq += class_frequencies.minorHeterozygous();
+
+    }
+
   } // For all offset locii.
 
   // Generate some frequency statistics.
   locus_results.total_allele_count = frequency_vector.size();
   for (auto const& allele_freq : frequency_vector) {
 
-    // Get the allele class frequencies.
-    AlleleClassFrequencies class_frequencies = allele_freq.alleleFrequencies().alleleClassFrequencies(0.0);
-    locus_results.major_homo_freq += class_frequencies.majorHomozygous();
-    locus_results.minor_homo_freq += class_frequencies.minorHomozygous();
-    locus_results.major_hetero_freq += class_frequencies.majorHeterozygous();
-    locus_results.minor_hetero_freq += class_frequencies.minorHeterozygous();
-
     // Count the actual allele classes.
     switch(allele_freq.alleleType()) {
 
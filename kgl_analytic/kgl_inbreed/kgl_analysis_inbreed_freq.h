@@ -119,6 +119,8 @@ public:
 
   AlleleFreqVector( const OffsetDBArray& variant_vector,
                     const std::string& frequency_field);
+  // Allele frequencies that have already been resolved and checked.
+  explicit AlleleFreqVector(std::vector<AlleleFreqRecord> allele_frequencies) : allele_frequencies_(std::move(allele_frequencies)) {}
 
   ~AlleleFreqVector() = default;
 
@@ -170,6 +172,22 @@ private:
 
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The allele frequencies of a sampled locus, shared by all the genomes of a super population.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct LocusFrequency {
+
+  ContigOffset_t offset;
+  AlleleFreqVector allele_frequencies;
+  // The allele class frequencies with no inbreeding (f = 0).
+  AlleleClassFrequencies class_frequencies;
+
+};
+
+// The valid allele frequencies of a locus list.
+using LocusFrequencyVector = std::vector<LocusFrequency>;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // The actual allele class at a location, the actual two allele frequencies, and a vector of potential allele frequencies at a location.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -211,6 +229,55 @@ private:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The sampled locus frequencies of a genome flattened into contiguous arrays by observed allele class, for the inbreeding estimators.
+// Homozygous locii hold the frequency (p) of the homozygous allele, heterozygous locii hold the expected frequency (2pq)
+// of the observed allele pair.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class LocusFrequencyArrays {
+
+public:
+
+  explicit LocusFrequencyArrays(const std::vector<AlleleFreqInfo>& frequency_vector);
+  ~LocusFrequencyArrays() = default;
+
+  [[nodiscard]] size_t locusCount() const { return homozygous_freq_.size() + heterozygous_freq_.size(); }
+  [[nodiscard]] const std::vector<double>& homozygousFrequencies() const { return homozygous_freq_; }
+  [[nodiscard]] const std::vector<double>& heterozygousFrequencies() const { return heterozygous_freq_; }
+
+  // The log likelihood of the inbreeding coefficient (f), the derivative d/df is returned in derivative.
+  // Locus probabilities are clamped to [MIN_PROBABILITY_, 1.0], clamped locii do not contribute to the derivative.
+  [[nodiscard]] double logLikelihood(double f, double& derivative) const;
+  // The first and second derivatives of the log likelihood, d/df and d2/df2 (no logs are evaluated).
+  [[nodiscard]] std::pair<double, double> derivatives(double f) const;
+  // The coefficients in (-1, 1) below which a homozygous locus is clamped, sorted ascending. Between consecutive
+  // bounds (and above the last bound) the log likelihood is concave, so each interval has at most one maximum.
+  [[nodiscard]] const std::vector<double>& clampBounds() const { return clamp_bounds_; }
+
+  constexpr static const double MIN_PROBABILITY_{1e-10};
+
+private:
+
+  std::vector<double> homozygous_freq_;
+  std::vector<double> heterozygous_freq_;
+  // Heterozygous probabilities are (1 - f) * 2pq, so the log likelihood is closed form unless a locus is clamped.
+  double heterozygous_log_sum_{0.0};
+  double heterozygous_min_{1.0};
+  double heterozygous_max_{0.0};
+  std::vector<double> clamp_bounds_;
+
+  // Homozygous locus probabilities are multiplied in SIMD_LANES_ independent lanes and the log taken once per
+  // PRODUCT_BLOCK_ probabilities per lane. Probabilities are >= 1e-10 so the lane products cannot underflow.
+  constexpr static const size_t SIMD_LANES_{4};
+  constexpr static const size_t PRODUCT_BLOCK_{16};
+
+  [[nodiscard]] double homozygousLikelihood(double f, double& derivative) const;
+  [[nodiscard]] double heterozygousLikelihood(double f, double& derivative) const;
+
+};
+
+
 } // namespace.
 
 
@@ -6,6 +6,8 @@
 #include "kgl_variant.h"
 #include "kgl_analysis_inbreed_locus.h"
 
+#include <algorithm>
+
 
 namespace kgl = kellerberrin::genome;
 
@@ -14,169 +16,239 @@ namespace kgl = kellerberrin::genome;
 //
 
 
+kgl::LocusFrequencyColumn::LocusFrequencyColumn(const ContigDB& unphased_contig, const std::string& super_population) {
 
+  minor_frequency_.reserve(unphased_contig.getMap().size());
+  frequency_index_.reserve(unphased_contig.getMap().size());
+  allele_begin_.push_back(0);
 
-std::vector<kgl::AlleleFreqVector> kgl::RetrieveLociiVector::getAllelesFromTo( std::shared_ptr<const ContigDB> unphased_contig_ptr,
-                                                                               const std::string& super_population,
-                                                                               const LociiVectorArguments& arguments) {
+  for (auto const& [offset, offset_ptr] : unphased_contig.getMap()) {
 
-  std::vector<AlleleFreqVector> locii_vector;
-  auto current_offset = unphased_contig_ptr->getMap().lower_bound(arguments.lowerOffset());
-  ContigOffset_t previous_offset{0};
+    // Resolve the super population frequencies from the INFO evidence.
+    const OffsetDBArray& variant_array = offset_ptr->getVariantArray();
+    AlleleFreqVector allele_freq_vector(variant_array, super_population);
+    double sum_frequencies = allele_freq_vector.minorAlleleFrequencies();
+    minor_frequency_.push_back(sum_frequencies);
 
-  while (current_offset != unphased_contig_ptr->getMap().end()) {
+    if (not allele_freq_vector.checkValidAlleleVector() or sum_frequencies == 0.0) {
 
-    auto const&[offset, offset_ptr] = *current_offset;
+      frequency_index_.push_back(NO_FREQUENCY_);
+      continue;
 
-    if (offset > arguments.upperOffset()) {
+    }
 
-      // No more locii.
-      break;
+    frequency_index_.push_back(static_cast<uint32_t>(major_homozygous_.size()));
 
-    } else if ((offset >= previous_offset + arguments.lociiSpacing()) or previous_offset == 0) {
+    for (auto const& allele_freq : allele_freq_vector.alleleFrequencies()) {
 
-      const OffsetDBArray& locus_variant_array = offset_ptr->getVariantArray();
+      auto variant_iter = std::find(variant_array.begin(), variant_array.end(), allele_freq.allele());
+      allele_variant_.push_back(static_cast<uint32_t>(std::distance(variant_array.begin(), variant_iter)));
+      allele_frequency_.push_back(allele_freq.frequency());
 
-      AlleleFreqVector allele_freq_vector(locus_variant_array, super_population);
+    }
+    allele_begin_.push_back(static_cast<uint32_t>(allele_frequency_.size()));
 
-      if (not allele_freq_vector.checkValidAlleleVector()) {
+    AlleleClassFrequencies class_frequencies = allele_freq_vector.alleleClassFrequencies(0.0);
+    major_homozygous_.push_back(class_frequencies.majorHomozygous());
+    major_heterozygous_.push_back(class_frequencies.majorHeterozygous());
+    minor_homozygous_.push_back(class_frequencies.minorHomozygous());
+    minor_heterozygous_.push_back(class_frequencies.minorHeterozygous());
 
-        ++current_offset;  // next offset
-        continue; // Next locus.
+  }
 
-      }
-      // Check for allele frequencies.
-      double sum_frequencies = allele_freq_vector.minorAlleleFrequencies();
-      size_t minor_allele_count = allele_freq_vector.alleleFrequencies().size();
-      if (minor_allele_count == 0 or sum_frequencies == 0.0
-          or sum_frequencies <  arguments.minAlleleFrequency() or sum_frequencies > arguments.maxAlleleFrequency()) {
+}
 
-        ++current_offset;  // next offset
-        continue;
 
-      }
+kgl::AlleleFreqVector kgl::LocusFrequencyColumn::alleleFrequencies(size_t locus_index, const OffsetDBArray& variant_array) const {
 
-      previous_offset = offset;
-      locii_vector.push_back(allele_freq_vector);  // save offset for further use.
+  const size_t frequency_index = frequency_index_[locus_index];
+  std::vector<AlleleFreqRecord> allele_frequencies;
+  allele_frequencies.reserve(allele_begin_[frequency_index + 1] - allele_begin_[frequency_index]);
+  for (size_t allele = allele_begin_[frequency_index]; allele < allele_begin_[frequency_index + 1]; ++allele) {
 
-    } // if locii_spacing
+    allele_frequencies.emplace_back(variant_array[allele_variant_[allele]], allele_frequency_[allele]);
 
-    ++current_offset;  // next offset
+  }
 
-  } // while
+  return AlleleFreqVector(std::move(allele_frequencies));
 
-  return locii_vector;
+}
+
+
+kgl::AlleleClassFrequencies kgl::LocusFrequencyColumn::classFrequencies(size_t locus_index) const {
+
+  const size_t frequency_index = frequency_index_[locus_index];
+  return { major_homozygous_[frequency_index],
+           major_heterozygous_[frequency_index],
+           minor_homozygous_[frequency_index],
+           minor_heterozygous_[frequency_index],
+           0.0 };
 
 }
 
 
+kgl::ContigLocusTable::ContigLocusTable(std::shared_ptr<const ContigDB> unphased_contig_ptr, ThreadPool& thread_pool)
+  : unphased_contig_ptr_(std::move(unphased_contig_ptr)) {
 
-std::vector<kgl::ContigOffset_t> kgl::RetrieveLociiVector::getLociiFromTo(std::shared_ptr<const ContigDB> unphased_contig_ptr,
-                                                                          const std::string& super_population,
-                                                                          const LociiVectorArguments& arguments) {
+  // Queue the super population columns.
+  std::vector<std::pair<std::string, std::future<std::shared_ptr<const LocusFrequencyColumn>>>> column_futures;
+  for (auto const& super_pop : FrequencyDatabaseRead::superPopulations()) {
+
+    column_futures.emplace_back(super_pop, thread_pool.enqueueTask(&ContigLocusTable::createColumn, unphased_contig_ptr_, super_pop));
+
+  }
+
+  locus_offsets_.reserve(unphased_contig_ptr_->getMap().size());
+  for (auto const& [offset, offset_ptr] : unphased_contig_ptr_->getMap()) {
+
+    locus_offsets_.push_back(offset);
+
+  }
+
+  for (auto& [super_pop, column_future] : column_futures) {
+
+    frequency_columns_[super_pop] = column_future.get();
+
+  }
+
+}
+
+
+std::shared_ptr<const kgl::LocusFrequencyColumn> kgl::ContigLocusTable::createColumn(std::shared_ptr<const ContigDB> unphased_contig_ptr,
+                                                                                     std::string super_population) {
+
+  return std::make_shared<const LocusFrequencyColumn>(*unphased_contig_ptr, super_population);
+
+}
+
+
+size_t kgl::ContigLocusTable::lowerBound(ContigOffset_t offset) const {
+
+  auto offset_iter = std::lower_bound(locus_offsets_.begin(), locus_offsets_.end(), offset);
+  return static_cast<size_t>(std::distance(locus_offsets_.begin(), offset_iter));
+
+}
+
+
+std::optional<std::shared_ptr<const kgl::LocusFrequencyColumn>> kgl::ContigLocusTable::column(const std::string& super_population) const {
+
+  auto result = frequency_columns_.find(super_population);
+  if (result == frequency_columns_.end()) {
+
+    return std::nullopt;
+
+  }
+
+  return result->second;
+
+}
 
-  std::vector<kgl::ContigOffset_t> locii_vector;
 
-  std::vector<AlleleFreqVector> freq_vector = getAllelesFromTo( unphased_contig_ptr, super_population, arguments);
+kgl::LocusFrequencyVector kgl::ContigLocusTable::locusFrequencies( const std::string& super_population,
+                                                                   const std::vector<ContigOffset_t>& locii_vector) const {
 
-  for (auto const& alleles : freq_vector) {
+  LocusFrequencyVector locus_frequencies;
+  auto column_opt = column(super_population);
+  if (not column_opt) {
 
-    if (not alleles.alleleFrequencies().empty()) {
+    ExecEnv::log().error("ContigLocusTable::locusFrequencies; Super population: {} not found in locus table for contig: {}",
+                         super_population, unphased_contig_ptr_->contigId());
+    return locus_frequencies;
 
-      locii_vector.push_back(alleles.alleleFrequencies().front().allele()->offset());
+  }
+
+  const LocusFrequencyColumn& frequency_column = *column_opt.value();
+  locus_frequencies.reserve(locii_vector.size());
+  for (auto offset : locii_vector) {
+
+    size_t locus_index = lowerBound(offset);
+    auto variant_array_opt = unphased_contig_ptr_->findOffsetArray(offset);
+    if (locus_index < locus_offsets_.size() and locus_offsets_[locus_index] == offset
+        and frequency_column.sampleLocus(locus_index) and variant_array_opt) {
+
+      locus_frequencies.push_back(LocusFrequency{ offset,
+                                                  frequency_column.alleleFrequencies(locus_index, variant_array_opt.value()),
+                                                  frequency_column.classFrequencies(locus_index) });
 
     } else {
 
-      ExecEnv::log().error("RetrieveLociiVector::getLociiFromTo; empty allele vector");
+      ExecEnv::log().error("ContigLocusTable::locusFrequencies; Contig: {}, Super population: {}, no frequencies at offset: {}",
+                           unphased_contig_ptr_->contigId(), super_population, offset);
 
     }
 
   }
 
-  return locii_vector;
+  return locus_frequencies;
 
 }
 
 
 
+std::vector<kgl::ContigOffset_t> kgl::RetrieveLociiVector::selectLocii(const ContigLocusTable& locus_table,
+                                                                       const std::string& super_population,
+                                                                       const LociiVectorArguments& arguments,
+                                                                       bool count_locii) {
+
+  std::vector<ContigOffset_t> locii_vector;
+  auto column_opt = locus_table.column(super_population);
+  if (not column_opt) {
+
+    ExecEnv::log().error("RetrieveLociiVector::selectLocii; Super population: {} not found in locus table", super_population);
+    return locii_vector;
 
-std::vector<kgl::AlleleFreqVector> kgl::RetrieveLociiVector::getAllelesCount( std::shared_ptr<const ContigDB> unphased_contig_ptr,
-                                                                              const std::string& super_population,
-                                                                              const LociiVectorArguments& arguments) {
+  }
 
-  std::vector<AlleleFreqVector> locii_vector;
-  auto current_offset = unphased_contig_ptr->getMap().lower_bound(arguments.lowerOffset());
+  const LocusFrequencyColumn& frequency_column = *column_opt.value();
+  const std::vector<ContigOffset_t>& locus_offsets = locus_table.locusOffsets();
   ContigOffset_t previous_offset{0};
 
-  while (current_offset != unphased_contig_ptr->getMap().end()) {
+  for (size_t locus_index = locus_table.lowerBound(arguments.lowerOffset()); locus_index < locus_offsets.size(); ++locus_index) {
 
-    auto const&[offset, offset_ptr] = *current_offset;
+    ContigOffset_t offset = locus_offsets[locus_index];
 
-    if (locii_vector.size() >= arguments.lociiCount()) {
+    if (count_locii ? locii_vector.size() >= arguments.lociiCount() : offset > arguments.upperOffset()) {
 
       // No more locii.
       break;
 
     } else if ((offset >= previous_offset + arguments.lociiSpacing()) or previous_offset == 0) {
 
-      const OffsetDBArray& locus_variant_array = offset_ptr->getVariantArray();
-
-      AlleleFreqVector allele_freq_vector(locus_variant_array, super_population);
-
-      if (not allele_freq_vector.checkValidAlleleVector()) {
-
-        ++current_offset;  // next offset
-        continue; // Next locus.
-
-      }
       // Check for allele frequencies.
-      double sum_frequencies = allele_freq_vector.minorAlleleFrequencies();
-      size_t minor_allele_count = allele_freq_vector.alleleFrequencies().size();
-      if (minor_allele_count == 0 or sum_frequencies == 0.0
+      double sum_frequencies = frequency_column.minorFrequency(locus_index);
+      if (not frequency_column.sampleLocus(locus_index)
           or sum_frequencies < arguments.minAlleleFrequency() or sum_frequencies > arguments.maxAlleleFrequency()) {
 
-        ++current_offset;  // next offset
         continue;
 
       }
 
       previous_offset = offset;
-      locii_vector.push_back(allele_freq_vector);  // save offset for further use.
+      locii_vector.push_back(offset);  // save offset for further use.
 
     } // if locii_spacing
 
-    ++current_offset;  // next offset
-
-  } // while
+  } // for
 
   return locii_vector;
 
 }
 
 
-std::vector<kgl::ContigOffset_t> kgl::RetrieveLociiVector::getLociiCount( std::shared_ptr<const ContigDB> unphased_contig_ptr,
+std::vector<kgl::ContigOffset_t> kgl::RetrieveLociiVector::getLociiFromTo(const ContigLocusTable& locus_table,
                                                                           const std::string& super_population,
                                                                           const LociiVectorArguments& arguments) {
 
-  std::vector<kgl::ContigOffset_t> locii_vector;
+  return selectLocii(locus_table, super_population, arguments, false);
 
-  std::vector<AlleleFreqVector> freq_vector = getAllelesCount( unphased_contig_ptr, super_population, arguments);
-
-  for (auto const& alleles : freq_vector) {
-
-    if (not alleles.alleleFrequencies().empty()) {
-
-      locii_vector.push_back(alleles.alleleFrequencies().front().allele()->offset());
-
-    } else {
-
-      ExecEnv::log().error("RetrieveLociiVector::getLociiCount; empty allele vector");
+}
 
-    }
 
-  }
+std::vector<kgl::ContigOffset_t> kgl::RetrieveLociiVector::getLociiCount( const ContigLocusTable& locus_table,
+                                                                          const std::string& super_population,
+                                                                          const LociiVectorArguments& arguments) {
 
-  return locii_vector;
+  return selectLocii(locus_table, super_population, arguments, true);
 
 }
 
@@ -187,69 +259,71 @@ std::vector<kgl::ContigOffset_t> kgl::RetrieveLociiVector::getLociiCount( std::s
 //
 
 
-kgl::ContigLocusMap kgl::InbreedSampling::getPopulationLocusMap(  std::shared_ptr<const PopulationDB> population_ptr,
-                                                                  const LociiVectorArguments& locii_args) {
+kgl::ContigLocusTableMap kgl::InbreedSampling::getPopulationLocusTables( std::shared_ptr<const PopulationDB> population_ptr,
+                                                                         ThreadPool& thread_pool) {
 
-  ContigLocusMap contig_locus_map;
+  ContigLocusTableMap locus_tables;
   // We assume that the unphased population has only 1 genome.
-  if (population_ptr->getMap().size() == 1) {
+  if (population_ptr->getMap().size() != 1) {
+
+    ExecEnv::log().error( "InbreedSampling::getPopulationLocusTables, The Gnomad population has: {} genomes, expected 1.",
+                          population_ptr->getMap().size());
+    return locus_tables;
 
-    // Retrieve the genome ptr.
-    auto& [genome_id, genome_ptr] = *(population_ptr->getMap().begin());
-    // Generate contig locii maps
-    for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
+  }
 
-      contig_locus_map[contig_id] = getPopulationLocus( population_ptr, contig_id, locii_args);
+  auto const& [genome_id, genome_ptr] = *(population_ptr->getMap().begin());
+  for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
 
-      ExecEnv::log().info( "Generated locus maps for contig: {}", contig_id);
+    auto locus_table_ptr = std::make_shared<const ContigLocusTable>(contig_ptr, thread_pool);
+    ExecEnv::log().info( "Tabled locus frequencies for contig: {}, Locii: {}", contig_id, locus_table_ptr->locusOffsets().size());
+    locus_tables[contig_id] = locus_table_ptr;
 
-    }
+  }
 
-    return contig_locus_map;
+  return locus_tables;
 
-  } else {
-  // If not 1 genome, issue an error message and return an empty map;
+}
 
-    ExecEnv::log().error( "InbreedSampling::getPopulationLocusMap, The Gnomad population has: {} genomes, expected 1.",
-                          population_ptr->getMap().size());
 
-    return contig_locus_map;
+kgl::ContigLocusMap kgl::InbreedSampling::getPopulationLocusMap(  const ContigLocusTableMap& locus_tables,
+                                                                  const LociiVectorArguments& locii_args,
+                                                                  ThreadPool& thread_pool) {
 
-  }
+  ContigLocusMap contig_locus_map;
+  // Queue the locus lists for all contigs and super populations.
+  std::vector<std::pair<ContigId_t, std::future<LocusReturnPair>>> futures_vec;
+  for (auto const& [contig_id, locus_table_ptr] : locus_tables) {
 
-}
+    for (auto const& super_pop : FrequencyDatabaseRead::superPopulations()) {
 
+      auto return_future = thread_pool.enqueueTask(&InbreedSampling::getLocusList,
+                                                   locus_table_ptr,
+                                                   super_pop,
+                                                   locii_args);
 
-kgl::LocusMap kgl::InbreedSampling::getPopulationLocus(std::shared_ptr<const PopulationDB> unphased_ptr,
-                                                       const ContigId_t& contig_id,
-                                                       const LociiVectorArguments& locii_args) {
+      futures_vec.emplace_back(contig_id, std::move(return_future));
 
+    }
 
-  ThreadPool threadpool(FrequencyDatabaseRead::superPopulations().size());
-  std::vector<std::future<LocusReturnPair>> futures_vec;
+  }
 
-  for (auto const& super_pop : FrequencyDatabaseRead::superPopulations()) {
+  // Generate contig locii maps
+  for (auto& [contig_id, future] : futures_vec) {
 
-    auto return_future = threadpool.enqueueTask(&InbreedSampling::getLocusList,
-                                                unphased_ptr,
-                                                contig_id,
-                                                super_pop,
-                                                locii_args);
+    auto [super_population, sampled_locii] = future.get();
 
-    futures_vec.push_back(std::move(return_future));
+    contig_locus_map[contig_id][super_population] = sampled_locii;
 
   }
 
-  LocusMap locus_map;
-  for (auto& future : futures_vec) {
-
-    auto [ super_population, locus_list] = future.get();
+  for (auto const& [contig_id, locus_map] : contig_locus_map) {
 
-    locus_map[super_population] = locus_list;
+    ExecEnv::log().info( "Generated locus maps for contig: {}", contig_id);
 
   }
 
-  return locus_map;
+  return contig_locus_map;
 
 }
 
@@ -258,69 +332,48 @@ kgl::LocusMap kgl::InbreedSampling::getPopulationLocus(std::shared_ptr<const Pop
 // Get a list of hom/het SNPs with a specified locii_spacing to minimise linkage dis-equilibrium
 // and at a specified frequency for the super population. Used as a template for calculating
 // the inbreeding coefficient and sample relatedness
-kgl::InbreedSampling::LocusReturnPair kgl::InbreedSampling::getLocusList( std::shared_ptr<const PopulationDB> unphased_ptr,
-                                                                          const ContigId_t& contig_id,
+kgl::InbreedSampling::LocusReturnPair kgl::InbreedSampling::getLocusList( std::shared_ptr<const ContigLocusTable> locus_table,
                                                                           const std::string& super_population,
                                                                           const LociiVectorArguments& locii_args) {
 
   // Annotate the variant list with the super population frequency identifier
   std::shared_ptr<ContigDB> locus_list(std::make_shared<ContigDB>(super_population));
-  size_t locii{0};
-
-  if (unphased_ptr->getMap().size() == 1) {
+  const std::shared_ptr<const ContigDB>& snp_contig_ptr = locus_table->contig();
 
-    auto [genome_id, genome_ptr] = *(unphased_ptr->getMap().begin());
+  // Retrieve the locii that meet the conditions.
+  std::vector<ContigOffset_t> locii_vector = RetrieveLociiVector::getLociiFromTo(*locus_table, super_population, locii_args);
 
-    auto contig_opt = genome_ptr->getContig(contig_id);
+  for (auto locus : locii_vector) {
 
-    if (contig_opt) {
+    auto variant_array_opt = snp_contig_ptr->findOffsetArray(locus);
+    if (variant_array_opt) {
 
-      auto snp_contig_ptr = contig_opt.value();
+      for (auto const& variant : variant_array_opt.value()) {
 
-      // Retrieve the locii that meet the conditions.
-      std::vector<ContigOffset_t> locii_vector = RetrieveLociiVector::getLociiFromTo(snp_contig_ptr, super_population, locii_args);
+        if (not locus_list->addVariant(variant)) {
 
-      locii += locii_vector.size();
-
-      for (auto locus : locii_vector) {
-
-        auto variant_array_opt = snp_contig_ptr->findOffsetArray(locus);
-        if (variant_array_opt) {
-
-          for (auto const& variant : variant_array_opt.value()) {
-
-            if (not locus_list->addVariant(variant)) {
-
-              ExecEnv::log().error("InbreedingAnalysis::getLocusList, Could not add variant: {}",
-                                   variant->output(',', VariantOutputIndex::START_0_BASED, false));
-
-            }
-
-          }
-
-        } else {
-
-          ExecEnv::log().error("InbreedingAnalysis::getLocusList, Could not add Contig: {}, No variant found at offset: {}",
-                               snp_contig_ptr->contigId(), locus);
+          ExecEnv::log().error("InbreedingAnalysis::getLocusList, Could not add variant: {}",
+                               variant->output(',', VariantOutputIndex::START_0_BASED, false));
 
         }
 
       }
 
-    } // if contig_opt
+    } else {
 
-  } else {
+      ExecEnv::log().error("InbreedingAnalysis::getLocusList, Could not add Contig: {}, No variant found at offset: {}",
+                           snp_contig_ptr->contigId(), locus);
 
-    ExecEnv::log().error("InbreedingAnalysis::getLocusList, Unphased Population has {} Genomes, Expected 1",
-                         unphased_ptr->getMap().size());
+    }
 
   }
 
+  // The allele frequencies of the locii are shared by all genomes of the super population.
+  auto locus_frequencies = std::make_shared<const LocusFrequencyVector>(locus_table->locusFrequencies(super_population, locii_vector));
+
   ExecEnv::log().info("Locus List for super population: {} contains: Locii: {}, SNPs: {}",
-                      locus_list->contigId(), locii, locus_list->variantCount());
+                      locus_list->contigId(), locii_vector.size(), locus_list->variantCount());
 
-  return {super_population, locus_list};
+  return {super_population, SampledLocii{locus_list, locus_frequencies}};
 
 }
-
-
@@ -7,13 +7,93 @@
 
 #include "kgl_analysis_inbreed_args.h"
 #include "kgl_analysis_inbreed_freq.h"
+#include "kel_thread_pool.h"
 
 #include <memory>
 #include <map>
+#include <limits>
 
 namespace kellerberrin::genome {   //  organization::project level namespace
 
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The allele frequencies of all the locii of an unphased (Gnomad) contig, resolved once from the INFO evidence.
+// The locus offsets are held as a sorted contiguous array. Each super population has flat numeric columns, indexed as
+// the offset array, of summed minor allele frequencies and, for the locii that can be sampled (a valid allele vector
+// with a non-zero minor allele frequency), the per-allele frequencies and the allele class frequencies (f = 0).
+// The allele frequency vectors are only rebuilt for the selected locii.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class LocusFrequencyColumn {
+
+public:
+
+  LocusFrequencyColumn(const ContigDB& unphased_contig, const std::string& super_population);
+  ~LocusFrequencyColumn() = default;
+
+  // True if the locus can be sampled.
+  [[nodiscard]] bool sampleLocus(size_t locus_index) const { return frequency_index_[locus_index] != NO_FREQUENCY_; }
+  [[nodiscard]] double minorFrequency(size_t locus_index) const { return minor_frequency_[locus_index]; }
+  // Only defined for sampled locii, the variant array is the array of the tabled locus.
+  [[nodiscard]] AlleleFreqVector alleleFrequencies(size_t locus_index, const OffsetDBArray& variant_array) const;
+  [[nodiscard]] AlleleClassFrequencies classFrequencies(size_t locus_index) const;
+
+private:
+
+  std::vector<double> minor_frequency_;
+  std::vector<uint32_t> frequency_index_;
+  // The alleles of a sampled locus are [allele_begin_[index], allele_begin_[index + 1]).
+  std::vector<uint32_t> allele_begin_;
+  // The locus variant array index and super population frequency of each allele.
+  std::vector<uint32_t> allele_variant_;
+  std::vector<double> allele_frequency_;
+  // The allele class frequencies of each sampled locus.
+  std::vector<double> major_homozygous_;
+  std::vector<double> major_heterozygous_;
+  std::vector<double> minor_homozygous_;
+  std::vector<double> minor_heterozygous_;
+
+  constexpr static const uint32_t NO_FREQUENCY_{std::numeric_limits<uint32_t>::max()};
+
+};
+
+
+class ContigLocusTable {
+
+public:
+
+  // The super population columns are queued on the thread pool.
+  ContigLocusTable(std::shared_ptr<const ContigDB> unphased_contig_ptr, ThreadPool& thread_pool);
+  ~ContigLocusTable() = default;
+
+  [[nodiscard]] const std::shared_ptr<const ContigDB>& contig() const { return unphased_contig_ptr_; }
+  [[nodiscard]] const std::vector<ContigOffset_t>& locusOffsets() const { return locus_offsets_; }
+  // The index of the first locus at or above the offset.
+  [[nodiscard]] size_t lowerBound(ContigOffset_t offset) const;
+  // The column of a super population, std::nullopt if the super population is not tabled.
+  [[nodiscard]] std::optional<std::shared_ptr<const LocusFrequencyColumn>> column(const std::string& super_population) const;
+
+  // The tabled allele frequencies of the (sorted) locus offsets.
+  [[nodiscard]] LocusFrequencyVector locusFrequencies(const std::string& super_population,
+                                                      const std::vector<ContigOffset_t>& locii_vector) const;
+
+private:
+
+  std::shared_ptr<const ContigDB> unphased_contig_ptr_;
+  std::vector<ContigOffset_t> locus_offsets_;
+  std::map<std::string, std::shared_ptr<const LocusFrequencyColumn>> frequency_columns_;
+
+  [[nodiscard]] static std::shared_ptr<const LocusFrequencyColumn> createColumn(std::shared_ptr<const ContigDB> unphased_contig_ptr,
+                                                                                std::string super_population);
+
+};
+
+// Locus tables indexed by contig id.
+using ContigLocusTableMap = std::map<ContigId_t, std::shared_ptr<const ContigLocusTable>>;
+
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // This object uses a range of selection criteria to generate a vector of locii offsets used to select locii for
@@ -30,24 +110,22 @@ public:
   RetrieveLociiVector() =delete;
   ~RetrieveLociiVector() = delete;
 
-  static std::vector<ContigOffset_t> getLociiFromTo(std::shared_ptr<const ContigDB> unphased_contig_ptr,
+  static std::vector<ContigOffset_t> getLociiFromTo(const ContigLocusTable& locus_table,
                                                     const std::string& super_population,
                                                     const LociiVectorArguments& arguments);
 
-  static std::vector<ContigOffset_t> getLociiCount(std::shared_ptr<const ContigDB> unphased_contig_ptr,
+  static std::vector<ContigOffset_t> getLociiCount(const ContigLocusTable& locus_table,
                                                    const std::string& super_population,
                                                    const LociiVectorArguments& arguments);
 
 private:
 
-
-  static std::vector<AlleleFreqVector> getAllelesFromTo( std::shared_ptr<const ContigDB> unphased_contig_ptr,
-                                                         const std::string& super_population,
-                                                         const LociiVectorArguments& arguments);
-
-  static std::vector<AlleleFreqVector> getAllelesCount( std::shared_ptr<const ContigDB> unphased_contig_ptr,
-                                                        const std::string& super_population,
-                                                        const LociiVectorArguments& arguments);
+  // Select spaced locii within the frequency bounds from the offset array, until the upper offset is exceeded
+  // or the locii count is reached.
+  static std::vector<ContigOffset_t> selectLocii(const ContigLocusTable& locus_table,
+                                                 const std::string& super_population,
+                                                 const LociiVectorArguments& arguments,
+                                                 bool count_locii);
 
 };
 
@@ -58,8 +136,16 @@ private:
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// Allele locus lists indexed by superpopulation
-using LocusMap = std::map<std::string, std::shared_ptr<const ContigDB>>;
+// The selected locii of a super population and their tabled allele frequencies.
+struct SampledLocii {
+
+  std::shared_ptr<const ContigDB> locus_list;
+  std::shared_ptr<const LocusFrequencyVector> locus_frequencies;
+
+};
+
+// Sampled locii indexed by superpopulation
+using LocusMap = std::map<std::string, SampledLocii>;
 // LocusMaps indexed by contig id.
 using ContigLocusMap = std::map<ContigId_t, LocusMap>;
 
@@ -72,9 +158,15 @@ public:
   ~InbreedSampling() = delete;
 
 
-  // Uses the defined contigs in the unphased population to create a contig map of population locii.
-  [[nodiscard]] static ContigLocusMap getPopulationLocusMap(  std::shared_ptr<const PopulationDB> population_ptr,
-                                                              const LociiVectorArguments& locii_args);
+  // Table the locus frequencies of all contigs of the unphased population. Called once per analysis.
+  [[nodiscard]] static ContigLocusTableMap getPopulationLocusTables( std::shared_ptr<const PopulationDB> population_ptr,
+                                                                     ThreadPool& thread_pool);
+
+  // Uses the tabled contigs of the unphased population to create a contig map of population locii.
+  // The contig x super population locus lists are all queued on the thread pool before any are retrieved.
+  [[nodiscard]] static ContigLocusMap getPopulationLocusMap(  const ContigLocusTableMap& locus_tables,
+                                                              const LociiVectorArguments& locii_args,
+                                                              ThreadPool& thread_pool);
 
 private:
 
@@ -82,17 +174,11 @@ private:
   // Get a list of potential allele locus with a specified spacing to minimise linkage dis-equilibrium
   // and at a specified frequency for the super population. Used as a template for calculating
   // the inbreeding coefficient and sample relatedness
-  using LocusReturnPair = std::pair<std::string, std::shared_ptr<const ContigDB>>;
-  [[nodiscard]] static LocusReturnPair getLocusList( std::shared_ptr<const PopulationDB> unphased_ptr,
-                                                     const ContigId_t& contig_id,
+  using LocusReturnPair = std::pair<std::string, SampledLocii>;
+  [[nodiscard]] static LocusReturnPair getLocusList( std::shared_ptr<const ContigLocusTable> locus_table,
                                                      const std::string& super_population,
                                                      const LociiVectorArguments& locii_args);
 
-  // Generate a list of locii to sample a population for the inbreeding coefficient.
-  [[nodiscard]] static LocusMap getPopulationLocus(std::shared_ptr<const PopulationDB> unphased_ptr,
-                                                   const ContigId_t& contig_id,
-                                                   const LociiVectorArguments& locii_args);
-
 };
 
 
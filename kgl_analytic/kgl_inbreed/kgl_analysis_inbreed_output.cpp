@@ -25,6 +25,23 @@ std::string kgl::InbreedingResultColumn::generateIdent(const ContigId_t& contig_
 }
 
 
+void kgl::InbreedParamOutput::addColumn(const std::string& column_ident, PendingResults& pending_results) {
+
+  ResultsMap results_map;
+  for (auto& future : pending_results) {
+
+    auto locus_results = future.get();
+    ExecEnv::log().info("Processed Diploid genome: {} for inbreeding and relatedness", locus_results.genome);
+    results_map[locus_results.genome] = locus_results;
+
+  }
+
+  pending_results.clear();
+  column_results_.emplace_back(column_ident, std::move(results_map));
+
+}
+
+
 // Consistency check; all columns have the same row structure.
 bool kgl::InbreedParamOutput::verifyResults() const {
 
@@ -9,6 +9,8 @@
 #include "kgl_Hsgenealogy_parser.h"
 #include "kgl_analysis_inbreed_args.h"
 
+#include <future>
+
 
 namespace kellerberrin::genome {   //  organization::project level namespace
 
@@ -43,6 +45,8 @@ struct LocusResults {
 
 
 using ResultsMap = std::map<GenomeId_t, LocusResults>;
+// Results queued on the analysis thread pool, retrieved in submission order (later results for a genome replace earlier results).
+using PendingResults = std::vector<std::future<LocusResults>>;
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -92,6 +96,8 @@ public:
   ~InbreedParamOutput() = default;
 
   void addColumn(const InbreedingResultColumn& column) { column_results_.push_back(column); }
+  // Waits on the queued results and adds them as a column.
+  void addColumn(const std::string& column_ident, PendingResults& pending_results);
   [[nodiscard]] const std::vector<InbreedingResultColumn>& getColumns() const { return column_results_; }
   [[nodiscard]] const InbreedingParameters& getParameters() const { return parameters_; }
   // Non-const version
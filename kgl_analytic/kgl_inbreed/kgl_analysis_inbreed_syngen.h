@@ -47,16 +47,14 @@ public:
   [[nodiscard]] static std::pair<bool, double> generateInbreeding(const GenomeId_t& genome_id);
 
 
-  // Synthetic genome constant
-  constexpr static const double SYNTHETIC_GENOME = 1000000; // Used to create the synthetic genome id.
-
-private:
-
   // Generate an inbreeding encoded synthetic genome
   [[nodiscard]] static GenomeId_t generateSyntheticGenomeId( double inbreeding,
                                                              const std::string& super_population,
                                                              size_t counter);
 
+  // Synthetic genome constant
+  constexpr static const double SYNTHETIC_GENOME = 1000000; // Used to create the synthetic genome id.
+
 };
 
 
@@ -0,0 +1,453 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_analysis_inbreed_syngen_vcf.h"
+#include "kgl_analysis_inbreed_syngen.h"
+#include "kel_bzip.h"
+
+#include <deque>
+#include <cmath>
+#include <charconv>
+#include <algorithm>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+kgl::SyntheticVCFGenerator::SyntheticVCFGenerator(const SyntheticVCFArgs& args) : args_(args) {
+
+  args_.site_spacing = std::max<size_t>(args_.site_spacing, 1);
+  args_.thread_count = std::max<size_t>(args_.thread_count, 1);
+  args_.multi_allelic_rate = std::clamp(args_.multi_allelic_rate, 0.0, 1.0);
+  args_.min_inbreeding = std::clamp(args_.min_inbreeding, -1.0, 1.0);
+  args_.max_inbreeding = std::clamp(args_.max_inbreeding, args_.min_inbreeding, 1.0);
+
+  // Samples are assigned to the super populations in rotation, the inbreeding coefficients are evenly spaced.
+  const double inbreeding_step = args_.sample_count > 1 ? (args_.max_inbreeding - args_.min_inbreeding) / static_cast<double>(args_.sample_count - 1) : 0.0;
+  samples_.reserve(args_.sample_count);
+  for (size_t sample = 0; sample < args_.sample_count; ++sample) {
+
+    const size_t population_index = sample % POPULATION_COUNT_;
+    const double inbreeding = args_.min_inbreeding + (inbreeding_step * static_cast<double>(sample));
+    samples_.push_back({ InbreedSynthetic::generateSyntheticGenomeId(inbreeding, POPULATION_FIELDS_[population_index].super_population, sample),
+                         population_index,
+                         inbreeding });
+
+  }
+
+}
+
+
+bool kgl::SyntheticVCFGenerator::writeVCF(const std::string& file_name) const {
+
+  BGZWriter bgz_writer(args_.thread_count);
+  if (not bgz_writer.open(file_name)) {
+
+    ExecEnv::log().error("SyntheticVCFGenerator::writeVCF; unable to open synthetic VCF file: {}", file_name);
+    return false;
+
+  }
+
+  if (not bgz_writer.write(headerText())) {
+
+    ExecEnv::log().error("SyntheticVCFGenerator::writeVCF; unable to write VCF header to file: {}", file_name);
+    return false;
+
+  }
+
+  // The site blocks are generated in parallel and written in order, the number of queued blocks is bounded.
+  ThreadPool generate_threads(args_.thread_count);
+  const size_t block_count = (args_.site_count + SITE_BLOCK_ - 1) / SITE_BLOCK_;
+  const size_t max_pending = 2 * args_.thread_count;
+  std::deque<std::future<std::string>> pending_blocks;
+  size_t next_block{0};
+  bool write_ok{true};
+  while (next_block < block_count or not pending_blocks.empty()) {
+
+    while (next_block < block_count and pending_blocks.size() < max_pending) {
+
+      pending_blocks.push_back(generate_threads.enqueueTask(&SyntheticVCFGenerator::generateBlock, this, next_block));
+      ++next_block;
+
+    }
+
+    std::string block_text = pending_blocks.front().get();
+    pending_blocks.pop_front();
+    if (write_ok and not bgz_writer.write(block_text)) {
+
+      ExecEnv::log().error("SyntheticVCFGenerator::writeVCF; error writing synthetic VCF file: {}", file_name);
+      write_ok = false;
+
+    }
+
+  }
+
+  if (not bgz_writer.close() or not write_ok) {
+
+    return false;
+
+  }
+
+  ExecEnv::log().info("SyntheticVCFGenerator::writeVCF; wrote file: {}, Contig: {}, Sites: {}, Samples: {}, Phased: {}",
+                      file_name, args_.contig_id, args_.site_count, samples_.size(), args_.phased);
+
+  return true;
+
+}
+
+
+std::string kgl::SyntheticVCFGenerator::headerText() const {
+
+  const bool genome_1000 = args_.info_style == SyntheticInfoStyle::GENOME_1000;
+  const size_t contig_length = args_.start_offset + ((args_.site_count + 1) * args_.site_spacing);
+
+  std::string header;
+  header += "##fileformat=VCFv4.2\n";
+  header += "##source=kglSyntheticVCF\n";
+  header += "##contig=<ID=" + args_.contig_id + ",length=" + std::to_string(contig_length) + ">\n";
+  header += "##FILTER=<ID=PASS,Description=\"All filters passed\">\n";
+  header += "##INFO=<ID=AC,Number=A,Type=Integer,Description=\"Alternate allele count\">\n";
+  header += "##INFO=<ID=AN,Number=1,Type=Integer,Description=\"Total number of alleles\">\n";
+  header += "##INFO=<ID=AF,Number=A,Type=Float,Description=\"Alternate allele frequency\">\n";
+  for (auto const& population_field : POPULATION_FIELDS_) {
+
+    header += "##INFO=<ID=";
+    header += genome_1000 ? population_field.genome_1000_field : population_field.gnomad_field;
+    header += ",Number=A,Type=Float,Description=\"Alternate allele frequency in the ";
+    header += population_field.super_population;
+    header += " super population\">\n";
+
+  }
+
+  if (not samples_.empty()) {
+
+    header += "##FORMAT=<ID=GT,Number=1,Type=String,Description=\"Genotype\">\n";
+
+  }
+
+  header += "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO";
+  if (not samples_.empty()) {
+
+    header += "\tFORMAT";
+    for (auto const& sample : samples_) {
+
+      header += '\t';
+      header += sample.genome_id;
+
+    }
+
+  }
+  header += '\n';
+
+  return header;
+
+}
+
+
+std::string kgl::SyntheticVCFGenerator::generateBlock(size_t block_index) const {
+
+  DeterministicEntropySource entropy_source(args_.seed + (block_index * SEED_STRIDE_));
+  EntropyGenerator& generator = entropy_source.generator();
+  UniformUnitDistribution unit_distribution;
+  RandomBoolean random_boolean;
+  UniformIntegerDistribution offset_jitter(0, args_.site_spacing - 1);
+
+  const bool genome_1000 = args_.info_style == SyntheticInfoStyle::GENOME_1000;
+  const size_t first_site = block_index * SITE_BLOCK_;
+  const size_t last_site = std::min(first_site + SITE_BLOCK_, args_.site_count);
+  const double log_min_frequency = std::log(MIN_FREQUENCY_);
+  const double log_frequency_range = std::log(MAX_FREQUENCY_) - log_min_frequency;
+
+  std::string block_text;
+  block_text.reserve((last_site - first_site) * (128 + (4 * samples_.size())));
+  std::string genotype_text;
+  genotype_text.reserve(4 * samples_.size());
+
+  for (size_t site = first_site; site < last_site; ++site) {
+
+    const ContigOffset_t offset = args_.start_offset + (site * args_.site_spacing) + offset_jitter.random(generator);
+
+    // Reference and distinct alternate nucleotides.
+    std::array<char, MAX_ALLELES_> nucleotides{'A', 'C', 'G', 'T'};
+    std::shuffle(nucleotides.begin(), nucleotides.end(), generator);
+    size_t alternate_count{1};
+    if (unit_distribution.random(generator) < args_.multi_allelic_rate) {
+
+      alternate_count = random_boolean.random(generator) ? MAX_ALTERNATE_ : MAX_ALTERNATE_ - 1;
+
+    }
+    const size_t allele_count = alternate_count + 1;
+
+    // The total alternate frequency is log uniform, split between the alternate alleles in descending order.
+    AlleleFrequencies site_frequencies{};
+    const double alternate_frequency = std::exp(log_min_frequency + (unit_distribution.random(generator) * log_frequency_range));
+    double weight_sum{0.0};
+    for (size_t allele = 1; allele < allele_count; ++allele) {
+
+      site_frequencies[allele] = unit_distribution.random(generator) + MIN_FREQUENCY_;
+      weight_sum += site_frequencies[allele];
+
+    }
+    std::sort(site_frequencies.begin() + 1, site_frequencies.begin() + static_cast<std::ptrdiff_t>(allele_count), std::greater<>());
+    for (size_t allele = 1; allele < allele_count; ++allele) {
+
+      site_frequencies[allele] *= alternate_frequency / weight_sum;
+
+    }
+    site_frequencies[0] = 1.0 - alternate_frequency;
+
+    std::array<AlleleFrequencies, POPULATION_COUNT_> population_frequencies;
+    for (auto& frequencies : population_frequencies) {
+
+      frequencies = populationFrequencies(site_frequencies, allele_count, generator);
+
+    }
+
+    // Sample genotypes, the allele counts are accumulated per super population.
+    std::array<AlleleCounts, POPULATION_COUNT_> population_counts{};
+    genotype_text.clear();
+    for (auto const& sample : samples_) {
+
+      auto [first, second] = drawGenotype(population_frequencies[sample.population_index],
+                                          allele_count,
+                                          sample.inbreeding,
+                                          unit_distribution.random(generator));
+      ++population_counts[sample.population_index][first];
+      ++population_counts[sample.population_index][second];
+
+      if (args_.phased and first != second and random_boolean.random(generator)) {
+
+        std::swap(first, second);
+
+      }
+
+      genotype_text += '\t';
+      genotype_text += static_cast<char>('0' + first);
+      genotype_text += args_.phased ? '|' : '/';
+      genotype_text += static_cast<char>('0' + second);
+
+    }
+
+    // The site frequencies and counts, sites only files use the model frequencies.
+    AlleleFrequencies allele_frequencies{};
+    AlleleCounts allele_counts{};
+    std::array<AlleleFrequencies, POPULATION_COUNT_> info_frequencies{};
+    size_t allele_number{SITES_ONLY_ALLELES_};
+    if (samples_.empty()) {
+
+      info_frequencies = population_frequencies;
+      allele_frequencies = site_frequencies;
+      for (size_t allele = 1; allele < allele_count; ++allele) {
+
+        allele_counts[allele] = static_cast<size_t>(std::lround(site_frequencies[allele] * static_cast<double>(allele_number)));
+
+      }
+
+    } else {
+
+      allele_number = 2 * samples_.size();
+      for (size_t population = 0; population < POPULATION_COUNT_; ++population) {
+
+        size_t population_alleles{0};
+        for (size_t allele = 0; allele < allele_count; ++allele) {
+
+          population_alleles += population_counts[population][allele];
+          allele_counts[allele] += population_counts[population][allele];
+
+        }
+
+        for (size_t allele = 1; allele < allele_count and population_alleles > 0; ++allele) {
+
+          info_frequencies[population][allele] = static_cast<double>(population_counts[population][allele]) / static_cast<double>(population_alleles);
+
+        }
+
+      }
+
+      for (size_t allele = 1; allele < allele_count; ++allele) {
+
+        allele_frequencies[allele] = static_cast<double>(allele_counts[allele]) / static_cast<double>(allele_number);
+
+      }
+
+    }
+
+    block_text += args_.contig_id;
+    block_text += '\t';
+    block_text += std::to_string(offset + 1);  // VCF positions are 1-based.
+    block_text += "\t.\t";
+    block_text += nucleotides[0];
+    block_text += '\t';
+    for (size_t allele = 1; allele < allele_count; ++allele) {
+
+      if (allele > 1) block_text += ',';
+      block_text += nucleotides[allele];
+
+    }
+    block_text += "\t.\tPASS\tAC=";
+    for (size_t allele = 1; allele < allele_count; ++allele) {
+
+      if (allele > 1) block_text += ',';
+      block_text += std::to_string(allele_counts[allele]);
+
+    }
+    block_text += ";AN=";
+    block_text += std::to_string(allele_number);
+    block_text += ";AF=";
+    for (size_t allele = 1; allele < allele_count; ++allele) {
+
+      if (allele > 1) block_text += ',';
+      appendFrequency(block_text, allele_frequencies[allele]);
+
+    }
+    for (size_t population = 0; population < POPULATION_COUNT_; ++population) {
+
+      block_text += ';';
+      block_text += genome_1000 ? POPULATION_FIELDS_[population].genome_1000_field : POPULATION_FIELDS_[population].gnomad_field;
+      block_text += '=';
+      for (size_t allele = 1; allele < allele_count; ++allele) {
+
+        if (allele > 1) block_text += ',';
+        appendFrequency(block_text, info_frequencies[population][allele]);
+
+      }
+
+    }
+
+    if (not samples_.empty()) {
+
+      block_text += "\tGT";
+      block_text += genotype_text;
+
+    }
+    block_text += '\n';
+
+  }
+
+  return block_text;
+
+}
+
+
+// Each alternate allele frequency is drawn from Beta(q(1-F)/F, (1-q)(1-F)/F) which has mean q and variance F.q.(1-q).
+kgl::SyntheticVCFGenerator::AlleleFrequencies
+kgl::SyntheticVCFGenerator::populationFrequencies(const AlleleFrequencies& site_frequencies,
+                                                  size_t allele_count,
+                                                  EntropyGenerator& generator) const {
+
+  AlleleFrequencies frequencies{};
+  double alternate_sum{0.0};
+  for (size_t allele = 1; allele < allele_count; ++allele) {
+
+    const double site_frequency = site_frequencies[allele];
+    if (args_.population_fst <= 0.0 or args_.population_fst >= 1.0) {
+
+      frequencies[allele] = site_frequency;
+
+    } else {
+
+      const double scale = (1.0 - args_.population_fst) / args_.population_fst;
+      std::gamma_distribution<double> alternate_gamma(site_frequency * scale, 1.0);
+      std::gamma_distribution<double> other_gamma((1.0 - site_frequency) * scale, 1.0);
+      const double alternate_variate = alternate_gamma(generator);
+      const double variate_sum = alternate_variate + other_gamma(generator);
+      frequencies[allele] = variate_sum > 0.0 ? alternate_variate / variate_sum : 0.0;
+
+    }
+
+    alternate_sum += frequencies[allele];
+
+  }
+
+  if (alternate_sum > MAX_ALTERNATE_SUM_) {
+
+    for (size_t allele = 1; allele < allele_count; ++allele) {
+
+      frequencies[allele] *= MAX_ALTERNATE_SUM_ / alternate_sum;
+
+    }
+    alternate_sum = MAX_ALTERNATE_SUM_;
+
+  }
+
+  frequencies[0] = 1.0 - alternate_sum;
+
+  return frequencies;
+
+}
+
+
+// Homozygous p(i,i) = f.p(i) + (1-f).p(i)^2, heterozygous p(i,j) = 2.(1-f).p(i).p(j).
+// Negative (outbred) coefficients can give negative homozygous probabilities, these are truncated to zero.
+std::pair<size_t, size_t> kgl::SyntheticVCFGenerator::drawGenotype(const AlleleFrequencies& frequencies,
+                                                                   size_t allele_count,
+                                                                   double inbreeding,
+                                                                   double unit_random) {
+
+  std::array<double, (MAX_ALLELES_ * (MAX_ALLELES_ + 1)) / 2> class_frequencies{};
+  double class_sum{0.0};
+  size_t class_index{0};
+  for (size_t first = 0; first < allele_count; ++first) {
+
+    for (size_t second = first; second < allele_count; ++second) {
+
+      double class_frequency{0.0};
+      if (first == second) {
+
+        class_frequency = (inbreeding * frequencies[first]) + ((1.0 - inbreeding) * frequencies[first] * frequencies[first]);
+
+      } else {
+
+        class_frequency = 2.0 * (1.0 - inbreeding) * frequencies[first] * frequencies[second];
+
+      }
+
+      class_frequencies[class_index] = std::max(class_frequency, 0.0);
+      class_sum += class_frequencies[class_index];
+      ++class_index;
+
+    }
+
+  }
+
+  double class_threshold = unit_random * class_sum;
+  class_index = 0;
+  for (size_t first = 0; first < allele_count; ++first) {
+
+    for (size_t second = first; second < allele_count; ++second) {
+
+      class_threshold -= class_frequencies[class_index];
+      if (class_threshold <= 0.0) {
+
+        return {first, second};
+
+      }
+      ++class_index;
+
+    }
+
+  }
+
+  // Rounding, return the most probable genotype.
+  return {0, 0};
+
+}
+
+
+void kgl::SyntheticVCFGenerator::appendFrequency(std::string& text, double frequency) {
+
+  std::array<char, 32> buffer{};
+  auto [end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), frequency, std::chars_format::general, FREQUENCY_PRECISION_);
+  if (error_code == std::errc()) {
+
+    text.append(buffer.data(), end_ptr);
+
+  } else {
+
+    text += std::to_string(frequency);
+
+  }
+
+}
+
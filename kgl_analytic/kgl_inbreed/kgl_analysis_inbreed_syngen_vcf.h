@@ -0,0 +1,132 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_ANALYSIS_INBREED_SYNGEN_VCF_H
+#define KGL_ANALYSIS_INBREED_SYNGEN_VCF_H
+
+
+#include "kgl_genome_types.h"
+#include "kel_distribution.h"
+#include "kel_thread_pool.h"
+
+#include <string>
+#include <vector>
+#include <array>
+
+
+namespace kellerberrin::genome {   //  organization::project level namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Writes synthetic population VCF files (block gzipped) to benchmark and regression test the VCF parser,
+// the population database and the analysis packages at a configurable scale.
+// Site alternate allele frequencies are drawn from a log uniform spectrum and the super population frequencies
+// diverge from the site frequency by the Balding-Nichols model (Fst). Sample genotypes are drawn from the super
+// population frequencies and the sample inbreeding coefficient, which is encoded in the sample id
+// (see InbreedSynthetic::generateInbreeding()).
+// Sites are generated in blocks on a thread pool, each block is seeded by the block index, so the file is
+// identical for a given seed irrespective of the thread count.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The naming of the super population frequency INFO fields.
+enum class SyntheticInfoStyle { GENOME_1000, GNOMAD };
+
+struct SyntheticVCFArgs {
+
+  std::string contig_id{"chr22"};
+  ContigOffset_t start_offset{16'000'000};
+  size_t site_count{100'000};
+  size_t site_spacing{50};          // Mean spacing of the sites.
+  size_t sample_count{2'504};       // Zero samples is a sites only (gnomAD-like) file.
+  double multi_allelic_rate{0.05};  // Proportion of sites with 2 or 3 alternate alleles.
+  bool phased{true};
+  double min_inbreeding{0.0};       // Sample inbreeding coefficients are evenly spaced on [min, max].
+  double max_inbreeding{0.0};
+  double population_fst{0.05};      // Super population divergence.
+  SyntheticInfoStyle info_style{SyntheticInfoStyle::GENOME_1000};
+  size_t seed{1111};
+  size_t thread_count{ThreadPool::defaultThreads()};
+
+};
+
+
+class SyntheticVCFGenerator {
+
+public:
+
+  explicit SyntheticVCFGenerator(const SyntheticVCFArgs& args);
+  ~SyntheticVCFGenerator() = default;
+
+  // Generate and write the VCF file, returns false on any error.
+  [[nodiscard]] bool writeVCF(const std::string& file_name) const;
+
+private:
+
+  struct SyntheticSample {
+
+    GenomeId_t genome_id;
+    size_t population_index;
+    double inbreeding;
+
+  };
+
+  // The super populations and the matching 1000 Genomes and gnomAD frequency fields.
+  struct PopulationField {
+
+    const char* super_population;
+    const char* genome_1000_field;
+    const char* gnomad_field;
+
+  };
+
+  constexpr static const size_t POPULATION_COUNT_{5};
+  constexpr static const std::array<PopulationField, POPULATION_COUNT_> POPULATION_FIELDS_ = {{ {"AFR", "AFR_AF", "AF_afr"},
+                                                                                               {"AMR", "AMR_AF", "AF_amr"},
+                                                                                               {"EAS", "EAS_AF", "AF_eas"},
+                                                                                               {"EUR", "EUR_AF", "AF_nfe"},
+                                                                                               {"SAS", "SAS_AF", "AF_sas"} }};
+
+  // A site has a reference and up to MAX_ALTERNATE_ alternate alleles.
+  constexpr static const size_t MAX_ALTERNATE_{3};
+  constexpr static const size_t MAX_ALLELES_{MAX_ALTERNATE_ + 1};
+  using AlleleFrequencies = std::array<double, MAX_ALLELES_>;
+  using AlleleCounts = std::array<size_t, MAX_ALLELES_>;
+
+  constexpr static const size_t SITE_BLOCK_{256};
+  constexpr static const size_t SEED_STRIDE_{7919};   // Separates the block entropy seeds.
+  constexpr static const double MIN_FREQUENCY_{1.0e-04};
+  constexpr static const double MAX_FREQUENCY_{0.5};
+  constexpr static const double MAX_ALTERNATE_SUM_{0.99};
+  constexpr static const size_t SITES_ONLY_ALLELES_{152'312};   // gnomAD 3.1 allele number, used if there are no samples.
+  constexpr static const int FREQUENCY_PRECISION_{6};
+
+  SyntheticVCFArgs args_;
+  std::vector<SyntheticSample> samples_;
+
+  [[nodiscard]] std::string headerText() const;
+  // Thread pool worker function, the VCF text of a block of sites.
+  [[nodiscard]] std::string generateBlock(size_t block_index) const;
+  // Balding-Nichols super population frequencies, the alternate alleles sum to less than MAX_ALTERNATE_SUM_.
+  [[nodiscard]] AlleleFrequencies populationFrequencies(const AlleleFrequencies& site_frequencies,
+                                                        size_t allele_count,
+                                                        EntropyGenerator& generator) const;
+  // Draw an unordered genotype (first <= second) from the inbreeding adjusted genotype class frequencies.
+  [[nodiscard]] static std::pair<size_t, size_t> drawGenotype(const AlleleFrequencies& frequencies,
+                                                              size_t allele_count,
+                                                              double inbreeding,
+                                                              double unit_random);
+
+  static void appendFrequency(std::string& text, double frequency);
+
+};
+
+
+
+} // namespace
+
+
+
+#endif //KGL_ANALYSIS_INBREED_SYNGEN_VCF_H
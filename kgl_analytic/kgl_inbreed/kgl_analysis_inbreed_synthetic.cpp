@@ -13,8 +13,9 @@ namespace kgl = kellerberrin::genome;
 
 
 // Calculate the Synthetic Population Inbreeding Coefficient
-bool kgl::SyntheticAnalysis::syntheticInbreeding(std::shared_ptr<const PopulationDB> unphased_ptr,
-                                                 InbreedParamOutput& param_output) {
+bool kgl::SyntheticAnalysis::syntheticInbreeding( std::shared_ptr<const PopulationDB> unphased_ptr,
+                                                  InbreedParamOutput& param_output,
+                                                  ThreadPool& thread_pool) {
 
 
   // check that unphased population onlu has 1 genome
@@ -39,68 +40,81 @@ bool kgl::SyntheticAnalysis::syntheticInbreeding(std::shared_ptr<const Populatio
   // Get the size of the contig.
   auto [contig_id, contig_ptr] = *contig_map->getMap().begin();
 
+  // Table the unphased locus frequencies once, all the sample regions index the table.
+  ContigLocusTableMap locus_tables = InbreedSampling::getPopulationLocusTables(unphased_ptr, thread_pool);
+  const ContigLocusTable& locus_table = *locus_tables.at(contig_id);
+
   InbreedingParameters local_params = param_output.getParameters();
-  std::vector<ContigOffset_t> locii_vector = RetrieveLociiVector::getLociiCount(contig_ptr,
+  std::vector<ContigOffset_t> locii_vector = RetrieveLociiVector::getLociiCount(locus_table,
                                                                                 FrequencyDatabaseRead::SUPER_POP_ALL_,
                                                                                 local_params.lociiArguments());
   local_params.lociiArguments().upperOffset(locii_vector.back());
 
+  std::vector<std::pair<std::string, PendingResults>> pending_columns;
   while ( local_params.lociiArguments().upperOffset() < param_output.getParameters().lociiArguments().upperOffset()
           and locii_vector.size() >= 100) {
 
-    ResultsMap results_map = processSynResults( unphased_ptr, param_output.getParameters());
-
     // Generate a string to identify these results.
     std::string result_ident = InbreedingResultColumn::generateIdent( contig_id,
                                                                       local_params.lociiArguments().lowerOffset(),
                                                                       local_params.lociiArguments().upperOffset());
-    // Store the synthetic computation results.
-    param_output.addColumn(InbreedingResultColumn(result_ident, results_map));
+    // Queue the synthetic computations, the results are retrieved after all the sample regions have been queued.
+    pending_columns.emplace_back(result_ident, queueSynResults( locus_tables, param_output.getParameters(), thread_pool));
 
     local_params.lociiArguments().lowerOffset(local_params.lociiArguments().upperOffset());
-    locii_vector = RetrieveLociiVector::getLociiCount(contig_ptr,
+    locii_vector = RetrieveLociiVector::getLociiCount(locus_table,
                                                       FrequencyDatabaseRead::SUPER_POP_ALL_,
                                                       local_params.lociiArguments());
     local_params.lociiArguments().upperOffset(locii_vector.back());
 
   }
 
+  // Store the synthetic computation results.
+  for (auto& [result_ident, pending_results] : pending_columns) {
+
+    param_output.addColumn(result_ident, pending_results);
+
+  }
+
   return true;
 
 }
 
 
-kgl::ResultsMap kgl::SyntheticAnalysis::processSynResults( std::shared_ptr<const PopulationDB> unphased_ptr,
-                                                           const InbreedingParameters& parameters) {
+kgl::PendingResults kgl::SyntheticAnalysis::queueSynResults( const ContigLocusTableMap& locus_tables,
+                                                             const InbreedingParameters& parameters,
+                                                             ThreadPool& thread_pool) {
 
-  ResultsMap results_map;
+  PendingResults future_vector;
   // Retrieve the algorithm function object.
   auto algorithm_opt = InbreedingCalculation::namedAlgorithm(parameters.inbreedingAlgorthim());
 
   if (not algorithm_opt) {
 
     ExecEnv::log().error("InbreedingAnalysis::populationInbreeding, Inbreeding algorithm not found: {}", parameters.inbreedingAlgorthim());
-    return  results_map;
+    return future_vector;
 
   }
 
-  ContigLocusMap contig_locus_map = InbreedSampling::getPopulationLocusMap(unphased_ptr, parameters.lociiArguments());
+  // Batched algorithms share the locus frequencies and are queued as genome batches.
+  const bool batch_algorithm = InbreedingCalculation::batchAlgorithm(parameters.inbreedingAlgorthim());
+  InbreedingBatchQueue batch_queue(thread_pool);
+
+  ContigLocusMap contig_locus_map = InbreedSampling::getPopulationLocusMap(locus_tables, parameters.lociiArguments(), thread_pool);
 
   // For each contig.
   for (auto const& [genome_contig_id, locus_map] : contig_locus_map) {
 
-    // Use a thread pool to calculate inbreeding and relatedness.
-    for (auto const&[super_pop_id, locus_list] : locus_map) {
+    // Queue each synthetic population on the thread pool as it is generated to calculate inbreeding and relatedness.
+    for (auto const&[super_pop_id, sampled_locii] : locus_map) {
 
       std::shared_ptr<const PopulationDB> population = InbreedSynthetic::generateSyntheticPopulation(MIN_INBREEDING_COEFICIENT,
                                                                                                      MAX_INBREEDING_COEFICIENT,
                                                                                                      STEP_INBREEDING_COEFICIENT,
                                                                                                      super_pop_id,
-                                                                                                     *locus_list,
+                                                                                                     *sampled_locii.locus_list,
                                                                                                      parameters.lociiArguments());
 
-      ThreadPool thread_pool(ThreadPool::defaultThreads());
-      std::vector<std::future<LocusResults>> future_vector;
       for (auto const&[genome_id, genome_ptr] : population->getMap()) {
 
         auto contig_opt = genome_ptr->getContig(genome_contig_id);
@@ -108,23 +122,22 @@ kgl::ResultsMap kgl::SyntheticAnalysis::processSynResults( std::shared_ptr<const
         if (contig_opt) {
 
 
-          std::future<LocusResults> future = thread_pool.enqueueTask(algorithm_opt.value(),
-                                                                     genome_id,
-                                                                     contig_opt.value(),
-                                                                     super_pop_id,
-                                                                     locus_list );
-          future_vector.push_back(std::move(future));
+          if (batch_algorithm) {
 
-        }
+            batch_queue.addGenome(genome_id, contig_opt.value(), super_pop_id, sampled_locii.locus_frequencies, future_vector);
 
-      }
+          } else {
 
-      // Retrieve the thread results into a map.
-      for (auto &future : future_vector) {
+            std::future<LocusResults> future = thread_pool.enqueueTask(algorithm_opt.value(),
+                                                                       genome_id,
+                                                                       contig_opt.value(),
+                                                                       super_pop_id,
+                                                                       sampled_locii.locus_frequencies );
+            future_vector.push_back(std::move(future));
 
-        auto locus_results = future.get();
-        ExecEnv::log().info("Processed Diploid genome: {} for inbreeding and relatedness", locus_results.genome);
-        results_map[locus_results.genome] = locus_results;
+          }
+
+        }
 
       }
 
@@ -132,7 +145,9 @@ kgl::ResultsMap kgl::SyntheticAnalysis::processSynResults( std::shared_ptr<const
 
   } // for contig.
 
-  return results_map;
+  batch_queue.queueBatches();
+
+  return future_vector;
 
 }
 
@@ -32,7 +32,9 @@ public:
 
   // Construct a synthetic population and analyze it.
   // The synthetic population is constructed from the unphased population.
-  static bool syntheticInbreeding(std::shared_ptr<const PopulationDB> unphased_ptr, InbreedParamOutput& param_output);
+  static bool syntheticInbreeding( std::shared_ptr<const PopulationDB> unphased_ptr,
+                                   InbreedParamOutput& param_output,
+                                   ThreadPool& thread_pool);
 
 private:
 
@@ -41,8 +43,10 @@ private:
   constexpr static const double MAX_INBREEDING_COEFICIENT = 0.5; // Set the maximum inbreeding coefficient
   constexpr static const double STEP_INBREEDING_COEFICIENT = 0.01; // Set the inbreeding step
 
-  [[nodiscard]] static ResultsMap processSynResults( std::shared_ptr<const PopulationDB> unphased_ptr,
-                                                     const InbreedingParameters& parameters);
+  // Queue the synthetic population inbreeding calculations on the analysis thread pool.
+  [[nodiscard]] static PendingResults queueSynResults( const ContigLocusTableMap& locus_tables,
+                                                       const InbreedingParameters& parameters,
+                                                       ThreadPool& thread_pool);
 
 };
 
@@ -3,7 +3,6 @@
 //
 
 #include "kgl_analysis_interval.h"
-#include "kgl_sequence_complexity.h"
 #include "kgl_variant_factory_vcf_evidence_analysis.h"
 #include "kgl_variant_filter.h"
 
@@ -39,14 +38,14 @@ void kgl::InfoIntervalData::processVariant(const std::shared_ptr<const Variant>&
 
   }
 
-  freq_percentile_.addElement(float_vector.front(), variant_ptr);
+  freq_percentile_.addElement(float_vector.front());
 
   InfoAgeAnalysis age_analysis("AgeInterval");
   age_analysis.processVariant(variant_ptr);
 
-  age_percentile_.addElement(age_analysis.averageCombinedAge(), variant_ptr);
+  age_percentile_.addElement(age_analysis.averageCombinedAge());
 
-  het_hom_percentile_.addElement(age_analysis.heteroHomoRatioAll(), variant_ptr);
+  het_hom_percentile_.addElement(age_analysis.heteroHomoRatioAll());
 
   age_analysis_.addAgeAnalysis(age_analysis);
 
@@ -57,7 +56,7 @@ void kgl::InfoIntervalData::processVariant(const std::shared_ptr<const Variant>&
 double kgl::InfoIntervalData::variantFrequencyPercentile(double percentile) const {
 
 
-  std::optional<std::pair<double, std::shared_ptr<const Variant>>> freq_opt = freq_percentile_.percentile(percentile);
+  std::optional<double> freq_opt = freq_percentile_.percentile(percentile);
 
   if (not freq_opt) {
 
@@ -65,15 +64,14 @@ double kgl::InfoIntervalData::variantFrequencyPercentile(double percentile) cons
 
   }
 
-  return freq_opt.value().first;
+  return freq_opt.value();
 
 }
 
 
 size_t kgl::InfoIntervalData::variantsCountGEQPercent(double percent) const {
 
-  std::shared_ptr<const Variant> dummy_variant;
-  size_t variant_count = freq_percentile_.findGEQCount(percent, dummy_variant);
+  size_t variant_count = freq_percentile_.findGEQCount(percent);
 
   return variant_count;
 
@@ -82,7 +80,7 @@ size_t kgl::InfoIntervalData::variantsCountGEQPercent(double percent) const {
 
 double kgl::InfoIntervalData::variantAgePercentile(double percentile) const {
 
-  std::optional<std::pair<double, std::shared_ptr<const Variant>>> age_opt = age_percentile_.percentile(percentile);
+  std::optional<double> age_opt = age_percentile_.percentile(percentile);
 
   if (not age_opt) {
 
@@ -90,7 +88,7 @@ double kgl::InfoIntervalData::variantAgePercentile(double percentile) const {
 
   }
 
-  return age_opt.value().first;
+  return age_opt.value();
 
 }
 
@@ -98,7 +96,7 @@ double kgl::InfoIntervalData::variantAgePercentile(double percentile) const {
 
 double kgl::InfoIntervalData::variantHetHomPercentile(double percentile) const {
 
-  std::optional<std::pair<double, std::shared_ptr<const Variant>>> het_hom_opt = het_hom_percentile_.percentile(percentile);
+  std::optional<double> het_hom_opt = het_hom_percentile_.percentile(percentile);
 
   if (not het_hom_opt) {
 
@@ -106,7 +104,7 @@ double kgl::InfoIntervalData::variantHetHomPercentile(double percentile) const {
 
   }
 
-  return het_hom_opt.value().first;
+  return het_hom_opt.value();
 
 }
 
@@ -177,6 +175,7 @@ bool kgl::IntervalAnalysis::initializeAnalysis( const std::string& work_director
                                                 const std::shared_ptr<const AnalysisResources>& resource_ptr) {
 
   work_directory_ = work_directory;
+  resource_ptr_ = resource_ptr;
 
   auto genome_resource_vector = resource_ptr->getResources(RuntimeResourceType::GENOME_DATABASE);
   if (genome_resource_vector.size() != 1) {
@@ -222,11 +221,21 @@ bool kgl::IntervalAnalysis::fileReadAnalysis(std::shared_ptr<const DataDB> data_
 
   }
 
+  // The analysis thread pool is shared by all files.
+  ThreadPool& thread_pool = resource_ptr_->threadPool();
+
+  // The reference statistics are only calculated for the first file.
+  if (reference_map_.empty()) {
+
+    setupReferenceStatistics(genome_, thread_pool);
+
+  }
+
   // Setup the interval structure
   setupIntervalStructure(genome_);
 
   // Perform the analysis.
-  bool analysis_result = variantIntervalCount(population);
+  bool analysis_result = variantIntervalCount(population, thread_pool);
 
   // Population specific output name.
   std::string interval_file = Utility::filePath((population->populationId() + "_" + output_file_name_), work_directory_);
@@ -327,14 +336,16 @@ void kgl::IntervalAnalysis::setupIntervalStructure(std::shared_ptr<const GenomeR
 }
 
 
-bool kgl::IntervalAnalysis::variantIntervalCount(std::shared_ptr<const PopulationDB> population_ptr) {
+// The intervals of each contig are split into blocks which are counted in parallel.
+// The intervals are independent, so the results are identical to a sequential count.
+bool kgl::IntervalAnalysis::variantIntervalCount(std::shared_ptr<const PopulationDB> population_ptr, ThreadPool& thread_pool) {
 
    // We are profiling variants against a reference genome. Therefore we need to compress the population of variants
   // into a single genome.
   std::shared_ptr<const GenomeDB> compressed_genome = population_ptr->compressPopulation();
 
-  size_t variant_count{0};
-
+  bool result_flag{true};
+  std::vector<std::future<size_t>> future_vector;
 
   // For contigs in the compressed genome.
   for (auto const& [contig_id, contig_ptr] : compressed_genome->getMap()) {
@@ -343,64 +354,181 @@ bool kgl::IntervalAnalysis::variantIntervalCount(std::shared_ptr<const Populatio
     if (result == interval_map_.end()) {
 
       ExecEnv::log().error("IntervalAnalysis::variantIntervalCount; Cannot find contig: {} mismatch between Reference Genome and Variant Population", contig_id);
-      return false;
+      result_flag = false;
+      break;
 
     }
 
     IntervalVector& interval_vector = result->second;
-    // For all intervals.
-    for (auto& interval_data : interval_vector) {
+    for (size_t begin_index = 0; begin_index < interval_vector.size(); begin_index += INTERVAL_BLOCK_SIZE_) {
+
+      size_t end_index = std::min(begin_index + INTERVAL_BLOCK_SIZE_, interval_vector.size());
+      future_vector.push_back(thread_pool.enqueueTask(&IntervalAnalysis::intervalBlockCount,
+                                                      this,
+                                                      contig_ptr,
+                                                      &interval_vector,
+                                                      begin_index,
+                                                      end_index));
+
+    }
+
+  } // contig
+
+  // Wait for all tasks to complete.
+  size_t variant_count{0};
+  for (auto& future : future_vector) {
+
+    variant_count += future.get();
+
+  }
+
+  ExecEnv::log().info("Analysis: {},  Variants processed: {}", ident(), variant_count);
+
+  return result_flag;
 
-      auto lower_bound = contig_ptr->getMap().lower_bound(interval_data.offset());
-      ContigOffset_t upperbound_offset = interval_data.offset() + interval_data.interval() - 1;
-      auto upper_bound = contig_ptr->getMap().upper_bound(upperbound_offset);
+}
+
+
+size_t kgl::IntervalAnalysis::intervalBlockCount( std::shared_ptr<const ContigDB> contig_ptr,
+                                                  IntervalVector* interval_vector,
+                                                  size_t begin_index,
+                                                  size_t end_index) const {
+
+  size_t variant_count{0};
+
+  // For all intervals in the block.
+  for (size_t index = begin_index; index < end_index; ++index) {
 
-      // For all variant array within the interval.
-      ContigOffset_t previous_offset = interval_data.offset() - 1;
-      for (auto array_ptr = lower_bound; array_ptr != upper_bound; ++array_ptr) {
+    IntervalData& interval_data = (*interval_vector)[index];
 
-        interval_data.emptyIntervalOffset(previous_offset, array_ptr->first); // Variant empty interval calculated from this.
-        interval_data.addVariantCount(array_ptr->second->getVariantArray().size());
-        interval_data.addArrayVariantCount(array_ptr->second->getVariantArray().size());
-        variant_count += array_ptr->second->getVariantArray().size();
-        size_t snp_count{0};
-        size_t transition_count{0};
+    auto lower_bound = contig_ptr->getMap().lower_bound(interval_data.offset());
+    ContigOffset_t upperbound_offset = interval_data.offset() + interval_data.interval() - 1;
+    auto upper_bound = contig_ptr->getMap().upper_bound(upperbound_offset);
 
-        // Count SNP.
-        for (auto const& variant : array_ptr->second->getVariantArray()) {
+    // For all variant array within the interval.
+    ContigOffset_t previous_offset = interval_data.offset() - 1;
+    for (auto array_ptr = lower_bound; array_ptr != upper_bound; ++array_ptr) {
 
-          interval_data.intervalInfoData().processVariant(variant);
+      interval_data.emptyIntervalOffset(previous_offset, array_ptr->first); // Variant empty interval calculated from this.
+      interval_data.addVariantCount(array_ptr->second->getVariantArray().size());
+      interval_data.addArrayVariantCount(array_ptr->second->getVariantArray().size());
+      variant_count += array_ptr->second->getVariantArray().size();
+      size_t snp_count{0};
+      size_t transition_count{0};
 
-          if (variant->isSNP()) {
+      // Count SNP.
+      for (auto const& variant : array_ptr->second->getVariantArray()) {
 
-            ++snp_count;
+        interval_data.intervalInfoData().processVariant(variant);
 
-            if (DNA5::isTransition(variant->alternate().at(0), variant->reference().at(0))) {
+        if (variant->isSNP()) {
 
-              ++transition_count;
+          ++snp_count;
 
-            }
+          if (DNA5::isTransition(variant->alternate().at(0), variant->reference().at(0))) {
+
+            ++transition_count;
 
           }
 
-        } // count.
+        }
 
-        interval_data.addTransitionCount(transition_count);
-        interval_data.addSNPCount(snp_count);
-        previous_offset = array_ptr->first;
+      } // count.
 
-      } // variant array.
+      interval_data.addTransitionCount(transition_count);
+      interval_data.addSNPCount(snp_count);
+      previous_offset = array_ptr->first;
 
-      // The empty interval to the end of the data interval.
-      interval_data.emptyIntervalOffset(previous_offset, upperbound_offset);
+    } // variant array.
 
-    } // interval
+    // The empty interval to the end of the data interval.
+    interval_data.emptyIntervalOffset(previous_offset, upperbound_offset);
 
-  } // contig
+  } // interval
 
-  ExecEnv::log().info("Analysis: {},  Variants processed: {}", ident(), variant_count);
+  return variant_count;
 
-  return true;
+}
+
+
+// The reference symbol, entropy and CpG statistics of each interval, calculated in parallel.
+void kgl::IntervalAnalysis::setupReferenceStatistics(std::shared_ptr<const GenomeReference> genome, ThreadPool& thread_pool) {
+
+  std::vector<std::pair<ContigId_t, std::future<ReferenceVector>>> future_vector;
+
+  for (auto const& [contig_id, contig_ptr] : genome->getMap()) {
+
+    // Matches the interval structure, see setupIntervalStructure().
+    size_t vector_size = (contig_ptr->contigSize() / interval_size_) + 1;
+    for (size_t begin_index = 0; begin_index < vector_size; begin_index += INTERVAL_BLOCK_SIZE_) {
+
+      size_t end_index = std::min(begin_index + INTERVAL_BLOCK_SIZE_, vector_size);
+      future_vector.emplace_back(contig_id, thread_pool.enqueueTask(&IntervalAnalysis::referenceStatistics,
+                                                                    this,
+                                                                    contig_ptr,
+                                                                    begin_index,
+                                                                    end_index));
+
+    }
+
+  }
+
+  // The blocks are appended in interval order.
+  for (auto& [contig_id, future] : future_vector) {
+
+    ReferenceVector block_vector = future.get();
+    ReferenceVector& reference_vector = reference_map_[contig_id];
+    reference_vector.insert(reference_vector.end(), block_vector.begin(), block_vector.end());
+
+  }
+
+  ExecEnv::log().info("Analysis: {}, reference statistics calculated for contigs: {}", ident(), reference_map_.size());
+
+}
+
+
+kgl::IntervalAnalysis::ReferenceVector kgl::IntervalAnalysis::referenceStatistics( std::shared_ptr<const ContigReference> contig_ptr,
+                                                                                   size_t begin_index,
+                                                                                   size_t end_index) const {
+
+  ReferenceVector reference_vector;
+
+  // The full intervals of the block are the non-overlapping windows of the block sequence.
+  ContigSize_t contig_size = contig_ptr->contigSize();
+  ContigOffset_t block_offset = begin_index * interval_size_;
+  ContigOffset_t block_end = std::min<ContigOffset_t>(end_index * interval_size_, contig_size);
+  if (block_offset < block_end) {
+
+    DNA5SequenceLinear block_sequence = contig_ptr->sequence_ptr()->subSequence(block_offset, block_end - block_offset);
+    reference_vector = SequenceComplexity::windowStatistics(block_sequence, interval_size_, interval_size_, COMPLEXITY_KMER_SIZE_);
+    for (auto& complexity : reference_vector) {
+
+      complexity.offset += block_offset;
+
+    }
+
+  }
+
+  // The final (partial) interval of the contig.
+  for (size_t index = begin_index + reference_vector.size(); index < end_index; ++index) {
+
+    ContigOffset_t contig_offset = index * interval_size_;
+    ContigSize_t interval_size = contig_offset < contig_size ? std::min<ContigSize_t>(interval_size_, contig_size - contig_offset) : 0;
+
+    // The final interval is empty if the contig size is a multiple of the interval size.
+    ComplexityStatistics complexity;
+    if (interval_size > 0) {
+
+      DNA5SequenceLinear sequence = contig_ptr->sequence_ptr()->subSequence(contig_offset, interval_size);
+      complexity = SequenceComplexity::sequenceStatistics(sequence, COMPLEXITY_KMER_SIZE_);
+
+    }
+    complexity.offset = contig_offset;
+    reference_vector.push_back(complexity);
+
+  }
+
+  return reference_vector;
 
 }
 
@@ -463,6 +591,8 @@ bool kgl::IntervalAnalysis::writeHeader(std::ostream& output, char delimiter, bo
 //  output << "ZivLempel" << delimiter;
   output << "ShannonEntropy" << delimiter;
   output << "CpG" << delimiter;
+  output << "Distinct_Kmers" << delimiter;
+  output << "Kmer_Entropy" << delimiter;
   output << "G_Variant_impact" << delimiter;
   output << "G_Highest_Freq" << delimiter;
   output << "G_95_Percentile" << delimiter;
@@ -535,6 +665,16 @@ bool kgl::IntervalAnalysis::writeData( std::shared_ptr<const GenomeReference> ge
 
     }
 
+    auto reference_iter = reference_map_.find(contig_id);
+    if (reference_iter == reference_map_.end()) {
+
+      ExecEnv::log().error("IntervalAnalysis::writeData; could not find reference statistics for contig: {}", contig_id);
+      continue; // next contig.
+
+    }
+
+    const ReferenceVector& reference_vector = reference_iter->second;
+
     ExecEnv::log().info("IntervalAnalysis::writeData; processing contig: {}", contig_id);
     ContigOffset_t contig_offset = 0;
     ContigSize_t contig_size = contig_ptr->contigSize();
@@ -559,8 +699,16 @@ bool kgl::IntervalAnalysis::writeData( std::shared_ptr<const GenomeReference> ge
 
       }
 
-      DNA5SequenceLinear sequence = contig_ptr->sequence_ptr()->subSequence(contig_offset, interval_size);
-      if (sequence.length() == 0) {
+      if (count_index >= reference_vector.size()) {
+
+        ExecEnv::log().error("IntervalAnalysis::writeData; no reference statistics for interval: {}, contig: {}", count_index, contig_id);
+        break;
+
+      }
+
+      // Count the symbols, entropy and CpG were calculated in a single pass.
+      const ComplexityStatistics& complexity = reference_vector[count_index];
+      if (complexity.length == 0) {
 
         ExecEnv::log().warn("IntervalAnalysis::writeData; zero sized sequence, offset: {}, size: {}, contig: {} contig size: {}",
                             contig_offset, interval_size, contig_id, contig_ptr->contigSize());
@@ -568,10 +716,10 @@ bool kgl::IntervalAnalysis::writeData( std::shared_ptr<const GenomeReference> ge
 
       }
 
-      if (sequence.length() != interval_size) {
+      if (complexity.length != interval_size or complexity.offset != contig_offset) {
 
         ExecEnv::log().error("IntervalAnalysis::writeData; unexpected sequence size: {} returned from contig: {}, offset: {}, size: {}",
-                             sequence.length(), contig_id, contig_offset, interval_size);
+                             complexity.length, contig_id, contig_offset, interval_size);
         break;
 
       }
@@ -596,18 +744,17 @@ bool kgl::IntervalAnalysis::writeData( std::shared_ptr<const GenomeReference> ge
       output << interval_vector[count_index].maxEmptyInterval().second << delimiter;
       output << interval_vector[count_index].meanEmptyInterval() << delimiter;
 
-      // count the symbols in the sequence
-      const std::vector<std::pair<DNA5::Alphabet, size_t>>& symbol_vector = sequence.countSymbols();
-
-      for (auto const& count : symbol_vector) {
+      for (auto const count : complexity.symbol_counts) {
 
-        output << (static_cast<double>(count.second) * 100.0) / static_cast<double>(sequence.length()) << delimiter;
+        output << (static_cast<double>(count) * 100.0) / static_cast<double>(complexity.length) << delimiter;
 
       }
 
 //      output << SequenceComplexity::complexityLempelZiv(sequence) << delimiter;
-      output << SequenceComplexity::alphabetEntropy<DNA5>(sequence, symbol_vector) << delimiter;
-      output << SequenceComplexity::relativeCpGIslands(sequence) << delimiter;
+      output << complexity.entropy() << delimiter;
+      output << complexity.relativeCpG() << delimiter;
+      output << complexity.distinct_kmers << delimiter;
+      output << complexity.kmer_entropy << delimiter;
       output << interval_vector[count_index].getInfoData().consequenceCount() << delimiter;
       output << interval_vector[count_index].getInfoData().variantFrequencyPercentile(1.0) << delimiter;
       output << interval_vector[count_index].getInfoData().variantFrequencyPercentile(0.95) << delimiter;
@@ -627,6 +774,7 @@ bool kgl::IntervalAnalysis::writeData( std::shared_ptr<const GenomeReference> ge
 
       if (display_sequence) {
 
+        DNA5SequenceLinear sequence = contig_ptr->sequence_ptr()->subSequence(contig_offset, interval_size);
         output << delimiter << sequence.getSequenceAsString() << '\n';
 
       } else {
@@ -11,7 +11,9 @@
 #include "kgl_analysis_virtual.h"
 #include "kgl_analysis_age.h"
 #include "kgl_variant_filter.h"
+#include "kgl_sequence_complexity.h"
 #include "kel_percentile.h"
+#include "kel_thread_pool.h"
 
 #include <array>
 
@@ -48,9 +50,10 @@ private:
 
   OrFilter vep_impact_filter_;
   size_t consequence_count_{0};
-  Percentile<double, std::shared_ptr<const Variant>> freq_percentile_;
-  Percentile<double, std::shared_ptr<const Variant>> age_percentile_;
-  Percentile<double, std::shared_ptr<const Variant>> het_hom_percentile_;
+  // Bounded memory quantile sketches, exact for small intervals.
+  QuantileSketch<double> freq_percentile_;
+  QuantileSketch<double> age_percentile_;
+  QuantileSketch<double> het_hom_percentile_;
   InfoAgeAnalysis age_analysis_;
 
   constexpr static const char* VEP_IMPACT_FIELD_ = "IMPACT";
@@ -173,13 +176,33 @@ private:
   using IntervalMap = std::map<ContigId_t, IntervalVector>;
   IntervalMap interval_map_;
   std::shared_ptr<const GenomeReference> genome_;
+  // Holds the shared analysis thread pool.
+  std::shared_ptr<const AnalysisResources> resource_ptr_;
+  // The reference sequence statistics of each interval are calculated once and re-used for each VCF file.
+  using ReferenceVector = std::vector<ComplexityStatistics>;
+  using ReferenceMap = std::map<ContigId_t, ReferenceVector>;
+  ReferenceMap reference_map_;
 
   constexpr static const char OUTPUT_DELIMITER_ = ',';
   constexpr static const char* OUTPUT_FILE_EXT_ = ".csv";
+  // k-mer size of the interval complexity statistics.
+  constexpr static const size_t COMPLEXITY_KMER_SIZE_ = 6;
+  // The number of contiguous intervals processed by each thread pool task.
+  constexpr static const size_t INTERVAL_BLOCK_SIZE_ = 64;
 
   [[nodiscard]] bool getParameters(const ActiveParameterList& named_parameters);
   void setupIntervalStructure(std::shared_ptr<const GenomeReference> genome);
-  [[nodiscard]] bool variantIntervalCount(std::shared_ptr<const PopulationDB> population_ptr);
+  void setupReferenceStatistics(std::shared_ptr<const GenomeReference> genome, ThreadPool& thread_pool);
+  // Thread pool worker function, the reference statistics of the intervals [begin_index, end_index).
+  [[nodiscard]] ReferenceVector referenceStatistics( std::shared_ptr<const ContigReference> contig_ptr,
+                                                     size_t begin_index,
+                                                     size_t end_index) const;
+  [[nodiscard]] bool variantIntervalCount(std::shared_ptr<const PopulationDB> population_ptr, ThreadPool& thread_pool);
+  // Thread pool worker function, each interval is updated by exactly one task. Returns the variants counted.
+  [[nodiscard]] size_t intervalBlockCount( std::shared_ptr<const ContigDB> contig_ptr,
+                                           IntervalVector* interval_vector,
+                                           size_t begin_index,
+                                           size_t end_index) const;
   [[nodiscard]] bool writeData( std::shared_ptr<const GenomeReference> genome_db, bool display_sequence, std::ostream& output, char delimiter) const;
   [[nodiscard]] bool writeHeader(std::ostream& output, char delimiter, bool display_sequence) const;
   [[nodiscard]] bool writeResults( std::shared_ptr<const GenomeReference> genome_db,
@@ -0,0 +1,203 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_sequence_complexity.h"
+
+#include <cmath>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+double kgl::ComplexityStatistics::entropy() const {
+
+  if (length == 0) {
+
+    ExecEnv::log().error("ComplexityStatistics::entropy; zero sized sequence");
+    return 0.0;
+
+  }
+
+  double entropy = 0.0;
+  for (auto count : symbol_counts) {
+
+    if (count > 0) {
+
+      double ratio = static_cast<double>(count) / static_cast<double>(length);
+      entropy += ratio * std::log(ratio);
+
+    }
+
+  }
+
+  // Adjust for alphabet size
+  return entropy * (-1.0 / std::log(static_cast<double>(symbol_counts.size())));
+
+}
+
+
+double kgl::ComplexityStatistics::relativeCpG() const {
+
+  // Combinatorial theory tells us there is an expected CpG every 32 random nucleotides.
+  return (static_cast<double>(cpg_count) * 32.0) / static_cast<double>(length);
+
+}
+
+
+kgl::ComplexityStatistics kgl::SequenceComplexity::sequenceStatistics(const DNA5SequenceLinear& sequence, size_t kmer_size) {
+
+  WindowState window_state(sequence, kmer_size);
+  window_state.extend(sequence.length());
+
+  return window_state.statistics();
+
+}
+
+
+std::vector<kgl::ComplexityStatistics> kgl::SequenceComplexity::windowStatistics( const DNA5SequenceLinear& sequence,
+                                                                                  ContigSize_t window_size,
+                                                                                  ContigSize_t window_step,
+                                                                                  size_t kmer_size) {
+
+  std::vector<ComplexityStatistics> window_vector;
+
+  if (window_size == 0 or window_step == 0) {
+
+    ExecEnv::log().error("SequenceComplexity::windowStatistics; invalid window size: {} or window step: {}", window_size, window_step);
+    return window_vector;
+
+  }
+
+  if (window_size > sequence.length()) {
+
+    return window_vector;
+
+  }
+
+  window_vector.reserve(((sequence.length() - window_size) / window_step) + 1);
+
+  WindowState window_state(sequence, kmer_size);
+  for (ContigOffset_t offset = 0; offset + window_size <= sequence.length(); offset += window_step) {
+
+    // Non-overlapping windows are calculated from the start of the window.
+    if (window_step >= window_size) {
+
+      window_state.reset(offset);
+
+    }
+
+    window_state.extend(offset + window_size);
+    window_state.shorten(offset);
+    window_vector.push_back(window_state.statistics());
+
+  }
+
+  return window_vector;
+
+}
+
+
+kgl::SequenceComplexity::WindowState::WindowState(const DNA5SequenceLinear& sequence, size_t kmer_size)
+  : sequence_(sequence), encoder_(kmer_size), counter_(encoder_.kmerSize()) {}
+
+
+void kgl::SequenceComplexity::WindowState::reset(ContigOffset_t offset) {
+
+  counter_.clear();
+  leading_kmer_ = KmerEncoder::RollingKmer();
+  trailing_kmer_ = KmerEncoder::RollingKmer();
+  begin_offset_ = offset;
+  end_offset_ = offset;
+  trailing_offset_ = offset;
+  symbol_counts_.fill(0);
+  cpg_count_ = 0;
+
+}
+
+
+bool kgl::SequenceComplexity::WindowState::isCpG(ContigOffset_t offset) const {
+
+  return sequence_.at(offset) == DNA5::Alphabet::C and sequence_.at(offset + 1) == DNA5::Alphabet::G;
+
+}
+
+
+// A k-mer (or CpG) is added when its last symbol enters the window.
+// The leading k-mer rolls across window boundaries, k-mers that begin before the window are not added.
+void kgl::SequenceComplexity::WindowState::extend(ContigOffset_t end_offset) {
+
+  const size_t kmer_size = encoder_.kmerSize();
+  for (; end_offset_ < end_offset; ++end_offset_) {
+
+    auto symbol = sequence_.at(end_offset_);
+    ++symbol_counts_[DNA5::symbolToColumn(symbol)];
+
+    if (end_offset_ > begin_offset_ and isCpG(end_offset_ - 1)) {
+
+      ++cpg_count_;
+
+    }
+
+    if (encoder_.push(leading_kmer_, static_cast<char>(symbol)) and end_offset_ + 1 >= begin_offset_ + kmer_size) {
+
+      counter_.add(leading_kmer_.code);
+
+    }
+
+  }
+
+}
+
+
+// A k-mer (or CpG) is removed when its first symbol leaves the window, if it was added.
+// The trailing k-mer is rolled over the same symbols as the leading k-mer to recover the removed k-mer codes.
+void kgl::SequenceComplexity::WindowState::shorten(ContigOffset_t begin_offset) {
+
+  const size_t kmer_size = encoder_.kmerSize();
+  for (; begin_offset_ < begin_offset; ++begin_offset_) {
+
+    --symbol_counts_[DNA5::symbolToColumn(sequence_.at(begin_offset_))];
+
+    if (begin_offset_ + 1 < end_offset_ and isCpG(begin_offset_)) {
+
+      --cpg_count_;
+
+    }
+
+    if (begin_offset_ + kmer_size <= end_offset_) {
+
+      bool complete_kmer{false};
+      for (; trailing_offset_ < begin_offset_ + kmer_size; ++trailing_offset_) {
+
+        complete_kmer = encoder_.push(trailing_kmer_, static_cast<char>(sequence_.at(trailing_offset_)));
+
+      }
+
+      if (complete_kmer) {
+
+        counter_.remove(trailing_kmer_.code);
+
+      }
+
+    }
+
+  }
+
+}
+
+
+kgl::ComplexityStatistics kgl::SequenceComplexity::WindowState::statistics() const {
+
+  ComplexityStatistics statistics;
+  statistics.offset = begin_offset_;
+  statistics.length = end_offset_ - begin_offset_;
+  statistics.symbol_counts = symbol_counts_;
+  statistics.cpg_count = cpg_count_;
+  statistics.distinct_kmers = counter_.distinctKmers();
+  statistics.kmer_entropy = counter_.kmerEntropy();
+
+  return statistics;
+
+}
+
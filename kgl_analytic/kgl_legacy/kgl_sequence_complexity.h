@@ -6,10 +6,30 @@
 #define KGL_SEQUENCE_COMPLEXITY_H
 
 #include "kgl_sequence_base.h"
+#include "kgl_sequence_kmer.h"
+
+#include <array>
 
 namespace kellerberrin::genome {   //  organization level namespace
 
 
+// Complexity statistics of a nucleotide sequence (or sequence window) calculated in a single pass.
+struct ComplexityStatistics {
+
+  ContigOffset_t offset{0};
+  ContigSize_t length{0};
+  std::array<size_t, DNA5::NUCLEOTIDE_COLUMNS> symbol_counts{};  // Indexed by DNA5::symbolToColumn().
+  size_t cpg_count{0};
+  size_t distinct_kmers{0};
+  double kmer_entropy{0.0};
+
+  // Identical to SequenceComplexity::alphabetEntropy() and SequenceComplexity::relativeCpGIslands().
+  [[nodiscard]] double entropy() const;
+  [[nodiscard]] double relativeCpG() const;
+
+};
+
+
 class SequenceComplexity {
 
 public:
@@ -28,12 +48,51 @@ public:
   [[nodiscard]] static double alphabetEntropy( const AlphabetSequence<Alphabet>& sequence,
                                                const std::vector<std::pair<typename Alphabet::Alphabet, size_t>>& symbol_vector);
   // Different for different sequence lengths.
+  // Lempel-Ziv complexity compares against all earlier sub-strings and cannot be accumulated in a rolling pass.
   template<typename Alphabet>
   [[nodiscard]] static size_t complexityLempelZiv(const AlphabetSequence<Alphabet>& sequence);
-  // Calculate Nucleotide content.
+
+  // Symbol counts, entropy, CpG and k-mer statistics in a single pass over the sequence.
+  [[nodiscard]] static ComplexityStatistics sequenceStatistics(const DNA5SequenceLinear& sequence, size_t kmer_size);
+  // The statistics of each window [offset, offset + window_size) for offsets at window_step intervals.
+  // Overlapping windows are updated incrementally by adding the leading symbols and removing the trailing symbols.
+  [[nodiscard]] static std::vector<ComplexityStatistics> windowStatistics( const DNA5SequenceLinear& sequence,
+                                                                          ContigSize_t window_size,
+                                                                          ContigSize_t window_step,
+                                                                          size_t kmer_size);
 
 private:
 
+  // Incremental window state, the window is extended by extend() and shortened by shorten().
+  class WindowState {
+
+  public:
+
+    WindowState(const DNA5SequenceLinear& sequence, size_t kmer_size);
+    ~WindowState() = default;
+
+    void reset(ContigOffset_t offset);
+    void extend(ContigOffset_t end_offset);
+    void shorten(ContigOffset_t begin_offset);
+    [[nodiscard]] ComplexityStatistics statistics() const;
+
+  private:
+
+    const DNA5SequenceLinear& sequence_;
+    KmerEncoder encoder_;
+    KmerCounter counter_;
+    KmerEncoder::RollingKmer leading_kmer_;
+    KmerEncoder::RollingKmer trailing_kmer_;
+    ContigOffset_t begin_offset_{0};
+    ContigOffset_t end_offset_{0};
+    ContigOffset_t trailing_offset_{0};  // The next symbol pushed to the trailing k-mer.
+    std::array<size_t, DNA5::NUCLEOTIDE_COLUMNS> symbol_counts_{};
+    size_t cpg_count_{0};
+
+    [[nodiscard]] bool isCpG(ContigOffset_t offset) const;
+
+  };
+
 };
 
 inline double SequenceComplexity::relativeCpGIslands(const DNA5SequenceCoding& sequence) {
@@ -93,45 +152,39 @@ double SequenceComplexity::alphabetEntropy( const AlphabetSequence<Alphabet>& se
 
 
 
+// Nucleotide sequences are counted using the rolling 2 bit encoder, other alphabets are searched directly.
+// All k-mer positions are counted, including the final position of the sequence.
 template<typename Alphabet>
 size_t SequenceComplexity::kmerCount(const AlphabetSequence<Alphabet>& sequence, const AlphabetSequence<Alphabet>& kmer) {
 
-  std::map<std::string, size_t> word_map;
-
-  std::string sequence_string = sequence.getSequenceAsString();
-
-  std::string kmer_string = kmer.getSequenceAsString();
+  if (kmer.length() == 0 or kmer.length() > sequence.length()) {
 
-  size_t kmer_size = kmer.length();
-
-  std::pair<std::string, size_t> insert_kmer(kmer_string, 0);
-
-  auto result = word_map.insert(insert_kmer);
-
-  if (not result.second) {
-
-    ExecEnv::log().error("SequenceComplexity::kmerCount; unable to insert kmer: {} for sequence: {}", kmer_string, sequence_string);
     return 0;
 
   }
 
-  for (size_t i = 0; i < sequence.length(); i++) {
+  if constexpr (std::is_same_v<Alphabet, DNA5> or std::is_same_v<Alphabet, CodingDNA5>) {
 
-    if (i + kmer_size >= sequence.length()) break;
+    if (kmer.length() <= KmerEncoder::MAX_KMER_SIZE) {
 
-    std::string word = sequence_string.substr(i, kmer_size);
+      // k-mers containing N are not encoded and are searched directly.
+      KmerEncoder encoder(kmer.length());
+      auto kmer_code_opt = encoder.encode(kmer.getSequenceAsString());
+      if (kmer_code_opt) {
 
-    auto result = word_map.find(word);
+        const KmerCode_t kmer_code = kmer_code_opt.value();
+        size_t count{0};
+        encoder.scan(sequence, [kmer_code, &count](ContigOffset_t, KmerCode_t code) { if (code == kmer_code) ++count; });
 
-    if (result != word_map.end()) {
+        return count;
 
-      ++(result->second);
+      }
 
     }
 
   }
 
-  return word_map.begin()->second;
+  return sequence.findAll(kmer).size();
 
 }
 
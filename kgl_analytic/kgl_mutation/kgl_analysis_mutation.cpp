@@ -183,7 +183,7 @@ bool kgl::MutationAnalysis::iterationAnalysis() {
                                     unphased_population_ptr_,
                                     clinvar_population_ptr_,
                                     genome_aux_ptr_,
-                                    sorted_variants_ptr->ensemblMap());
+                                    sorted_variants_ptr->ensemblIndex());
     // Add the sorted variants to the gene allele anlysis.
     gene_allele_.addSortedVariants(sorted_variants_ptr);
 
@@ -67,7 +67,7 @@ private:
   std::shared_ptr<const EnsemblHGNCResource> ensembl_nomenclature_ptr_;
 
   // Results of the analysis. Type of gene membership is defined here.
-  GenomeMutation gene_mutation_{VariantGeneMembership::BY_ENSEMBL};
+  GenomeMutation gene_mutation_{VariantGeneMembership::BY_ENSEMBL, VariantSweep::GENOME_MAJOR};
   // By Span is all variants with in intron+exon span of the gene
   // By Ensembl looks up the variants based on the vep ensembl code.
   // By Exon uses the gene exon addresses to find gene variants - warning assumes the first transcript.
@@ -12,6 +12,7 @@
 
 #include <fstream>
 #include <memory_resource>
+#include <set>
 
 
 namespace kgl = kellerberrin::genome;
@@ -65,6 +66,8 @@ bool kgl::GenomeMutation::genomeAnalysis( const std::vector<std::string>& target
                                                                                                              kol::AnnotationGeneName::SYMBOLIC_GENE_ID));
 
   gene_vector_.clear();
+  // The genome ethnicity lookup is created once and shared by all the gene statistics.
+  ethnic_index_ = std::make_shared<const GenomeEthnicIndex>(*genome_aux_data);
   ExecEnv::log().info("Creating Ontology Cache ...");
 
   OntologyCache ontology_cache(target_genes, term_annotation_ptr, ontology_db_ptr->goGraph());
@@ -103,10 +106,10 @@ bool kgl::GenomeMutation::genomeAnalysis( const std::vector<std::string>& target
       gene_characteristic.geneDefinition(gene_ptr, genome_ptr->genomeId(), name, hgnc_id, ensembl_id, gaf_id);
       GeneMutation mutation;
       mutation.gene_characteristic = gene_characteristic;
-      mutation.clinvar.updateEthnicity().updatePopulations(genome_aux_data);
-      mutation.gene_variants.updateLofEthnicity().updatePopulations(genome_aux_data);
-      mutation.gene_variants.updateHighEthnicity().updatePopulations(genome_aux_data);
-      mutation.gene_variants.updateModerateEthnicity().updatePopulations(genome_aux_data);
+      mutation.clinvar.updateEthnicity().updatePopulations(ethnic_index_);
+      mutation.gene_variants.updateLofEthnicity().updatePopulations(ethnic_index_);
+      mutation.gene_variants.updateHighEthnicity().updatePopulations(ethnic_index_);
+      mutation.gene_variants.updateModerateEthnicity().updatePopulations(ethnic_index_);
       mutation.ontology.processOntologyStats(mutation.gene_characteristic.geneId(), ontology_cache);
       gene_vector_.push_back(mutation);
 
@@ -146,13 +149,18 @@ bool kgl::GenomeMutation::variantAnalysis(const std::shared_ptr<const Population
                                           const std::shared_ptr<const PopulationDB>& unphased_population_ptr,
                                           const std::shared_ptr<const PopulationDB>& clinvar_population_ptr,
                                           const std::shared_ptr<const HsGenomeAux>& genome_aux_data,
-                                          const std::shared_ptr<const EnsemblIndexMap>& ensembl_index_map_ptr) {
+                                          const std::shared_ptr<const EnsemblHashIndex>& ensembl_index_ptr) {
 
   // Count the ethnic samples in the populations.
-  ethnic_statistics_.updatePopulations(genome_aux_data);
+  if (not ethnic_index_) {
+
+    ethnic_index_ = std::make_shared<const GenomeEthnicIndex>(*genome_aux_data);
+
+  }
+  ethnic_statistics_.updatePopulations(ethnic_index_);
   for (auto const& [genome_id, genome_ptr] : population_ptr->getMap()) {
 
-    ethnic_statistics_.pedAnalysis(genome_id, 1, genome_aux_data);
+    ethnic_statistics_.pedAnalysis(genome_id, 1);
 
   }
   if (not ethnic_statistics_.auditTotals()) {
@@ -161,12 +169,50 @@ bool kgl::GenomeMutation::variantAnalysis(const std::shared_ptr<const Population
 
   }
 
+  // The clinvar index is shared by all genes.
+  if (clinvar_population_ptr != clinvar_population_ptr_) {
+
+    clinvar_population_ptr_ = clinvar_population_ptr;
+    clinvar_index_ = std::make_shared<const ClinvarIndex>(clinvar_population_ptr);
+    for (auto& gene_mutation : gene_vector_) {
+
+      gene_mutation.clinvar.setClinvarIndex(clinvar_index_);
+
+    }
+
+  }
+
+  ExecEnv::log().info("Unphased variants sorted by Ensembl Gene code: {}, Total Unphased Variants: {}",
+                      ensembl_index_ptr->size(), unphased_population_ptr->variantCount());
+
+  if (variant_sweep_ == VariantSweep::GENOME_MAJOR) {
+
+    genomeMajorAnalysis(population_ptr, unphased_population_ptr, ensembl_index_ptr);
+
+  } else {
+
+    geneMajorAnalysis(population_ptr, unphased_population_ptr, ensembl_index_ptr);
+
+  }
+
+  ExecEnv::log().info("Gene variant Analysis completes, gene count: {}, total gene variants found: {}",
+                      gene_vector_.size(), static_cast<size_t>(gene_variant_count_));
+  ExecEnv::log().info("Gene variant Analysis statistics, ensembl candidate variants: {}, genome variants checked: {}, genome variants found: {}",
+                      static_cast<size_t>(ensembl_variant_count_), static_cast<size_t>(var_checked_count_), static_cast<size_t>(var_found_count_));
+
+  return true;
+
+}
+
+
+void kgl::GenomeMutation::geneMajorAnalysis( const std::shared_ptr<const PopulationDB>& population_ptr,
+                                             const std::shared_ptr<const PopulationDB>& unphased_population_ptr,
+                                             const std::shared_ptr<const EnsemblHashIndex>& ensembl_index_ptr) {
+
   ThreadPool thread_pool(ThreadPool::defaultThreads());
   // A vector for futures.
   std::vector<std::future<GeneMutation>> future_vector;
 
-  ExecEnv::log().info("Unphased variants sorted by Ensembl Gene code: {}, Total Unphased Variants: {}",
-                      ensembl_index_map_ptr->size(), unphased_population_ptr->variantCount());
   // Queue a thread for each gene.
   for (auto& gene_mutation : gene_vector_) {
 
@@ -174,9 +220,7 @@ bool kgl::GenomeMutation::variantAnalysis(const std::shared_ptr<const Population
                                                                this,
                                                                population_ptr,
                                                                unphased_population_ptr,
-                                                               clinvar_population_ptr,
-                                                               genome_aux_data,
-                                                               ensembl_index_map_ptr,
+                                                               ensembl_index_ptr,
                                                                gene_mutation);
     future_vector.push_back(std::move(future));
 
@@ -195,25 +239,16 @@ bool kgl::GenomeMutation::variantAnalysis(const std::shared_ptr<const Population
   // todo: This logic is inefficient, the entire gene vector is copied for each VCF file (24 times). Re-design and Re-code.
   gene_vector_ = std::move(gene_vector);
 
-  ExecEnv::log().info("Gene variant Analysis completes, gene count: {}, total gene variants found: {}",
-                      gene_vector_.size(), static_cast<size_t>(gene_variant_count_));
-  ExecEnv::log().info("Gene variant Analysis statistics, ensembl candidate variants: {}, genome variants checked: {}, genome variants found: {}",
-                      static_cast<size_t>(ensembl_variant_count_), static_cast<size_t>(var_checked_count_), static_cast<size_t>(var_found_count_));
-
-  return true;
-
 }
 
 
 kgl::GeneMutation kgl::GenomeMutation::geneSpanAnalysis( const std::shared_ptr<const PopulationDB>& population_ptr,
                                                          const std::shared_ptr<const PopulationDB>& unphased_population_ptr,
-                                                         const std::shared_ptr<const PopulationDB>& clinvar_population_ptr,
-                                                         const std::shared_ptr<const HsGenomeAux>& genome_aux_data,
-                                                         const std::shared_ptr<const EnsemblIndexMap>& ensembl_index_map_ptr,
+                                                         const std::shared_ptr<const EnsemblHashIndex>& ensembl_index_ptr,
                                                          GeneMutation gene_mutation) {
 
   bool contig_data{false};
-  EnsemblHashMap ensembl_hash_map;
+  std::shared_ptr<const EnsemblHashMap> ensembl_hash_map;
   ContigOffset_t lower_bound{0};
   ContigOffset_t upper_bound{0};
 
@@ -225,45 +260,49 @@ kgl::GeneMutation kgl::GenomeMutation::geneSpanAnalysis( const std::shared_ptr<c
 
       contig_data = true;
       std::shared_ptr<const ContigDB> all_contig_ptr = contig_opt.value();
-      if (ensembl_hash_map.empty() and gene_membership_ == VariantGeneMembership::BY_ENSEMBL) {
+      // The gene Ensembl variants are the same for all genomes.
+      if (not ensembl_hash_map and gene_membership_ == VariantGeneMembership::BY_ENSEMBL) {
 
-        getGeneEnsemblHashMap( *ensembl_index_map_ptr,
-                               gene_mutation.gene_characteristic,
-                               ensembl_hash_map,
-                               lower_bound,
-                               upper_bound);
+        ensembl_hash_map = getGeneEnsemblHashMap( *ensembl_index_ptr,
+                                                  gene_mutation.gene_characteristic,
+                                                  lower_bound,
+                                                  upper_bound);
 
       }
 
       if (not all_contig_ptr->getMap().empty()) {
 
         // Which method gene membership of variants is determined.
-        std::shared_ptr<const ContigDB> gene_variant_ptr;
+        // The Ensembl variants are a new contig, this pointer keeps it alive while it is viewed.
+        std::shared_ptr<const ContigDB> ensembl_contig_ptr;
+        ContigRegionView gene_variant_view = all_contig_ptr->regionView(0, 0);
         switch(gene_membership_) {
 
           case VariantGeneMembership::BY_SPAN:
-            gene_variant_ptr = getGeneSpan(all_contig_ptr, gene_mutation.gene_characteristic);
+            gene_variant_view = getGeneSpan(*all_contig_ptr, gene_mutation.gene_characteristic);
             break;
 
           case VariantGeneMembership::BY_EXON:
-            gene_variant_ptr = getGeneExon(all_contig_ptr, gene_mutation.gene_characteristic);
+            gene_variant_view = getGeneExon(*all_contig_ptr, gene_mutation.gene_characteristic);
             break;
 
           default:
           case VariantGeneMembership::BY_ENSEMBL: {
 
-            auto contig_ptr = all_contig_ptr->subset(lower_bound, upper_bound);
-            gene_variant_ptr = getGeneEnsemblAlt(contig_ptr, ensembl_hash_map, gene_mutation.gene_characteristic);
+            // The Ensembl variant bounds are inclusive.
+            auto contig_view = all_contig_ptr->regionView(lower_bound, upper_bound + 1);
+            ensembl_contig_ptr = getGeneEnsemblAlt(contig_view, *ensembl_hash_map, gene_mutation.gene_characteristic);
+            gene_variant_view = ensembl_contig_ptr->regionView();
 
           }
             break;
 
         }
 
-        gene_variant_count_ += gene_variant_ptr->variantCount();
+        gene_variant_count_ += gene_variant_view.variantCount();
 
-        gene_mutation.clinvar.processClinvar( genome_id, gene_contig_id, clinvar_population_ptr, gene_variant_ptr, genome_aux_data);
-        gene_mutation.gene_variants.processVariantStats(genome_id, gene_variant_ptr, unphased_population_ptr, genome_aux_data);
+        gene_mutation.clinvar.processClinvar( genome_id, gene_contig_id, gene_variant_view);
+        gene_mutation.gene_variants.processVariantStats(genome_id, gene_variant_view, unphased_population_ptr);
 
       } // contig not empty
 
@@ -272,13 +311,24 @@ kgl::GeneMutation kgl::GenomeMutation::geneSpanAnalysis( const std::shared_ptr<c
   } // for genome
 
   // Generate aggregate variant statistics for each gene.
+  summaryStatistics(population_ptr, contig_data, gene_mutation);
+
+  return gene_mutation;
+
+}
+
+
+void kgl::GenomeMutation::summaryStatistics( const std::shared_ptr<const PopulationDB>& population_ptr,
+                                             bool contig_data,
+                                             GeneMutation& gene_mutation) const {
+
   if (contig_data) {
 
     if (not gene_mutation.gene_variants.processSummaryStatistics( population_ptr,
                                                                   ethnic_statistics_,
                                                                   gene_mutation.gene_characteristic.geneId())) {
 
-      ExecEnv::log().warn("GenomeMutation::geneSpanAnalysis; problem with processSummaryStatistics, gene: {}",
+      ExecEnv::log().warn("GenomeMutation::summaryStatistics; problem with processSummaryStatistics, gene: {}",
                           gene_mutation.gene_characteristic.geneId());
 
     }
@@ -290,46 +340,339 @@ kgl::GeneMutation kgl::GenomeMutation::geneSpanAnalysis( const std::shared_ptr<c
 
   }
 
-  return gene_mutation;
+}
+
+
+// The genomes are partitioned into contiguous blocks, each block is swept by a thread into thread local gene statistics.
+// The block statistics are then merged in genome order, so the result is the same as the gene major analysis.
+void kgl::GenomeMutation::genomeMajorAnalysis( const std::shared_ptr<const PopulationDB>& population_ptr,
+                                               const std::shared_ptr<const PopulationDB>& unphased_population_ptr,
+                                               const std::shared_ptr<const EnsemblHashIndex>& ensembl_index_ptr) {
+
+  std::shared_ptr<const SweepContigMap> sweep_contigs = sweepContigs(population_ptr, ensembl_index_ptr);
+
+  ThreadPool thread_pool(ThreadPool::defaultThreads());
+  const size_t genome_count = population_ptr->getMap().size();
+  const size_t block_count = std::max<size_t>(1, std::min(thread_pool.threadCount(), genome_count));
+  const size_t block_size = std::max<size_t>(1, (genome_count + block_count - 1) / block_count);
+
+  std::vector<std::future<SweepBuffer>> block_futures;
+  std::vector<std::shared_ptr<const GenomeDB>> genome_block;
+  for (auto const& [genome_id, genome_ptr] : population_ptr->getMap()) {
+
+    genome_block.push_back(genome_ptr);
+    if (genome_block.size() == block_size) {
+
+      block_futures.push_back(thread_pool.enqueueTask(&GenomeMutation::sweepGenomes,
+                                                      this,
+                                                      sweep_contigs,
+                                                      genome_block,
+                                                      unphased_population_ptr));
+      genome_block.clear();
+
+    }
+
+  }
+
+  if (not genome_block.empty()) {
+
+    block_futures.push_back(thread_pool.enqueueTask(&GenomeMutation::sweepGenomes,
+                                                    this,
+                                                    sweep_contigs,
+                                                    genome_block,
+                                                    unphased_population_ptr));
+
+  }
+
+  std::vector<SweepBuffer> block_buffers;
+  block_buffers.reserve(block_futures.size());
+  for (auto& future : block_futures) {
+
+    block_buffers.push_back(future.get());
+
+  }
+
+  // Each gene is merged and summarized by one thread.
+  const size_t gene_block_size = std::max<size_t>(1, (gene_vector_.size() + thread_pool.threadCount() - 1) / thread_pool.threadCount());
+  std::vector<std::future<void>> merge_futures;
+  for (size_t gene_begin = 0; gene_begin < gene_vector_.size(); gene_begin += gene_block_size) {
+
+    const size_t gene_end = std::min(gene_begin + gene_block_size, gene_vector_.size());
+    merge_futures.push_back(thread_pool.enqueueTask(&GenomeMutation::mergeSweepGenes,
+                                                    this,
+                                                    &block_buffers,
+                                                    population_ptr,
+                                                    gene_begin,
+                                                    gene_end));
+
+  }
+
+  for (auto& future : merge_futures) {
+
+    future.get();
+
+  }
 
 }
 
 
-// Gets variants over the whole gene span.
-std::shared_ptr<const kgl::ContigDB> kgl::GenomeMutation::getGeneSpan(const std::shared_ptr<const ContigDB>& contig_ptr,
-                                                                      const GeneCharacteristic& gene_char) {
+// Only genes on contigs present in the population are swept.
+std::shared_ptr<const kgl::GenomeMutation::SweepContigMap>
+kgl::GenomeMutation::sweepContigs( const std::shared_ptr<const PopulationDB>& population_ptr,
+                                   const std::shared_ptr<const EnsemblHashIndex>& ensembl_index_ptr) {
 
-  auto subset_contig = contig_ptr->subset(gene_char.geneBegin(), gene_char.geneEnd());
+  std::set<ContigId_t> population_contigs;
+  for (auto const& [genome_id, genome_ptr] : population_ptr->getMap()) {
+
+    for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
+
+      population_contigs.insert(contig_id);
+
+    }
+
+  }
+
+  std::shared_ptr<SweepContigMap> sweep_contigs(std::make_shared<SweepContigMap>());
+  for (size_t gene_index = 0; gene_index < gene_vector_.size(); ++gene_index) {
+
+    const GeneCharacteristic& gene_char = gene_vector_[gene_index].gene_characteristic;
+    if (not population_contigs.contains(gene_char.contigId())) {
+
+      continue;
+
+    }
+
+    SweepGene sweep_gene{gene_index, gene_char.geneBegin(), gene_char.geneEnd(), nullptr};
+    if (gene_membership_ == VariantGeneMembership::BY_ENSEMBL) {
 
-  return subset_contig;
+      // The Ensembl variant bounds are inclusive.
+      ContigOffset_t lower_bound{0};
+      ContigOffset_t upper_bound{0};
+      sweep_gene.ensembl_hash_map = getGeneEnsemblHashMap(*ensembl_index_ptr, gene_char, lower_bound, upper_bound);
+      sweep_gene.begin = lower_bound;
+      sweep_gene.end = upper_bound + 1;
+
+    }
+
+    (*sweep_contigs)[gene_char.contigId()].genes.push_back(std::move(sweep_gene));
+
+  }
+
+  for (auto& [contig_id, sweep_contig] : *sweep_contigs) {
+
+    for (size_t index = 0; index < sweep_contig.genes.size(); ++index) {
+
+      const SweepGene& sweep_gene = sweep_contig.genes[index];
+      sweep_contig.gene_tree.insert(sweep_gene.begin, sweep_gene.end, index);
+
+    }
+    sweep_contig.gene_tree.index();
+
+  }
+
+  return sweep_contigs;
+
+}
+
+
+kgl::GenomeMutation::SweepBuffer
+kgl::GenomeMutation::sweepGenomes( const std::shared_ptr<const SweepContigMap>& sweep_contigs,
+                                   const std::vector<std::shared_ptr<const GenomeDB>>& genome_block,
+                                   const std::shared_ptr<const PopulationDB>& unphased_population_ptr) {
+
+  SweepBuffer sweep_buffer(gene_vector_.size());
+  std::vector<OffsetDBMap::const_iterator> begin_iterators;
+  std::vector<OffsetDBMap::const_iterator> end_iterators;
+  std::vector<ContigOffset_t> offset_vector;
+  size_t gene_variant_count{0};
+
+  for (auto const& genome_ptr : genome_block) {
+
+    for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
+
+      auto result = sweep_contigs->find(contig_id);
+      if (result == sweep_contigs->end()) {
+
+        continue;
+
+      }
+
+      auto const& [sweep_contig_id, sweep_contig] = *result;
+      for (auto const& sweep_gene : sweep_contig.genes) {
+
+        sweepStatistics(sweep_buffer, sweep_gene.gene_index).contig_data = true;
+
+      }
+
+      const OffsetDBMap& offset_map = contig_ptr->getMap();
+      if (offset_map.empty()) {
+
+        continue;
+
+      }
+
+      // A single stabbing pass of the sorted variant offsets against the gene interval tree.
+      // The variants of each gene are contiguous in the offset map, the first and last stabbed offsets give the gene region.
+      const std::vector<SweepGene>& genes = sweep_contig.genes;
+      if (gene_membership_ != VariantGeneMembership::BY_EXON) {
+
+        begin_iterators.assign(genes.size(), offset_map.end());
+        end_iterators.assign(genes.size(), offset_map.end());
+
+        offset_vector.clear();
+        for (auto const& [offset, offset_ptr] : offset_map) {
+
+          offset_vector.push_back(offset);
+
+        }
+
+        auto offset_iter = offset_map.begin();
+        size_t iter_index{0};
+        sweep_contig.gene_tree.stabbing(offset_vector, [&](size_t offset_index, size_t gene_index) {
+
+          // Offset indexes are visited in ascending order.
+          while (iter_index < offset_index) {
+
+            ++offset_iter;
+            ++iter_index;
+
+          }
+
+          if (begin_iterators[gene_index] == offset_map.end()) {
+
+            begin_iterators[gene_index] = offset_iter;
+
+          }
+          end_iterators[gene_index] = std::next(offset_iter);
+
+        });
+
+      }
+
+      for (size_t index = 0; index < genes.size(); ++index) {
+
+        const SweepGene& sweep_gene = genes[index];
+        const GeneCharacteristic& gene_char = gene_vector_[sweep_gene.gene_index].gene_characteristic;
+
+        // The Ensembl variants are a new contig, this pointer keeps it alive while it is viewed.
+        std::shared_ptr<const ContigDB> ensembl_contig_ptr;
+        ContigRegionView gene_variant_view(*contig_ptr, {});
+        if (gene_membership_ == VariantGeneMembership::BY_EXON) {
+
+          gene_variant_view = getGeneExon(*contig_ptr, gene_char);
+
+        } else if (begin_iterators[index] != offset_map.end()) {
+
+          gene_variant_view = ContigRegionView(*contig_ptr, {{begin_iterators[index], end_iterators[index]}});
+
+        }
+
+        if (gene_membership_ == VariantGeneMembership::BY_ENSEMBL) {
+
+          ensembl_contig_ptr = getGeneEnsemblAlt(gene_variant_view, *sweep_gene.ensembl_hash_map, gene_char);
+          gene_variant_view = ensembl_contig_ptr->regionView();
+
+        }
+
+        gene_variant_count += gene_variant_view.variantCount();
+
+        SweepStatistics& statistics = sweepStatistics(sweep_buffer, sweep_gene.gene_index);
+        statistics.clinvar.processClinvar( genome_ptr->genomeId(), contig_id, gene_variant_view);
+        statistics.gene_variants.processVariantStats(genome_ptr->genomeId(), gene_variant_view, unphased_population_ptr);
+
+      } // for genes
+
+    } // for contigs
+
+  } // for genomes
+
+  gene_variant_count_ += gene_variant_count;
+
+  return sweep_buffer;
+
+}
+
+
+// The thread local statistics start as a copy of the gene statistics with the per genome counts zeroed.
+kgl::GenomeMutation::SweepStatistics& kgl::GenomeMutation::sweepStatistics(SweepBuffer& sweep_buffer, size_t gene_index) const {
+
+  std::unique_ptr<SweepStatistics>& statistics_ptr = sweep_buffer[gene_index];
+  if (not statistics_ptr) {
+
+    statistics_ptr = std::make_unique<SweepStatistics>();
+    statistics_ptr->gene_variants = gene_vector_[gene_index].gene_variants;
+    statistics_ptr->gene_variants.clearStatistics();
+    statistics_ptr->clinvar = gene_vector_[gene_index].clinvar;
+    statistics_ptr->clinvar.clearStatistics();
+
+  }
+
+  return *statistics_ptr;
+
+}
+
+
+void kgl::GenomeMutation::mergeSweepGenes( const std::vector<SweepBuffer>* block_buffers,
+                                           const std::shared_ptr<const PopulationDB>& population_ptr,
+                                           size_t gene_begin,
+                                           size_t gene_end) {
+
+  for (size_t gene_index = gene_begin; gene_index < gene_end; ++gene_index) {
+
+    GeneMutation& gene_mutation = gene_vector_[gene_index];
+    bool contig_data{false};
+    for (auto const& block_buffer : *block_buffers) {
+
+      auto const& statistics_ptr = block_buffer[gene_index];
+      if (statistics_ptr) {
+
+        contig_data = contig_data or statistics_ptr->contig_data;
+        gene_mutation.gene_variants.merge(statistics_ptr->gene_variants);
+        gene_mutation.clinvar.merge(statistics_ptr->clinvar);
+
+      }
+
+    }
+
+    summaryStatistics(population_ptr, contig_data, gene_mutation);
+
+  }
+
+}
+
+
+// Gets variants over the whole gene span [begin, end).
+kgl::ContigRegionView kgl::GenomeMutation::getGeneSpan(const ContigDB& contig, const GeneCharacteristic& gene_char) {
+
+  return contig.regionView(gene_char.geneBegin(), gene_char.geneEnd());
 
 }
 
 // Get variants only occurring within exons for all mRNA sequences.
-std::shared_ptr<const kgl::ContigDB> kgl::GenomeMutation::getGeneExon(const std::shared_ptr<const ContigDB>& contig_ptr,
-                                                                      const GeneCharacteristic& gene_char) {
+// Exons shared by alternative mRNA sequences are viewed once.
+kgl::ContigRegionView kgl::GenomeMutation::getGeneExon(const ContigDB& contig, const GeneCharacteristic& gene_char) {
 
-  std::shared_ptr<ContigDB> gene_contig(std::make_shared<ContigDB>(contig_ptr->contigId()));
+  std::vector<ContigRegion> exon_regions;
   std::shared_ptr<const CodingSequenceArray> coding_sequence_array = GeneFeature::getCodingSequences(gene_char.genePtr());
 
   for (auto const& [sequence_id, sequence_ptr] : coding_sequence_array->getMap()) {
 
     for (const auto& [cds_id, cds_ptr] : sequence_ptr->getSortedCDS()) {
 
-      gene_contig->merge(contig_ptr->subset(cds_ptr->sequence().begin(), cds_ptr->sequence().end()));
+      exon_regions.emplace_back(cds_ptr->sequence().begin(), cds_ptr->sequence().end());
 
     }
 
   }
 
-  return gene_contig;
+  return contig.regionView(std::move(exon_regions));
 
 }
 
 
 // Get variants matching the ensembl.
 std::shared_ptr<const kgl::ContigDB> kgl::GenomeMutation::getGeneEnsembl( const std::shared_ptr<const ContigDB>& contig_ptr,
-                                                                          const EnsemblIndexMap& ensembl_index_map,
+                                                                          const EnsemblHashIndex& ensembl_index,
                                                                           const GeneCharacteristic& gene_char) {
 
   std::shared_ptr<ContigDB> gene_contig(std::make_shared<ContigDB>(gene_char.contigId()));
@@ -342,12 +685,7 @@ std::shared_ptr<const kgl::ContigDB> kgl::GenomeMutation::getGeneEnsembl( const
 
   for (auto const& ensembl_id : gene_char.ensemblIds()) {
 
-    auto lower_iterator = ensembl_index_map.lower_bound(ensembl_id);
-    auto const upper_iterator = ensembl_index_map.upper_bound(ensembl_id);
-
-    while(lower_iterator != upper_iterator) {
-
-      auto const& [ensembl_id, variant_ptr] = *lower_iterator;
+    for (auto const& variant_ptr : ensembl_index.find(ensembl_id)) {
 
       auto offset_opt = contig_ptr->findOffsetArray(variant_ptr->offset());
       if (offset_opt) {
@@ -372,8 +710,6 @@ std::shared_ptr<const kgl::ContigDB> kgl::GenomeMutation::getGeneEnsembl( const
 
       }
 
-      ++lower_iterator;
-
     }
 
   }
@@ -385,30 +721,18 @@ std::shared_ptr<const kgl::ContigDB> kgl::GenomeMutation::getGeneEnsembl( const
 
 
 // Set up Ensembl map.
-void kgl::GenomeMutation::getGeneEnsemblHashMap( const EnsemblIndexMap& ensembl_index_map,
-                                                 const GeneCharacteristic& gene_char,
-                                                 EnsemblHashMap& ensembl_hash_map,
-                                                 ContigOffset_t& lower_bound,
-                                                 ContigOffset_t& upper_bound) {
+std::shared_ptr<const kgl::EnsemblHashMap> kgl::GenomeMutation::getGeneEnsemblHashMap( const EnsemblHashIndex& ensembl_index,
+                                                                                       const GeneCharacteristic& gene_char,
+                                                                                       ContigOffset_t& lower_bound,
+                                                                                       ContigOffset_t& upper_bound) {
 
   lower_bound = 0;
   upper_bound = 0;
-  ensembl_hash_map.clear();
-
-  if (gene_char.ensemblIds().empty()) {
-
-    return;
-
-  }
+  KeyedVariantVector hash_entries;
 
   for (auto const& ensembl_id : gene_char.ensemblIds()) {
 
-    auto lower_iterator = ensembl_index_map.lower_bound(ensembl_id);
-    auto const upper_iterator = ensembl_index_map.upper_bound(ensembl_id);
-
-    while (lower_iterator != upper_iterator) {
-
-      auto const&[ensembl_id, variant_ptr] = *lower_iterator;
+    for (auto const& variant_ptr : ensembl_index.find(ensembl_id)) {
 
       if (lower_bound == 0) {
 
@@ -430,35 +754,37 @@ void kgl::GenomeMutation::getGeneEnsemblHashMap( const EnsemblIndexMap& ensembl_
 
       }
 
-      ensembl_hash_map.emplace(variant_ptr->variantHash(), variant_ptr);
-
-      ++lower_iterator;
+      hash_entries.push_back({variant_ptr->variantHash(), variant_ptr});
 
     }
 
   }
 
-  ensembl_variant_count_ += ensembl_hash_map.size();
+  auto ensembl_hash_map = std::make_shared<const EnsemblHashMap>(std::move(hash_entries));
+  ensembl_variant_count_ += ensembl_hash_map->keyCount();
+
+  return ensembl_hash_map;
 
 }
 
 
 // Get variants matching the ensembl.
-std::shared_ptr<const kgl::ContigDB> kgl::GenomeMutation::getGeneEnsemblAlt( const std::shared_ptr<const ContigDB>& contig_ptr,
+std::shared_ptr<const kgl::ContigDB> kgl::GenomeMutation::getGeneEnsemblAlt( const ContigRegionView& contig_view,
                                                                              const EnsemblHashMap& ensembl_hash_map,
                                                                              const GeneCharacteristic& gene_char) {
 
   std::shared_ptr<ContigDB> gene_contig(std::make_shared<ContigDB>(gene_char.contigId()));
 
-  for (auto const& [offset, offset_db_ptr] : contig_ptr->getMap()) {
+  contig_view.processOffsets([this, &gene_contig, &ensembl_hash_map](ContigOffset_t, const OffsetDB& offset_db) {
 
-    for (auto const& variant_ptr :  offset_db_ptr->getVariantArray()) {
+    for (auto const& variant_ptr :  offset_db.getVariantArray()) {
 
       ++var_checked_count_;
-      auto result = ensembl_hash_map.find(variant_ptr->variantHash());
-      if (result != ensembl_hash_map.end()) {
+      auto ensembl_variants = ensembl_hash_map.find(variant_ptr->variantHash());
+      if (not ensembl_variants.empty()) {
 
-        auto const& [hash, ensembl_variant_ptr] = *result;
+        // Duplicate variant hashes are added once.
+        auto const& ensembl_variant_ptr = ensembl_variants.front();
         if (not gene_contig->addVariant(ensembl_variant_ptr)) {
 
           ExecEnv::log().error( "GenomeMutation::getGeneEnsembl, unable to add variant: {}",
@@ -472,7 +798,7 @@ std::shared_ptr<const kgl::ContigDB> kgl::GenomeMutation::getGeneEnsemblAlt( con
 
     }
 
-  }
+  });
 
   return gene_contig;
 
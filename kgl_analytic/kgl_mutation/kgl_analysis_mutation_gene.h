@@ -6,6 +6,7 @@
 #define KGL_ANALYSIS_MUTATION_GENE_H
 
 #include "kgl_genome_genome.h"
+#include "kgl_genome_interval.h"
 #include "kgl_Hsgenealogy_parser.h"
 #include "kgl_uniprot_parser.h"
 #include "kgl_variant_sort.h"
@@ -58,13 +59,22 @@ enum class VariantGeneMembership { BY_SPAN, BY_EXON, BY_ENSEMBL };
 // By EnsemblSummary is the same as the above but does not use the variant profile of a supplied population data file.
 // Instead the statistics are generated directly from the summary (unphased single genome) data.
 
-using EnsemblHashMap = std::unordered_map<std::string, const std::shared_ptr<const Variant>>;
+// Candidate Ensembl gene variants indexed by variant hash.
+using EnsemblHashMap = VariantHashIndex;
+
+// How the population is traversed. Genome major (the default) sweeps each genome contig once, assigning the sorted
+// contig offsets to genes with a batch stabbing query of the contig gene interval tree.
+// Gene major analyzes each gene in turn, looking up the gene region in the variant offsets of every genome.
+// Both produce identical gene statistics.
+enum class VariantSweep { GENE_MAJOR, GENOME_MAJOR };
 
 class GenomeMutation {
 
 public:
 
-  explicit GenomeMutation(VariantGeneMembership gene_membership) : gene_membership_(gene_membership) {
+  explicit GenomeMutation(VariantGeneMembership gene_membership,
+                          VariantSweep variant_sweep = VariantSweep::GENOME_MAJOR) : gene_membership_(gene_membership),
+                                                                                     variant_sweep_(variant_sweep) {
 
     analysisType();
 
@@ -85,7 +95,7 @@ public:
                         const std::shared_ptr<const PopulationDB>& unphased_population_ptr,
                         const std::shared_ptr<const PopulationDB>& clinvar_population_ptr,
                         const std::shared_ptr<const HsGenomeAux>& genome_aux_data,
-                        const std::shared_ptr<const EnsemblIndexMap>& ensembl_index_map_ptr);
+                        const std::shared_ptr<const EnsemblHashIndex>& ensembl_index_ptr);
 
   // Finally, output to file.
   bool writeOutput(const std::shared_ptr<const HsGenomeAux>& genome_aux_data, const std::string& out_file, char output_delimiter) const;
@@ -95,6 +105,11 @@ private:
 
   std::vector<GeneMutation> gene_vector_;
   VariantGeneMembership gene_membership_;
+  VariantSweep variant_sweep_;
+  std::shared_ptr<const GenomeEthnicIndex> ethnic_index_;
+  // The clinvar index is built once for each clinvar population.
+  std::shared_ptr<const PopulationDB> clinvar_population_ptr_;
+  std::shared_ptr<const ClinvarIndex> clinvar_index_;
   GeneEthnicitySex ethnic_statistics_;
   std::atomic<size_t> gene_variant_count_{0};
   std::atomic<size_t> ensembl_variant_count_{0};
@@ -107,28 +122,84 @@ private:
                           char output_delimiter,
                           const GeneMutation& gene_mutation);
 
-  static std::shared_ptr<const ContigDB> getGeneSpan( const std::shared_ptr<const ContigDB>& contig_ptr,
-                                                      const GeneCharacteristic& gene_char);
+  static ContigRegionView getGeneSpan( const ContigDB& contig,
+                                      const GeneCharacteristic& gene_char);
 
 
-  static std::shared_ptr<const ContigDB> getGeneExon(const std::shared_ptr<const ContigDB>& contig_ptr,
-                                                     const GeneCharacteristic& gene_char);
+  static ContigRegionView getGeneExon( const ContigDB& contig,
+                                      const GeneCharacteristic& gene_char);
 
   static std::shared_ptr<const ContigDB> getGeneEnsembl( const std::shared_ptr<const ContigDB>& contig_ptr,
-                                                         const EnsemblIndexMap& ensembl_index_map,
+                                                         const EnsemblHashIndex& ensembl_index,
                                                          const GeneCharacteristic& gene_char);
 
-  [[nodiscard]] std::shared_ptr<const ContigDB> getGeneEnsemblAlt( const std::shared_ptr<const ContigDB>& contig_ptr,
+  [[nodiscard]] std::shared_ptr<const ContigDB> getGeneEnsemblAlt( const ContigRegionView& contig_view,
                                                                    const EnsemblHashMap& ensembl_hash_map,
                                                                    const GeneCharacteristic& gene_char);
 
   GeneMutation geneSpanAnalysis( const std::shared_ptr<const PopulationDB>& population_ptr,
                                  const std::shared_ptr<const PopulationDB>& unphased_population_ptr,
-                                 const std::shared_ptr<const PopulationDB>& clinvar_population_ptr,
-                                 const std::shared_ptr<const HsGenomeAux>& genome_aux_data,
-                                 const std::shared_ptr<const EnsemblIndexMap>& ensembl_index_map_ptr,
+                                 const std::shared_ptr<const EnsemblHashIndex>& ensembl_index_ptr,
                                  GeneMutation gene_mutation);
 
+  void geneMajorAnalysis( const std::shared_ptr<const PopulationDB>& population_ptr,
+                          const std::shared_ptr<const PopulationDB>& unphased_population_ptr,
+                          const std::shared_ptr<const EnsemblHashIndex>& ensembl_index_ptr);
+
+  // The aggregate gene statistics, contig_data is true if any genome has the gene contig.
+  void summaryStatistics( const std::shared_ptr<const PopulationDB>& population_ptr,
+                          bool contig_data,
+                          GeneMutation& gene_mutation) const;
+
+  // Genome major sweep.
+  // A gene interval [begin, end) on a contig, the gene span or the Ensembl variant bounds.
+  struct SweepGene {
+
+    size_t gene_index;   // Index into gene_vector_.
+    ContigOffset_t begin;
+    ContigOffset_t end;
+    std::shared_ptr<const EnsemblHashMap> ensembl_hash_map;
+
+  };
+
+  // The gene intervals of a contig, indexed by an interval tree with the index into genes as payload (genes can overlap).
+  struct SweepContig {
+
+    std::vector<SweepGene> genes;
+    IntervalTree<size_t> gene_tree;
+
+  };
+  using SweepContigMap = std::map<ContigId_t, SweepContig>;
+
+  // Thread local gene statistics, created for the genes on the contigs of a block of genomes.
+  struct SweepStatistics {
+
+    GeneVariants gene_variants;
+    GeneClinvar clinvar;
+    bool contig_data{false};
+
+  };
+  using SweepBuffer = std::vector<std::unique_ptr<SweepStatistics>>;  // Indexed by gene_vector_.
+
+  void genomeMajorAnalysis( const std::shared_ptr<const PopulationDB>& population_ptr,
+                            const std::shared_ptr<const PopulationDB>& unphased_population_ptr,
+                            const std::shared_ptr<const EnsemblHashIndex>& ensembl_index_ptr);
+
+  [[nodiscard]] std::shared_ptr<const SweepContigMap> sweepContigs( const std::shared_ptr<const PopulationDB>& population_ptr,
+                                                                    const std::shared_ptr<const EnsemblHashIndex>& ensembl_index_ptr);
+
+  [[nodiscard]] SweepBuffer sweepGenomes( const std::shared_ptr<const SweepContigMap>& sweep_contigs,
+                                          const std::vector<std::shared_ptr<const GenomeDB>>& genome_block,
+                                          const std::shared_ptr<const PopulationDB>& unphased_population_ptr);
+
+  [[nodiscard]] SweepStatistics& sweepStatistics(SweepBuffer& sweep_buffer, size_t gene_index) const;
+
+  // Merge the thread local statistics in genome block order, then generate the gene summary statistics.
+  void mergeSweepGenes( const std::vector<SweepBuffer>* block_buffers,
+                        const std::shared_ptr<const PopulationDB>& population_ptr,
+                        size_t gene_begin,
+                        size_t gene_end);
+
   void analysisType();
 
   // return order: hgnc_id, ensembl_id
@@ -137,11 +208,10 @@ private:
                                                         const std::shared_ptr<const GeneFeature>& gene_ptr);
 
   // Set up Ensembl map.
-  void getGeneEnsemblHashMap( const EnsemblIndexMap& ensembl_index_map,
-                              const GeneCharacteristic& gene_char,
-                              EnsemblHashMap& ensembl_hash_map,
-                              ContigOffset_t& lower_bound,
-                              ContigOffset_t& upper_bound);
+  [[nodiscard]] std::shared_ptr<const EnsemblHashMap> getGeneEnsemblHashMap( const EnsemblHashIndex& ensembl_index,
+                                                                             const GeneCharacteristic& gene_char,
+                                                                             ContigOffset_t& lower_bound,
+                                                                             ContigOffset_t& upper_bound);
 
 
   };
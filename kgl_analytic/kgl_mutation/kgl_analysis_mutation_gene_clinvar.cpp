@@ -61,123 +61,199 @@ void kgl::GeneClinvar::writeHeader( const std::shared_ptr<const HsGenomeAux>& ge
 }
 
 
-void kgl::GeneClinvar:: processClinvar( const GenomeId_t& genome_id,
-                                        const ContigId_t& contig_id,
-                                        const std::shared_ptr<const PopulationDB>& clinvar_population_ptr,
-                                        const std::shared_ptr<const ContigDB>& gene_variants,
-                                        const std::shared_ptr<const HsGenomeAux>& genome_aux_data) {
+// A single pass over the gene variant offsets, each offset is probed in the clinvar index.
+// A homozygous genome has 2 clinvar variants at an offset.
+void kgl::GeneClinvar::processClinvar( const GenomeId_t& genome_id,
+                                       const ContigId_t& contig_id,
+                                       const ContigRegionView& subject_variants) {
 
-  if (clinvar_contig_->contigId() != contig_id) {
+  if (not clinvar_index_) {
 
-    clinvar_contig_ = GeneClinvar::getClinvarContig(contig_id, clinvar_population_ptr);
-    clinvar_contig_ = GeneClinvar::FilterPathogenic(clinvar_contig_);
+    ExecEnv::log().error("GeneClinvar::processClinvar; clinvar index not initialized, genome: {}, contig: {}", genome_id, contig_id);
+    return;
 
   }
 
-  processClinvar( genome_id, gene_variants, genome_aux_data);
+  const ClinvarIndex::ClinvarOffsetMap* offset_map = clinvar_index_->contigIndex(contig_id);
+  if (offset_map == nullptr) {
 
-}
+    return;
 
+  }
 
-void kgl::GeneClinvar::processClinvar( const GenomeId_t& genome_id,
-                                       const std::shared_ptr<const ContigDB>& subject_variants,
-                                       const std::shared_ptr<const HsGenomeAux>& genome_aux_data) {
+  bool clinvar_found{false};
+  bool homozygous_found{false};
+  std::vector<std::string> subject_hashes;
+  subject_variants.processOffsets([&](ContigOffset_t offset, const OffsetDB& offset_db) {
+
+    auto result = offset_map->find(offset);
+    if (result == offset_map->end()) {
+
+      return;
+
+    }
 
-  auto subject_clinvar = clinvar_contig_->findContig(subject_variants);
-  auto info_vector = clinvarInfo(subject_clinvar);
-  if (subject_clinvar->variantCount() > 0) {
+    subject_hashes.clear();
+    for (auto const& variant_ptr : offset_db.getVariantArray()) {
+
+      subject_hashes.push_back(variant_ptr->variantHash());
+
+    }
+
+    size_t offset_found{0};
+    auto const& [clinvar_offset, record_vector] = *result;
+    for (auto const& record : record_vector) {
+
+      if (std::find(subject_hashes.begin(), subject_hashes.end(), record.variant_hash) != subject_hashes.end()) {
+
+        // Save any unique descriptions.
+        clinvar_desc_.insert(clinvar_index_->description(record.description_code));
+        ++offset_found;
+
+      }
+
+    }
+
+    clinvar_found = clinvar_found or offset_found > 0;
+    homozygous_found = homozygous_found or offset_found == 2;
+
+  });
+
+  if (clinvar_found) {
 
     ++genome_count_;
-    updateEthnicity().pedAnalysis(genome_id, 1, genome_aux_data);
+    updateEthnicity().pedAnalysis(genome_id, 1);
 
   }
 
-  for (auto const& record : info_vector) {
+  if (homozygous_found) {
 
-    // Save any unique descriptions.
-    clinvar_desc_.insert(record.clndn);
+    ++hom_genome_;
 
   }
 
-  auto hom_clinvar = subject_clinvar->filterVariants(HomozygousFilter());
-  if (hom_clinvar->variantCount() > 0) {
+}
+
+
+void kgl::GeneClinvar::clearStatistics() {
+
+  clinvar_desc_.clear();
+  clinvar_ethnic_.clearCounts();
+  hom_genome_ = 0;
+  genome_count_ = 0;
+
+}
 
-    ++hom_genome_;
+
+void kgl::GeneClinvar::merge(const GeneClinvar& gene_clinvar) {
+
+  clinvar_desc_.insert(gene_clinvar.clinvar_desc_.begin(), gene_clinvar.clinvar_desc_.end());
+  hom_genome_ += gene_clinvar.hom_genome_;
+  genome_count_ += gene_clinvar.genome_count_;
+
+  if (not clinvar_ethnic_.merge(gene_clinvar.clinvar_ethnic_)) {
+
+    ExecEnv::log().error("GeneClinvar::merge; problem merging clinvar ethnic statistics");
 
   }
 
 }
 
 
-std::shared_ptr<const kgl::ContigDB> kgl::GeneClinvar::getClinvarContig( const ContigId_t& contig_id,
-                                                                         const std::shared_ptr<const PopulationDB>& clinvar_population_ptr) {
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ClinvarIndex members.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 
-  std::shared_ptr<ContigDB> null_contig_ptr(std::make_shared<ContigDB>(contig_id));
+kgl::ClinvarIndex::ClinvarIndex(const std::shared_ptr<const PopulationDB>& clinvar_population_ptr) {
 
   if (clinvar_population_ptr->getMap().size() != 1) {
 
-    ExecEnv::log().error("AnalyzeClinvar::getClinvarContig; expected clinvar population to have 1 genome, actual size: {}",
+    ExecEnv::log().error("ClinvarIndex::ClinvarIndex; expected clinvar population to have 1 genome, actual size: {}",
                          clinvar_population_ptr->getMap().size());
-
-    return null_contig_ptr;
+    return;
 
   }
 
-  auto [genomne_id, genome_ptr] = *(clinvar_population_ptr->getMap().begin());
+  auto const& [genome_id, genome_ptr] = *(clinvar_population_ptr->getMap().begin());
 
-  auto contig_opt = genome_ptr->getContig(contig_id);
+  // Descriptions are coded in the order they are first encountered.
+  std::unordered_map<std::string, size_t> description_codes;
+  const InfoSubStringFilter pathogenic_filter(CLINVAR_CLNSIG_FIELD, CLINVAR_PATH_SIGNIF);
+  for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
 
-  if (not contig_opt) {
+    ClinvarOffsetMap offset_map;
+    for (auto const& [offset, offset_ptr] : contig_ptr->getMap()) {
 
-    return null_contig_ptr;
+      for (auto const& variant_ptr : offset_ptr->getVariantArray()) {
 
-  }
+        if (not variant_ptr->filterVariant(pathogenic_filter)) {
 
-  auto clinvar_contig_ptr = contig_opt.value();
+          continue;
 
-  return clinvar_contig_ptr;
+        }
 
-}
+        auto [code_iter, inserted] = description_codes.try_emplace(clinvarDescription(*variant_ptr), descriptions_.size());
+        if (inserted) {
+
+          descriptions_.push_back(code_iter->first);
 
+        }
+
+        offset_map[offset].push_back({variant_ptr->variantHash(), code_iter->second});
+        ++variant_count_;
+
+      }
+
+    }
+
+    if (not offset_map.empty()) {
 
+      contig_index_.try_emplace(contig_id, std::move(offset_map));
 
-std::shared_ptr<const kgl::ContigDB> kgl::GeneClinvar::FilterPathogenic(std::shared_ptr<const ContigDB> clinvar_contig) {
+    }
+
+  }
 
-  return clinvar_contig->filterVariants(InfoSubStringFilter(CLINVAR_CLNSIG_FIELD, CLINVAR_PATH_SIGNIF));
+  ExecEnv::log().info("ClinvarIndex::ClinvarIndex; indexed pathogenic clinvar variants: {}, contigs: {}, descriptions: {}",
+                      variant_count_, contig_index_.size(), descriptions_.size());
 
 }
 
 
-std::vector<kgl::ClinvarInfo> kgl::GeneClinvar::clinvarInfo(const std::shared_ptr<const ContigDB>& clinvar_contig_ptr) {
+const kgl::ClinvarIndex::ClinvarOffsetMap* kgl::ClinvarIndex::contigIndex(const ContigId_t& contig_id) const {
 
-  std::vector<ClinvarInfo> clinvarVector;
+  auto result = contig_index_.find(contig_id);
+  if (result == contig_index_.end()) {
 
-  for (auto const& [offset, offset_ptr] : clinvar_contig_ptr->getMap()) {
+    return nullptr;
 
-    for (auto const& variant_ptr : offset_ptr->getVariantArray()) {
+  }
 
-      ClinvarInfo clinvar_record;
+  auto const& [index_contig_id, offset_map] = *result;
 
-      auto field_opt = InfoEvidenceAnalysis::getInfoData(*variant_ptr, CLINVAR_CLNDN_FIELD);
-      if (field_opt) {
+  return &offset_map;
 
-        std::vector<std::string> desc_vector = InfoEvidenceAnalysis::varianttoStrings(field_opt.value());
-        if (not desc_vector.empty()) {
+}
 
-          clinvar_record.clndn = desc_vector.front();
 
-        }
+// The first clinical description, empty if no description.
+std::string kgl::ClinvarIndex::clinvarDescription(const Variant& variant) {
 
-      }
+  auto field_opt = InfoEvidenceAnalysis::getInfoData(variant, CLINVAR_CLNDN_FIELD);
+  if (field_opt) {
 
-      clinvar_record.variant_ptr = variant_ptr;
+    std::vector<std::string> desc_vector = InfoEvidenceAnalysis::varianttoStrings(field_opt.value());
+    if (not desc_vector.empty()) {
 
-      clinvarVector.push_back(clinvar_record);
+      return desc_vector.front();
 
     }
 
   }
 
-  return clinvarVector;
+  return {};
 
 }
@@ -8,15 +8,52 @@
 #include "kgl_variant_db_population.h"
 #include "kgl_analysis_mutation_gene_ethnic.h"
 
+#include <unordered_map>
+
 
 
 namespace kellerberrin::genome {   //  organization::project level namespace
 
 
-struct ClinvarInfo {
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The pathogenic (CLNSIG) clinvar variants indexed by contig, offset and allele hash.
+// Built once from the clinvar population, the clinical descriptions (CLNDN) are extracted once and coded.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ClinvarIndex {
+
+public:
+
+  explicit ClinvarIndex(const std::shared_ptr<const PopulationDB>& clinvar_population_ptr);
+  ~ClinvarIndex() = default;
+
+  struct ClinvarRecord {
+
+    std::string variant_hash;
+    size_t description_code;   // Index into the description table.
+
+  };
+  using ClinvarOffsetMap = std::unordered_map<ContigOffset_t, std::vector<ClinvarRecord>>;
+
+  // nullptr if the contig has no pathogenic clinvar variants.
+  [[nodiscard]] const ClinvarOffsetMap* contigIndex(const ContigId_t& contig_id) const;
+  [[nodiscard]] const std::string& description(size_t description_code) const { return descriptions_[description_code]; }
+  [[nodiscard]] size_t variantCount() const { return variant_count_; }
+
+private:
+
+  std::unordered_map<ContigId_t, ClinvarOffsetMap> contig_index_;
+  std::vector<std::string> descriptions_;
+  size_t variant_count_{0};
+
+  // Clinvar fields.
+  constexpr static const char* CLINVAR_CLNDN_FIELD = "CLNDN";
+  constexpr static const char* CLINVAR_CLNSIG_FIELD = "CLNSIG";
+  constexpr static const char* CLINVAR_PATH_SIGNIF = "PATHOGENIC";
 
-  std::string clndn;         // Clinical description.
-  std::shared_ptr<const Variant> variant_ptr;
+  [[nodiscard]] static std::string clinvarDescription(const Variant& variant);
 
 };
 
@@ -34,7 +71,6 @@ public:
 
   GeneClinvar()   {
 
-    clinvar_contig_ = std::make_shared<ContigDB>("");
     clinvar_ethnic_.setDisplay("ETH_", (GeneEthnicitySex::DISPLAY_SEX_FLAG | GeneEthnicitySex::DISPLAY_SUPER_POP_FLAG));
 
   }
@@ -54,16 +90,23 @@ public:
                     std::ostream& out_file,
                     char output_delimiter) const;
 
+  // The gene variants of a genome are probed against the clinvar index.
   void processClinvar(const GenomeId_t& genome_id,
                       const ContigId_t& contig_id,
-                      const std::shared_ptr<const PopulationDB>& clinvar_population_ptr,
-                      const std::shared_ptr<const ContigDB>& gene_variants,
-                      const std::shared_ptr<const HsGenomeAux>& genome_aux_data);
+                      const ContigRegionView& gene_variants);
 
 
   // Superpopulation, population and sex breakdown.
   [[nodiscard]] GeneEthnicitySex& updateEthnicity() { return clinvar_ethnic_; }
 
+  // Zero the per genome statistics.
+  void clearStatistics();
+  // Add the per genome statistics of another object.
+  void merge(const GeneClinvar& gene_clinvar);
+
+  // The clinvar index is shared between genes.
+  void setClinvarIndex(const std::shared_ptr<const ClinvarIndex>& clinvar_index) { clinvar_index_ = clinvar_index; }
+
 
 private:
 
@@ -74,12 +117,7 @@ private:
   GeneEthnicitySex clinvar_ethnic_;
   size_t hom_genome_{0};  // Homozygous
   size_t genome_count_{0};
-  std::shared_ptr<const ContigDB> clinvar_contig_;
-
-  // Clinvar fields.
-  constexpr static const char* CLINVAR_CLNDN_FIELD = "CLNDN";
-  constexpr static const char* CLINVAR_CLNSIG_FIELD = "CLNSIG";
-  constexpr static const char* CLINVAR_PATH_SIGNIF = "PATHOGENIC";
+  std::shared_ptr<const ClinvarIndex> clinvar_index_;
 
   // Text description of problems with this gene.
   [[nodiscard]] const std::set<std::string>& getClinvarDesc() const { return  clinvar_desc_; }
@@ -87,18 +125,6 @@ private:
   // Superpopulation, population and sex breakdown.
   [[nodiscard]] const GeneEthnicitySex& getEthnicity() const { return clinvar_ethnic_; }
 
-  void processClinvar(const GenomeId_t& genome_id,
-                      const std::shared_ptr<const ContigDB>& gene_variants,
-                      const std::shared_ptr<const HsGenomeAux>& genome_aux_data);
-
-  static std::vector<ClinvarInfo> clinvarInfo(const std::shared_ptr<const ContigDB>& clinvar_contig_ptr);
-
-  static std::shared_ptr<const ContigDB> getClinvarContig(const ContigId_t& contig_id,
-                                                          const std::shared_ptr<const PopulationDB>& clinvar_population_ptr);
-  static std::shared_ptr<const ContigDB> FilterPathogenic(std::shared_ptr<const ContigDB> clinvar_contig);
-
-
-
 };
 
 
@@ -4,15 +4,89 @@
 
 #include "kgl_analysis_mutation_gene_ethnic.h"
 
+#include <algorithm>
+#include <numeric>
+
 
 namespace kgl = kellerberrin::genome;
 
 
 
 
-bool kgl::GeneEthnicitySex::pedAnalysis(const GenomeId_t& genome_id,
-                                      size_t count,
-                                      const std::shared_ptr<const HsGenomeAux>& genome_aux_data) {
+kgl::GenomeEthnicIndex::GenomeEthnicIndex(const HsGenomeAux& genome_aux_data) {
+
+  // The population lists are sorted maps, so the name vectors are sorted.
+  for (auto const& [population, description] : genome_aux_data.populationList()) {
+
+    populations_.push_back(population);
+
+  }
+
+  for (auto const& [super_population, description] : genome_aux_data.superPopulationList()) {
+
+    super_populations_.push_back(super_population);
+
+  }
+
+  for (auto const& genome_id : genome_aux_data.getGenomeList()) {
+
+    auto record_opt = genome_aux_data.getGenome(genome_id);
+    if (not record_opt) {
+
+      continue;
+
+    }
+
+    auto const& record = record_opt.value();
+    auto population_index = populationIndex(record.population());
+    auto super_population_index = superPopulationIndex(record.superPopulation());
+    if (not population_index or not super_population_index) {
+
+      ExecEnv::log().error("GenomeEthnicIndex::GenomeEthnicIndex; Genome: {} has unlisted population: {} or super population: {}",
+                           genome_id, record.population(), record.superPopulation());
+      continue;
+
+    }
+
+    genome_map_.emplace(genome_id, GenomeEthnicity{ static_cast<uint32_t>(population_index.value()),
+                                                    static_cast<uint32_t>(super_population_index.value()),
+                                                    record.sexType() });
+
+  }
+
+}
+
+
+std::optional<kgl::GenomeEthnicIndex::GenomeEthnicity> kgl::GenomeEthnicIndex::genomeEthnicity(const GenomeId_t& genome_id) const {
+
+  auto result = genome_map_.find(genome_id);
+  if (result == genome_map_.end()) {
+
+    return std::nullopt;
+
+  }
+
+  auto const& [genome, ethnicity] = *result;
+  return ethnicity;
+
+}
+
+
+std::optional<size_t> kgl::GenomeEthnicIndex::nameIndex(const std::vector<std::string>& names, const std::string& name) {
+
+  auto result = std::lower_bound(names.begin(), names.end(), name);
+  if (result == names.end() or *result != name) {
+
+    return std::nullopt;
+
+  }
+
+  return static_cast<size_t>(std::distance(names.begin(), result));
+
+}
+
+
+bool kgl::GeneEthnicitySex::pedAnalysis(const GenomeId_t& genome_id, size_t count) {
 
   if (count == 0) {
 
@@ -20,25 +94,23 @@ bool kgl::GeneEthnicitySex::pedAnalysis(const GenomeId_t& genome_id,
 
   }
 
-  if (not genome_aux_data) {
+  if (not ethnic_index_) {
 
-    ExecEnv::log().critical("GenomeMutation::pedAnalysis; PED file pointer net defined");
+    ExecEnv::log().critical("GeneEthnicitySex::pedAnalysis; ethnic index not defined");
     return false;
 
   }
 
-  auto record_opt = genome_aux_data->getGenome(genome_id);
+  auto ethnicity_opt = ethnic_index_->genomeEthnicity(genome_id);
+  if (not ethnicity_opt) {
 
-  if (not record_opt) {
-
-    ExecEnv::log().error("GenomeMutation::variantAnalysis; Genome sample: {} does not have a PED record", genome_id);
+    ExecEnv::log().error("GeneEthnicitySex::pedAnalysis; Genome sample: {} does not have a PED record", genome_id);
     return false;
 
   }
 
-  auto const ped_record = record_opt.value();
-
-  if (ped_record.sexType() == AuxSexType::MALE) {
+  auto const& ethnicity = ethnicity_opt.value();
+  if (ethnicity.sex == AuxSexType::MALE) {
 
     male_ += count;
 
@@ -48,58 +120,89 @@ bool kgl::GeneEthnicitySex::pedAnalysis(const GenomeId_t& genome_id,
 
   }
 
-  std::string super_pop = ped_record.superPopulation();
-  auto find_result = super_population_.find(super_pop);
-  if (find_result != super_population_.end()) {
+  super_population_counts_[ethnicity.super_population_index] += static_cast<EthnicCount_t>(count);
+  population_counts_[ethnicity.population_index] += static_cast<EthnicCount_t>(count);
 
-    auto& [super_pop, super_count] = *find_result;
-    super_count += count;
+  return true;
+
+}
+
+
+void kgl::GeneEthnicitySex::updatePopulations(const std::shared_ptr<const GenomeEthnicIndex>& ethnic_index) {
+
+  ethnic_index_ = ethnic_index;
+  population_counts_.assign(ethnic_index_->populations().size(), 0);
+  super_population_counts_.assign(ethnic_index_->superPopulations().size(), 0);
+
+}
 
-  } else {
 
-    ExecEnv::log().error("GenomeMutation::pedAnalysis; Unable to find super population: {}", super_pop);
+void kgl::GeneEthnicitySex::clearCounts() {
+
+  std::fill(population_counts_.begin(), population_counts_.end(), 0);
+  std::fill(super_population_counts_.begin(), super_population_counts_.end(), 0);
+  male_ = 0;
+  female_ = 0;
+
+}
+
+
+bool kgl::GeneEthnicitySex::merge(const GeneEthnicitySex& ethnic_counts) {
+
+  if (ethnic_counts.population_counts_.size() != population_counts_.size()
+      or ethnic_counts.super_population_counts_.size() != super_population_counts_.size()) {
+
+    ExecEnv::log().error("GeneEthnicitySex::merge; mismatched population counts, size: {}, merge size: {}",
+                         population_counts_.size(), ethnic_counts.population_counts_.size());
+    return false;
 
   }
 
-  std::string pop = ped_record.population();
-  auto pop_result = population_.find(pop);
-  if (pop_result != population_.end()) {
+  for (size_t index = 0; index < population_counts_.size(); ++index) {
 
-    auto& [pop, pop_count] = *pop_result;
-    pop_count += count;
+    population_counts_[index] += ethnic_counts.population_counts_[index];
 
-  } else {
+  }
+
+  for (size_t index = 0; index < super_population_counts_.size(); ++index) {
 
-    ExecEnv::log().error("GenomeMutation::pedAnalysis; Unable to find population: {}", pop);
+    super_population_counts_[index] += ethnic_counts.super_population_counts_[index];
 
   }
 
+  male_ += ethnic_counts.male_;
+  female_ += ethnic_counts.female_;
+
   return true;
 
 }
 
 
-void kgl::GeneEthnicitySex::updatePopulations(const std::shared_ptr<const HsGenomeAux>& genome_aux_data) {
+std::map<std::string, size_t> kgl::GeneEthnicitySex::population() const {
 
-  // Generate the template populations.
-  std::map<std::string, size_t> population_map;
-  for (auto const& [population, description] : genome_aux_data->populationList()) {
+  return ethnic_index_ ? countMap(ethnic_index_->populations(), population_counts_) : std::map<std::string, size_t>{};
 
-    population_map[population] = 0;
+}
 
-  }
 
-  // Generate the template super populations.
-  std::map<std::string, size_t> super_population_map;
-  for (auto const& [super_population, description] : genome_aux_data->superPopulationList()) {
+std::map<std::string, size_t> kgl::GeneEthnicitySex::superPopulation() const {
 
-    super_population_map[super_population] = 0;
+  return ethnic_index_ ? countMap(ethnic_index_->superPopulations(), super_population_counts_) : std::map<std::string, size_t>{};
+
+}
 
-  }
 
+std::map<std::string, size_t> kgl::GeneEthnicitySex::countMap( const std::vector<std::string>& names,
+                                                               const EthnicCountVector& counts) {
 
-  super_population_ = super_population_map;
-  population_ = population_map;
+  std::map<std::string, size_t> count_map;
+  for (size_t index = 0; index < names.size() and index < counts.size(); ++index) {
+
+    count_map.emplace(names[index], counts[index]);
+
+  }
+
+  return count_map;
 
 }
 
@@ -222,24 +325,14 @@ void kgl::GeneEthnicitySex::writeSuperPop( const std::shared_ptr<const HsGenomeA
                                            std::ostream& out_file,
                                            char output_delimiter) const {
 
-  if (super_population_.size() != genome_aux_data->superPopulationList().size()) {
+  if (super_population_counts_.size() != genome_aux_data->superPopulationList().size()) {
 
     ExecEnv::log().error("GeneEthnicitySex::writeSuperPop; Mismatch between data super population size: {}, and Ped size: {}",
-                         super_population_.size(), genome_aux_data->superPopulationList().size());
+                         super_population_counts_.size(), genome_aux_data->superPopulationList().size());
 
   }
 
-  for (auto const& [super_pop, super_pop_count] : super_population_) {
-
-    if (super_pop != super_population_.begin()->first) {
-
-      out_file << output_delimiter;
-
-    }
-
-    out_file << super_pop_count;
-
-  }
+  writeCounts(super_population_counts_, out_file, output_delimiter);
 
 }
 
@@ -248,22 +341,31 @@ void kgl::GeneEthnicitySex::writePop( const std::shared_ptr<const HsGenomeAux>&
                                       std::ostream& out_file,
                                       char output_delimiter) const {
 
-  if (population_.size() != genome_aux_data->populationList().size()) {
+  if (population_counts_.size() != genome_aux_data->populationList().size()) {
 
-    ExecEnv::log().error("GeneEthnicitySex::writePop; Mismatch between data super population size: {}, and Ped size: {}",
-                         population_.size(), genome_aux_data->populationList().size());
+    ExecEnv::log().error("GeneEthnicitySex::writePop; Mismatch between data population size: {}, and Ped size: {}",
+                         population_counts_.size(), genome_aux_data->populationList().size());
 
   }
 
-  for (auto const& [pop, pop_count] : population_) {
+  writeCounts(population_counts_, out_file, output_delimiter);
+
+}
+
+
+void kgl::GeneEthnicitySex::writeCounts( const EthnicCountVector& counts,
+                                         std::ostream& out_file,
+                                         char output_delimiter) {
+
+  for (size_t index = 0; index < counts.size(); ++index) {
 
-    if (pop != population_.begin()->first) {
+    if (index > 0) {
 
       out_file << output_delimiter;
 
     }
 
-    out_file << pop_count;
+    out_file << counts[index];
 
   }
 
@@ -272,63 +374,42 @@ void kgl::GeneEthnicitySex::writePop( const std::shared_ptr<const HsGenomeAux>&
 
 size_t kgl::GeneEthnicitySex::superPopulationCount(const std::string& super_population) const {
 
-  auto result = super_population_.find(super_population);
-  if (result == super_population_.end()) {
+  auto index_opt = ethnic_index_ ? ethnic_index_->superPopulationIndex(super_population) : std::nullopt;
+  if (not index_opt or index_opt.value() >= super_population_counts_.size()) {
 
     ExecEnv::log().error("GeneEthnicitySex::superPopulationCount; could not find super population: {}", super_population);
     return 0;
 
-  } else {
-
-    auto const& [pop, count] = *result;
-    return count;
-
   }
 
+  return super_population_counts_[index_opt.value()];
+
 }
 
 
 size_t kgl::GeneEthnicitySex::populationCount(const std::string& population) const {
 
-  auto result = population_.find(population);
-  if (result == population_.end()) {
+  auto index_opt = ethnic_index_ ? ethnic_index_->populationIndex(population) : std::nullopt;
+  if (not index_opt or index_opt.value() >= population_counts_.size()) {
 
     ExecEnv::log().error("GeneEthnicitySex::populationCount; could not find population: {}", population);
     return 0;
 
-  } else {
-
-    auto const& [pop, count] = *result;
-    return count;
-
   }
 
+  return population_counts_[index_opt.value()];
+
 }
 
 size_t kgl::GeneEthnicitySex::superPopulationTotal() const {
 
-  size_t total{0};
-  for (auto const& [population, count] : super_population_) {
-
-    total += count;
-
-  }
-
-  return total;
+  return std::accumulate(super_population_counts_.begin(), super_population_counts_.end(), size_t{0});
 
 }
 
 size_t kgl::GeneEthnicitySex::populationTotal() const {
 
-
-  size_t total{0};
-  for (auto const& [population, count] : population_) {
-
-    total += count;
-
-  }
-
-  return total;
+  return std::accumulate(population_counts_.begin(), population_counts_.end(), size_t{0});
 
 }
 
@@ -343,4 +424,4 @@ bool kgl::GeneEthnicitySex::auditTotals() const {
 
   return true;
 
-}
\ No newline at end of file
+}
@@ -10,6 +10,9 @@
 #include "kgl_Hsgenealogy_parser.h"
 #include "kgl_variant_db_population.h"
 
+#include <unordered_map>
+#include <optional>
+
 
 namespace kellerberrin::genome {   //  organization::project level namespace
 
@@ -17,11 +20,51 @@ namespace kellerberrin::genome {   //  organization::project level namespace
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
-//
+// The genome to (population, super population, sex) mapping, created once from the genome auxiliary (PED) data.
+// Populations and super populations are indexed in the (sorted) order of the auxiliary population lists.
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+class GenomeEthnicIndex {
+
+public:
+
+  explicit GenomeEthnicIndex(const HsGenomeAux& genome_aux_data);
+  ~GenomeEthnicIndex() = default;
+
+  struct GenomeEthnicity {
+
+    uint32_t population_index;
+    uint32_t super_population_index;
+    AuxSexType sex;
+
+  };
+
+  [[nodiscard]] const std::vector<std::string>& populations() const { return populations_; }
+  [[nodiscard]] const std::vector<std::string>& superPopulations() const { return super_populations_; }
+  [[nodiscard]] std::optional<size_t> populationIndex(const std::string& population) const { return nameIndex(populations_, population); }
+  [[nodiscard]] std::optional<size_t> superPopulationIndex(const std::string& super_population) const { return nameIndex(super_populations_, super_population); }
+  [[nodiscard]] std::optional<GenomeEthnicity> genomeEthnicity(const GenomeId_t& genome_id) const;
+
+private:
+
+  std::vector<std::string> populations_;
+  std::vector<std::string> super_populations_;
+  std::unordered_map<GenomeId_t, GenomeEthnicity> genome_map_;
 
+  [[nodiscard]] static std::optional<size_t> nameIndex(const std::vector<std::string>& names, const std::string& name);
+
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Per gene population, super population and sex counts, held as dense vectors indexed by the GenomeEthnicIndex.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using EthnicCount_t = uint32_t;
+using EthnicCountVector = std::vector<EthnicCount_t>;
 
 class GeneEthnicitySex {
 
@@ -35,20 +78,27 @@ public:
 
   [[nodiscard]] size_t total() const { return superPopulationTotal(); }
   [[nodiscard]] bool auditTotals() const;
-  [[nodiscard]] const std::map<std::string, size_t> &population() const { return population_; }
-  [[nodiscard]] const std::map<std::string, size_t> &superPopulation() const { return super_population_; }
+  // Population (super population) names and counts.
+  [[nodiscard]] std::map<std::string, size_t> population() const;
+  [[nodiscard]] std::map<std::string, size_t> superPopulation() const;
+  // Counts indexed as GenomeEthnicIndex::populations() and superPopulations().
+  [[nodiscard]] const EthnicCountVector& populationCounts() const { return population_counts_; }
+  [[nodiscard]] const EthnicCountVector& superPopulationCounts() const { return super_population_counts_; }
+  [[nodiscard]] const std::shared_ptr<const GenomeEthnicIndex>& ethnicIndex() const { return ethnic_index_; }
   [[nodiscard]] size_t superPopulationCount(const std::string& super_population) const;
   [[nodiscard]] size_t populationCount(const std::string& population) const;
   [[nodiscard]] size_t male() const { return male_; }
   [[nodiscard]] size_t female() const { return female_; }
 
-  // Update population data using genome to lookup the ped record.
-  bool pedAnalysis(const GenomeId_t& genome_id,
-                   size_t count,
-                   const std::shared_ptr<const HsGenomeAux>& genome_aux_data);
+  // Update population data using genome to lookup the ethnic index.
+  bool pedAnalysis(const GenomeId_t& genome_id, size_t count);
 
-  // Generate the map entries for each population
-  void updatePopulations(const std::shared_ptr<const HsGenomeAux>& genome_aux_data);
+  // Set the ethnic index and zero the population counts.
+  void updatePopulations(const std::shared_ptr<const GenomeEthnicIndex>& ethnic_index);
+  // Zero the counts, the ethnic index is retained.
+  void clearCounts();
+  // Add the counts of another object with the same ethnic index.
+  bool merge(const GeneEthnicitySex& ethnic_counts);
 
   void setDisplay(const std::string& header_prefix, size_t display_flags) {  header_prefix_ = header_prefix; display_flags_ = display_flags; }
 
@@ -74,10 +124,12 @@ private:
   std::string header_prefix_{"E_"};
   // The information to output.
   size_t display_flags_{ DISPLAY_SEX_FLAG | DISPLAY_SUPER_POP_FLAG | DISPLAY_POPULATION_FLAG };
+  // Genome to population lookup.
+  std::shared_ptr<const GenomeEthnicIndex> ethnic_index_;
   // Population breakdown
-  std::map<std::string, size_t> population_;
+  EthnicCountVector population_counts_;
   // Super Population breakdown
-  std::map<std::string, size_t> super_population_;
+  EthnicCountVector super_population_counts_;
   // Sex breakdown.
   size_t male_{0};    // Males that have values for this gene.
   size_t female_{0};  // Females that have values for this gene.
@@ -104,6 +156,13 @@ private:
                  std::ostream& out_file,
                  char output_delimiter) const;
 
+  static void writeCounts( const EthnicCountVector& counts,
+                           std::ostream& out_file,
+                           char output_delimiter);
+
+  [[nodiscard]] static std::map<std::string, size_t> countMap( const std::vector<std::string>& names,
+                                                               const EthnicCountVector& counts);
+
   size_t superPopulationTotal() const;
   size_t populationTotal() const;
 
@@ -11,20 +11,19 @@ namespace kgl = kellerberrin::genome;
 
 
 void kgl::GeneVariants::processVariantStats(const GenomeId_t& genome_id,
-                                            const std::shared_ptr<const ContigDB>& span_variant_ptr,
-                                            const std::shared_ptr<const PopulationDB>& unphased_population_ptr,
-                                            const std::shared_ptr<const HsGenomeAux>& genome_aux_data) {
+                                            const ContigRegionView& span_variant_view,
+                                            const std::shared_ptr<const PopulationDB>& unphased_population_ptr) {
 
   // Variant statistics.
   ++genome_count_;
 
   // Get phased VEP info.
-  VepInfo vep_info = geneSpanVep(span_variant_ptr, unphased_population_ptr);
+  VepInfo vep_info = geneSpanVep(span_variant_view, unphased_population_ptr);
 
   if (vep_info.all_lof > 0) {
 
     ++all_lof_;
-    updateLofEthnicity().pedAnalysis(genome_id, 1, genome_aux_data);
+    updateLofEthnicity().pedAnalysis(genome_id, 1);
 
   }
 
@@ -38,7 +37,7 @@ void kgl::GeneVariants::processVariantStats(const GenomeId_t& genome_id,
   if (vep_info.all_high_effect > 0) {
 
     ++all_high_effect_;
-    updateHighEthnicity().pedAnalysis(genome_id, 1, genome_aux_data);
+    updateHighEthnicity().pedAnalysis(genome_id, 1);
 
   }
 
@@ -52,7 +51,7 @@ void kgl::GeneVariants::processVariantStats(const GenomeId_t& genome_id,
   if (vep_info.all_moderate_effect > 0) {
 
     ++all_moderate_effect_;
-    updateModerateEthnicity().pedAnalysis(genome_id, 1, genome_aux_data);
+    updateModerateEthnicity().pedAnalysis(genome_id, 1);
 
   }
 
@@ -63,7 +62,7 @@ void kgl::GeneVariants::processVariantStats(const GenomeId_t& genome_id,
 
   }
 
-  size_t variant_count = span_variant_ptr->variantCount();
+  size_t variant_count = span_variant_view.variantCount();
 
   if (variant_count > 0) {
 
@@ -73,17 +72,15 @@ void kgl::GeneVariants::processVariantStats(const GenomeId_t& genome_id,
   }
 
   std::set<std::string> unique_variants;
-  for (auto const& [offset, offset_ptr] : span_variant_ptr->getMap()) {
+  span_variant_view.processOffsets([&unique_variants](ContigOffset_t, const OffsetDB& offset_db) {
 
-    const OffsetDBArray& variant_array = offset_ptr->getVariantArray();
-
-    for (auto const& variant_ptr : variant_array) {
+    for (auto const& variant_ptr : offset_db.getVariantArray()) {
 
       unique_variants.insert(variant_ptr->variantHash());
 
     } //for variant
 
-  } //for offset
+  }); //for offset
 
   unique_variants_ = unique_variants.size();
 
@@ -93,7 +90,58 @@ void kgl::GeneVariants::processVariantStats(const GenomeId_t& genome_id,
 
 
 
-kgl::VepInfo kgl::GeneVariants::geneSpanVep( const std::shared_ptr<const ContigDB>& span_contig,
+void kgl::GeneVariants::clearStatistics() {
+
+  unique_variants_ = 0;
+  span_variant_count_ = 0;
+  variant_count_ = 0;
+  all_lof_ = 0;
+  hom_lof_ = 0;
+  ethnic_lof_.clearCounts();
+  all_high_effect_ = 0;
+  hom_high_effect_ = 0;
+  ethnic_high_.clearCounts();
+  all_moderate_effect_ = 0;
+  hom_moderate_effect_ = 0;
+  ethnic_moderate_.clearCounts();
+  genome_count_ = 0;
+  genome_variant_ = 0;
+
+}
+
+
+// The unique variant count is that of the last genome processed.
+void kgl::GeneVariants::merge(const GeneVariants& gene_variants) {
+
+  if (gene_variants.variant_count_ > 0) {
+
+    unique_variants_ = gene_variants.unique_variants_;
+
+  }
+
+  span_variant_count_ += gene_variants.span_variant_count_;
+  variant_count_ += gene_variants.variant_count_;
+  all_lof_ += gene_variants.all_lof_;
+  hom_lof_ += gene_variants.hom_lof_;
+  all_high_effect_ += gene_variants.all_high_effect_;
+  hom_high_effect_ += gene_variants.hom_high_effect_;
+  all_moderate_effect_ += gene_variants.all_moderate_effect_;
+  hom_moderate_effect_ += gene_variants.hom_moderate_effect_;
+  genome_count_ += gene_variants.genome_count_;
+  genome_variant_ += gene_variants.genome_variant_;
+
+  if (not ethnic_lof_.merge(gene_variants.ethnic_lof_)
+      or not ethnic_high_.merge(gene_variants.ethnic_high_)
+      or not ethnic_moderate_.merge(gene_variants.ethnic_moderate_)) {
+
+    ExecEnv::log().error("GeneVariants::merge; problem merging Vep ethnic statistics");
+
+  }
+
+}
+
+
+kgl::VepInfo kgl::GeneVariants::geneSpanVep( const ContigRegionView& span_view,
                                              const std::shared_ptr<const PopulationDB>& unphased_population_ptr) {
 
   VepInfo vep_info;
@@ -107,7 +155,7 @@ kgl::VepInfo kgl::GeneVariants::geneSpanVep( const std::shared_ptr<const ContigD
 
   auto [genomne_id, genome_ptr] = *(unphased_population_ptr->getMap().begin());
 
-  auto contig_opt = genome_ptr->getContig(span_contig->contigId());
+  auto contig_opt = genome_ptr->getContig(span_view.contigId());
 
   if (not contig_opt) {
 
@@ -117,8 +165,8 @@ kgl::VepInfo kgl::GeneVariants::geneSpanVep( const std::shared_ptr<const ContigD
 
   auto unphased_contig = contig_opt.value();
 
-  auto found_all_unphased = unphased_contig->findContig(span_contig);
-  auto found_hom_variants = span_contig->filterVariants(HomozygousFilter());
+  auto found_all_unphased = unphased_contig->findContig(span_view);
+  auto found_hom_variants = span_view.filterVariants(HomozygousFilter());
 
   vep_info.all_lof = vepCount(found_all_unphased, LOF_VEP_FIELD_, LOF_HC_VALUE_);
   vep_info.hom_lof = vepCount(found_hom_variants, LOF_VEP_FIELD_, LOF_HC_VALUE_);
@@ -184,16 +232,30 @@ bool kgl::GeneVariants::processSummaryStatistics( const std::shared_ptr<const Po
 
   }
 
-  for (auto const& [super_population, sample_size] : ethnic_statistics.superPopulation()) {
+  // The ethnic counts share the ethnic index, so the super population counts are indexed identically.
+  const EthnicCountVector& sample_sizes = ethnic_statistics.superPopulationCounts();
+  if (not ethnic_statistics.ethnicIndex()
+      or ethnic_lof_.superPopulationCounts().size() != sample_sizes.size()
+      or ethnic_high_.superPopulationCounts().size() != sample_sizes.size()
+      or ethnic_moderate_.superPopulationCounts().size() != sample_sizes.size()) {
+
+    ExecEnv::log().error("GeneVariants::processSummaryStatistics; Gene: {}, mismatched super population counts", gene);
+    return false;
+
+  }
+
+  for (size_t index = 0; index < sample_sizes.size(); ++index) {
 
+    const std::string& super_population = ethnic_statistics.ethnicIndex()->superPopulations()[index];
+    const size_t sample_size = sample_sizes[index];
     double upper_tail{0.0};
     double lower_tail{0.0};
 
     if (total_success > 0) {
 
-      size_t lof_count = ethnic_lof_.superPopulationCount(super_population);
-      size_t high_count = ethnic_high_.superPopulationCount(super_population);
-      size_t mod_count = ethnic_moderate_.superPopulationCount(super_population);
+      size_t lof_count = ethnic_lof_.superPopulationCounts()[index];
+      size_t high_count = ethnic_high_.superPopulationCounts()[index];
+      size_t mod_count = ethnic_moderate_.superPopulationCounts()[index];
 
       size_t pop_success = lof_count + high_count + mod_count;
 
@@ -271,8 +333,8 @@ bool kgl::GeneVariants::processSummaryStatistics( const std::shared_ptr<const Po
 
 void kgl::GeneVariants::initializeSummaryStatistics( const GeneEthnicitySex& ethnic_statistics) {
 
-  if (upper_tail_.size() == ethnic_statistics.superPopulation().size()
-      and lower_tail_.size() == ethnic_statistics.superPopulation().size()) {
+  if (upper_tail_.size() == ethnic_statistics.superPopulationCounts().size()
+      and lower_tail_.size() == ethnic_statistics.superPopulationCounts().size()) {
 
     return;
 
@@ -75,9 +75,8 @@ public:
                            char output_delimiter) const;
 
   void processVariantStats(const GenomeId_t& genome,
-                           const std::shared_ptr<const ContigDB> &span_variant_ptr,
-                           const std::shared_ptr<const PopulationDB> &unphased_population_ptr,
-                           const std::shared_ptr<const HsGenomeAux>& genome_aux_data);
+                           const ContigRegionView& span_variant_view,
+                           const std::shared_ptr<const PopulationDB> &unphased_population_ptr);
 
   [[nodiscard]] bool processSummaryStatistics( const std::shared_ptr<const PopulationDB> &population_ptr,
                                                const GeneEthnicitySex& ethnic_statistics,
@@ -85,6 +84,11 @@ public:
 
   void initializeSummaryStatistics( const GeneEthnicitySex& ethnic_statistics);
 
+  // Zero the per genome statistics, the summary statistics are retained.
+  void clearStatistics();
+  // Add the per genome statistics of genomes processed after the genomes of this object.
+  void merge(const GeneVariants& gene_variants);
+
   [[nodiscard]] GeneEthnicitySex& updateLofEthnicity() { return ethnic_lof_; }
   [[nodiscard]] GeneEthnicitySex& updateHighEthnicity() { return ethnic_high_; }
   [[nodiscard]] GeneEthnicitySex& updateModerateEthnicity() { return ethnic_moderate_; }
@@ -117,7 +121,7 @@ private:
   constexpr static const char *IMPACT_MODERATE_VALUE_ = "MODERATE";
   constexpr static const char *IMPACT_HIGH_VALUE_ = "HIGH";
 
-  VepInfo geneSpanVep(const std::shared_ptr<const ContigDB> &span_contig,
+  VepInfo geneSpanVep(const ContigRegionView& span_view,
                       const std::shared_ptr<const PopulationDB> &unphased_population_ptr);
 
   size_t vepCount(const std::shared_ptr<const ContigDB> &vep_contig,
@@ -181,7 +181,7 @@ void kgl::NullAnalysis::genomeIdIndex(const std::shared_ptr<const PopulationDB>&
   // See how many genomes have the variant rs62418762.
   ExecEnv::log().info("Starting Genome Variant sort ...");
 
-  auto genome_variant_index_ptr = VariantSort::variantGenomeIndexMT(population);
+  auto genome_variant_index_ptr = VariantSort::variantGenomeHashIndex(population);
 
   ExecEnv::log().info("Completed Genome Variant sort");
 
@@ -198,10 +198,10 @@ void kgl::NullAnalysis::genomeIdIndex(const std::shared_ptr<const PopulationDB>&
 
     for (auto const& variant_id : variant_id_vector) {
 
-      auto result = sorted_variant_ptr->find(variant_id);
-      if (result != sorted_variant_ptr->end()) {
+      auto variant_span = sorted_variant_ptr->find(variant_id);
+      if (not variant_span.empty()) {
 
-        auto const& [variant_id, variant_ptr] = *result;
+        auto const& variant_ptr = variant_span.front();
 
         ++genome_count;
         auto AN_opt = FrequencyDatabaseRead::superPopTotalAlleles(*variant_ptr, FrequencyDatabaseRead::SUPER_POP_ALL_);
@@ -4,6 +4,7 @@
 
 #include "kgl_analysis_verify.h"
 #include "kgl_variant_filter.h"
+#include "kgl_sequence_distance_impl.h"
 
 #include <chrono>
 #include <thread>
@@ -30,6 +31,12 @@ bool kgl::VerifyAnalysis::initializeAnalysis( const std::string& work_directory,
 
   }
 
+  if (not SequenceDistanceImpl().verifyBlosum80()) {
+
+    ExecEnv::log().error("Analysis Id: {}, BLOSUM80 distances do not match the reference alignment scores", ident());
+
+  }
+
   return true;
 
 }
@@ -5,6 +5,7 @@
 #include "kgl_package.h"
 #include "kgl_variant_factory_parsers.h"
 #include "kgl_ontology_database.h"
+#include "kgl_variant_db_population.h"
 
 namespace kgl = kellerberrin::genome;
 namespace kol = kellerberrin::ontology;
@@ -100,6 +101,15 @@ kgl::ExecutePackage::readDataFile(const RuntimePackage& package,
   // Selects the appropriate parser and returns a base class data object.
   std::shared_ptr<kgl::DataDB> data_ptr = ParserSelection::parseData(resource_ptr, file_info_ptr, runtime_config_.evidenceMap(), runtime_config_.contigAlias());
 
+  // Report the memory used by the loaded data.
+  auto population_ptr = std::dynamic_pointer_cast<const PopulationDB>(data_ptr);
+  if (population_ptr) {
+
+    population_ptr->memoryFootprint().logFootprint(data_file);
+
+  }
+  SubsystemMemory::logAllocations();
+
   return data_ptr;
 
 }
@@ -6,6 +6,7 @@
 #define KGL_RESOURCE_DB_H
 
 #include "kel_exec_env.h"
+#include "kel_thread_pool.h"
 
 #include <memory>
 #include <string>
@@ -75,6 +76,9 @@ public:
 
   [[nodiscard]] const ResourceMap& getMap() const { return resource_map_; }
 
+  // A long-lived thread pool shared by all analysis packages, tasks must not wait on other tasks in the pool.
+  [[nodiscard]] ThreadPool& threadPool() const { return *thread_pool_ptr_; }
+
   template <class ResourceClass>
   [[nodiscard]] std::shared_ptr<const ResourceClass> getSingleResource(RuntimeResourceType resource, std::string resource_ident = "") const {
 
@@ -102,6 +106,7 @@ public:
 private:
 
   ResourceMap resource_map_;
+  std::shared_ptr<ThreadPool> thread_pool_ptr_{std::make_shared<ThreadPool>(ThreadPool::defaultThreads())};
 
   inline static std::vector<std::pair<RuntimeResourceType, std::string>> resource_description = {
 
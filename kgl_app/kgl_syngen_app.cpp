@@ -0,0 +1,101 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_syngen_app.h"
+
+#include <boost/program_options.hpp>
+#include <iostream>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+bool kgl::SynGenExecEnv::parseCommandLine(int argc, char const ** argv) {
+
+  SyntheticVCFArgs& vcf_args = args_.vcf_args;
+  boost::program_options::variables_map vm;
+  boost::program_options::options_description desc("Allowed options");
+
+  desc.add_options()
+      ("help,h", "produce help message")
+      ("version,v", "show program version")
+      ("output,o", boost::program_options::value(&args_.output_file)->default_value(args_.output_file), "block gzipped synthetic VCF file")
+      ("logFile,l", boost::program_options::value(&args_.log_file)->default_value(args_.log_file), "log file")
+      ("contig,c", boost::program_options::value(&vcf_args.contig_id)->default_value(vcf_args.contig_id), "contig (chromosome) id")
+      ("start", boost::program_options::value(&vcf_args.start_offset)->default_value(vcf_args.start_offset), "offset of the first site")
+      ("sites,n", boost::program_options::value(&vcf_args.site_count)->default_value(vcf_args.site_count), "number of variant sites")
+      ("spacing", boost::program_options::value(&vcf_args.site_spacing)->default_value(vcf_args.site_spacing), "mean spacing of the variant sites")
+      ("samples,s", boost::program_options::value(&vcf_args.sample_count)->default_value(vcf_args.sample_count), "number of samples, zero for a sites only file")
+      ("multiallelic", boost::program_options::value(&vcf_args.multi_allelic_rate)->default_value(vcf_args.multi_allelic_rate), "proportion of sites with 2 or 3 alternate alleles")
+      ("unphased", boost::program_options::bool_switch(&args_.unphased), "write unphased ('/') genotypes")
+      ("minInbreeding", boost::program_options::value(&vcf_args.min_inbreeding)->default_value(vcf_args.min_inbreeding), "lowest sample inbreeding coefficient")
+      ("maxInbreeding", boost::program_options::value(&vcf_args.max_inbreeding)->default_value(vcf_args.max_inbreeding), "highest sample inbreeding coefficient")
+      ("fst", boost::program_options::value(&vcf_args.population_fst)->default_value(vcf_args.population_fst), "super population divergence (Fst)")
+      ("info", boost::program_options::value(&args_.info_style)->default_value(args_.info_style), "super population INFO field names, '1000G' or 'gnomAD'")
+      ("seed,z", boost::program_options::value(&vcf_args.seed)->default_value(vcf_args.seed), "pseudorandom number seed")
+      ("threads,t", boost::program_options::value(&vcf_args.thread_count)->default_value(vcf_args.thread_count), "generation and compression threads")
+      ;
+
+  try {
+
+    boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+    boost::program_options::notify(vm);
+
+  }
+  catch(const boost::program_options::error& e) {
+
+    std::cerr << MODULE_NAME << " - " << e.what() << "\n" << desc << std::endl;
+    return false;
+
+  }
+
+  // If user specified --help on command line, output usage summary and quit
+  if (vm.count("help") > 0) {
+
+    std::cout << desc << "\n";
+    std::exit(EXIT_SUCCESS);
+
+  }
+
+  // If user specified --version on command line, output version and quit
+  if (vm.count("version") > 0) {
+
+    std::cout << MODULE_NAME << " version " << VERSION << std::endl;
+    std::exit(EXIT_SUCCESS);
+
+  }
+
+  vcf_args.phased = not args_.unphased;
+  if (args_.info_style == "1000G") {
+
+    vcf_args.info_style = SyntheticInfoStyle::GENOME_1000;
+
+  } else if (args_.info_style == "gnomAD") {
+
+    vcf_args.info_style = SyntheticInfoStyle::GNOMAD;
+
+  } else {
+
+    std::cerr << MODULE_NAME << " - unknown INFO style: " << args_.info_style << " (use '1000G' or 'gnomAD')" << std::endl;
+    return false;
+
+  }
+
+  ExecEnv::createLogger(MODULE_NAME, args_.log_file, args_.max_error_count, args_.max_warn_count);
+
+  return true;
+
+}
+
+
+void kgl::SynGenExecEnv::executeApp() {
+
+  SyntheticVCFGenerator generator(getArgs().vcf_args);
+  if (not generator.writeVCF(getArgs().output_file)) {
+
+    ExecEnv::log().error("SynGenExecEnv::executeApp; failed to generate synthetic VCF file: {}", getArgs().output_file);
+
+  }
+
+}
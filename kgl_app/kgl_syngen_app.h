@@ -0,0 +1,58 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_SYNGEN_APP_H
+#define KGL_SYNGEN_APP_H
+
+
+#include "kgl_genome_types.h"
+#include "kel_exec_env.h"
+#include "kgl_analysis_inbreed_syngen_vcf.h"
+
+
+namespace kellerberrin::genome {   //  organization::project level namespace
+
+
+// The synthetic VCF generator commandline arguments.
+struct SynGenCmdLineArgs {
+
+  std::string output_file{"synthetic.vcf.bgz"};
+  std::string log_file{"kgl_syngen.log"};
+  std::string info_style{"1000G"};   // "1000G" or "gnomAD"
+  bool unphased{false};
+  int max_error_count{1000};
+  int max_warn_count{1000};
+  SyntheticVCFArgs vcf_args;
+
+};
+
+// Standalone generator of synthetic population VCF files for benchmarking and regression testing.
+class SynGenExecEnv {
+
+public:
+
+  SynGenExecEnv()=default;
+  ~SynGenExecEnv()=default;
+
+  [[nodiscard]] inline static const SynGenCmdLineArgs& getArgs() { return args_; }
+
+// The following 4 static members are required for all applications.
+  inline static constexpr const char* VERSION = "0.1";
+  inline static constexpr const char* MODULE_NAME = "kglSynGen";
+  static void executeApp(); // Application mainline.
+  [[nodiscard]] static bool parseCommandLine(int argc, char const ** argv);  // Parse command line arguments.
+
+private:
+
+  inline static SynGenCmdLineArgs args_;
+
+};
+
+
+
+} //  end namespace
+
+
+
+#endif //KGL_SYNGEN_APP_H
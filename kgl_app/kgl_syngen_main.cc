@@ -0,0 +1,17 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+#include "kgl_syngen_app.h"
+#include "kel_exec_env_app.h"
+
+
+/// The mainline.
+int main(int argc, char const ** argv)
+{
+
+  namespace kgl = kellerberrin::genome;
+  namespace kel = kellerberrin;
+
+  return kel::ExecEnv::runApplication<kgl::SynGenExecEnv>(argc, argv);
+
+}
@@ -49,9 +49,17 @@ public:
     return gene_exon_features_.findFeatureId(feature_id, feature_ptr_vec);
   }
   // false if offset is not in a gene, else (true) returns a vector of ptrs to the genes.
-  //  [[nodiscard]] bool findGenes(ContigOffset_t offset, GeneVector &gene_ptr_vec) const;
+  [[nodiscard]] bool findGenes(ContigOffset_t offset, GeneVector &gene_ptr_vec) const {
+    return gene_exon_features_.findGenes(offset, gene_ptr_vec);
+  }
+  // false if no gene overlaps the region [begin, end), else (true) returns a vector of ptrs to the overlapping genes.
+  [[nodiscard]] bool findGenes(ContigOffset_t begin, ContigOffset_t end, GeneVector &gene_ptr_vec) const {
+    return gene_exon_features_.findGenes(begin, end, gene_ptr_vec);
+  }
 
   [[nodiscard]] const GeneMap& getGeneMap() const { return gene_exon_features_.geneMap(); }
+  // Used for batch (stabbing) gene lookups over sorted variant offsets.
+  [[nodiscard]] const GeneIntervalTree& getGeneIntervalTree() const { return gene_exon_features_.geneIntervalTree(); }
 
   // Return all Aux genome features in this contig.
   [[nodiscard]] const AuxContigFeatures& getAuxContigFeatures() const { return aux_contig_features_; }
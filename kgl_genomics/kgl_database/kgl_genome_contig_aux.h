@@ -64,6 +64,13 @@ public:
 
   const AdjalleyTSSFeatures& getTSSfeatures() const { return adjalley_TSS_Features_; }
 
+  // False if no TSS features overlap the region [begin, end).
+  [[nodiscard]] bool findTSSFeatures( ContigOffset_t begin,
+                                      ContigOffset_t end,
+                                      std::vector<std::shared_ptr<const Feature>>& feature_ptr_vec) const {
+    return adjalley_TSS_Features_.findOverlappingFeatures(begin, end, feature_ptr_vec);
+  }
+
   void setupVerifyHierarchy(const StructuredFeatures& gene_super_features);
 
   void checkAddFeature(std::shared_ptr<Feature>& feature_ptr);
@@ -140,6 +140,23 @@ void kgl::StructuredFeatures::verifyFeatureHierarchy() {
   verifyContigOverlap();
   removeSubFeatureDuplicates();
   verifySubFeatureDuplicates();
+  // Index after the contig overlap check because feature dimensions may have been adjusted.
+  createIntervalTree();
+
+}
+
+
+void kgl::StructuredFeatures::createIntervalTree() {
+
+  feature_interval_tree_.clear();
+
+  for (auto const& [offset, feature_ptr] : offsetFeatureMap()) {
+
+    feature_interval_tree_.insert(feature_ptr->sequence().begin(), feature_ptr->sequence().end(), feature_ptr);
+
+  }
+
+  feature_interval_tree_.index();
 
 }
 
@@ -222,28 +239,14 @@ void kgl::GeneExonFeatures::setupFeatureHierarchy() {
 
 bool kgl::GeneExonFeatures::findGenes(ContigOffset_t offset, GeneVector &gene_ptr_vec) const {
 
-  gene_ptr_vec.clear();
-  auto lb_result = gene_map_.lower_bound(offset);
-
-  if (lb_result == gene_map_.end()) {
+  return gene_interval_tree_.containing(offset, gene_ptr_vec);
 
-    return false;
-
-  }
-
-  auto result = gene_map_.equal_range(lb_result->first);
-
-  for (auto it = result.first; it != result.second; ++it) {
-
-    if (offset >= it->second->sequence().begin()) {
+}
 
-      gene_ptr_vec.emplace_back(it->second);
 
-    }
+bool kgl::GeneExonFeatures::findGenes(ContigOffset_t begin, ContigOffset_t end, GeneVector &gene_ptr_vec) const {
 
-  }
-
-  return not gene_ptr_vec.empty();
+  return gene_interval_tree_.overlapping(begin, end, gene_ptr_vec);
 
 }
 
@@ -326,8 +329,9 @@ void kgl::GeneExonFeatures::verifyGeneExonHierarchy() {
 
 void kgl::GeneExonFeatures::createGeneMap() {
 
-  // Clear the lookup table.
+  // Clear the lookup tables.
   gene_map_.clear();
+  gene_interval_tree_.clear();
 
   // Iterate through all the features looking for Gene features.
   for(const auto& feature : offsetFeatureMap()) {
@@ -335,12 +339,16 @@ void kgl::GeneExonFeatures::createGeneMap() {
     if(feature.second->isGene()) {
 
       ContigOffset_t end_offset = feature.second->sequence().end();
-      gene_map_.insert(std::make_pair(end_offset, std::static_pointer_cast<GeneFeature>(feature.second)));
+      std::shared_ptr<const GeneFeature> gene_ptr = std::static_pointer_cast<GeneFeature>(feature.second);
+      gene_map_.insert(std::make_pair(end_offset, gene_ptr));
+      gene_interval_tree_.insert(gene_ptr->sequence().begin(), end_offset, gene_ptr);
 
     }
 
   }
 
+  gene_interval_tree_.index();
+
 }
 
 
@@ -43,8 +43,16 @@ public:
   // False if not found.
   [[nodiscard]] bool findFeatureId(const FeatureIdent_t& feature_id, std::vector<std::shared_ptr<const Feature>>& feature_ptr_vec) const;
 
+  // False if no features overlap the region [begin, end).
+  [[nodiscard]] bool findOverlappingFeatures( ContigOffset_t begin,
+                                              ContigOffset_t end,
+                                              std::vector<std::shared_ptr<const Feature>>& feature_ptr_vec) const {
+    return feature_interval_tree_.overlapping(begin, end, feature_ptr_vec);
+  }
+
   [[nodiscard]] const OffsetFeatureMap& offsetFeatureMap() const { return offset_feature_map_; }
   [[nodiscard]] const IdFeatureMap& idFeatureMap() const { return id_feature_map_; }
+  [[nodiscard]] const FeatureIntervalTree& featureIntervalTree() const { return feature_interval_tree_; }
 
 
 protected:
@@ -58,8 +66,10 @@ private:
 
   OffsetFeatureMap offset_feature_map_;
   IdFeatureMap id_feature_map_;
+  FeatureIntervalTree feature_interval_tree_;
 
   void verifyContigOverlap();
+  void createIntervalTree();
   void verifySubFeatureDuplicates();
   void removeSubFeatureDuplicates();
 
@@ -89,8 +99,12 @@ public:
   void setupVerifyHierarchy();
 
   [[nodiscard]] const GeneMap& geneMap() const { return gene_map_; }
+  [[nodiscard]] const GeneIntervalTree& geneIntervalTree() const { return gene_interval_tree_; }
 
+  // False if the offset is not within a gene, else returns all (overlapping) genes containing the offset.
   [[nodiscard]] bool findGenes(ContigOffset_t offset, GeneVector &gene_ptr_vec) const;
+  // False if no genes overlap the region [begin, end), else returns all genes overlapping the region.
+  [[nodiscard]] bool findGenes(ContigOffset_t begin, ContigOffset_t end, GeneVector &gene_ptr_vec) const;
 
   // Given a gene id and an mRNA (sequence id) return the CDS coding sequence.
   [[nodiscard]] bool getCodingSequence( const FeatureIdent_t& gene_id,
@@ -106,6 +120,7 @@ public:
 private:
 
   GeneMap gene_map_;
+  GeneIntervalTree gene_interval_tree_;
 
   void verifySubFeatureSuperFeatureDimensions();
   void createGeneMap();
@@ -7,6 +7,7 @@
 
 #include "kgl_genome_attributes.h"
 #include "kgl_genome_prelim.h"
+#include "kgl_genome_interval.h"
 
 
 namespace kellerberrin::genome {   //  organization level namespace
@@ -82,6 +83,7 @@ private:
 
 using OffsetFeatureMap = std::multimap<ContigOffset_t, std::shared_ptr<Feature>>; // Contig features indexed by offset.
 using IdFeatureMap = std::multimap<FeatureIdent_t, std::shared_ptr<Feature>>; // Contig features indexed by ident.
+using FeatureIntervalTree = IntervalTree<std::shared_ptr<const Feature>>; // Contig features indexed by [begin, end) interval.
 
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -236,6 +238,7 @@ private:
 
 using GeneVector = std::vector<std::shared_ptr<const GeneFeature>>;  // Multiple alternative genes for sequence region.
 using GeneMap = std::multimap<ContigOffset_t, std::shared_ptr<const GeneFeature>>;  // Inserted using the END offset as key.
+using GeneIntervalTree = IntervalTree<std::shared_ptr<const GeneFeature>>;  // Genes indexed by [begin, end) interval, overlapping genes are found.
 
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,318 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_GENOME_INTERVAL_H
+#define KGL_GENOME_INTERVAL_H
+
+#include "kel_exec_env.h"
+#include "kgl_genome_types.h"
+
+#include <vector>
+#include <algorithm>
+#include <array>
+
+
+namespace kellerberrin::genome {   //  organization::project level namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// An implicit augmented interval tree (Li, cgranges) indexing half-open contig intervals [begin, end).
+// Intervals are held in a single vector sorted by begin offset, the tree is implicit in the vector indexes
+// and each node is augmented with the maximum end offset of its subtree.
+// All intervals must be inserted and then index() called before any queries are made.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+template<class Payload>
+class IntervalTree {
+
+public:
+
+  IntervalTree() = default;
+  IntervalTree(const IntervalTree&) = default;
+  ~IntervalTree() = default;
+
+  IntervalTree& operator=(const IntervalTree&) = default;
+
+  // Add an interval, the tree must be re-indexed before it is queried.
+  void insert(ContigOffset_t begin, ContigOffset_t end, const Payload& payload);
+  // Sort the intervals and calculate the subtree maximum end offsets.
+  void index();
+  void clear() { interval_vector_.clear(); max_level_ = -1; indexed_ = true; }
+
+  [[nodiscard]] size_t size() const { return interval_vector_.size(); }
+  [[nodiscard]] bool empty() const { return interval_vector_.empty(); }
+  [[nodiscard]] bool indexed() const { return indexed_; }
+
+  // All payloads with intervals overlapping [begin, end), returned in interval begin order.
+  // Returns false if no overlapping intervals were found.
+  bool overlapping(ContigOffset_t begin, ContigOffset_t end, std::vector<Payload>& payload_vector) const;
+  [[nodiscard]] std::vector<Payload> overlapping(ContigOffset_t begin, ContigOffset_t end) const;
+  // All payloads with intervals containing the offset.
+  bool containing(ContigOffset_t offset, std::vector<Payload>& payload_vector) const { return overlapping(offset, offset + 1, payload_vector); }
+
+  // Batch stabbing query, the offset vector must be sorted in ascending order.
+  // Func is called as visit(offset_index, payload) for every interval that contains offset_vector[offset_index].
+  // A single sweep is made over the sorted intervals. Every offset scans the intervals that are still active (begun
+  // but not yet retired), so the cost is O(offsets x active intervals) plus the interval count.
+  template<typename Func> void stabbing(const std::vector<ContigOffset_t>& offset_vector, Func&& visit) const;
+
+  // Visit all payloads in interval begin order.
+  template<typename Func> void visitAll(Func&& visit) const;
+
+private:
+
+  struct IntervalNode {
+
+    ContigOffset_t begin;
+    ContigOffset_t end;
+    ContigOffset_t max_end;
+    Payload payload;
+
+  };
+
+  struct StackCell {
+
+    int level;
+    size_t node;
+    bool left_processed;
+
+  };
+
+  std::vector<IntervalNode> interval_vector_;
+  int max_level_{-1};
+  bool indexed_{true};
+
+  // Visits the vector indexes of all intervals overlapping [begin, end) in ascending order.
+  template<typename Func> void overlapIndex(ContigOffset_t begin, ContigOffset_t end, Func&& visit) const;
+
+  // Subtrees at or below this level are scanned linearly.
+  constexpr static const int LINEAR_SCAN_LEVEL_{3};
+  // The maximum depth of the implicit tree (2^64 intervals).
+  constexpr static const size_t MAX_STACK_DEPTH_{64};
+
+};
+
+
+template<class Payload>
+void IntervalTree<Payload>::insert(ContigOffset_t begin, ContigOffset_t end, const Payload& payload) {
+
+  interval_vector_.push_back({begin, end, end, payload});
+  indexed_ = false;
+
+}
+
+
+template<class Payload>
+void IntervalTree<Payload>::index() {
+
+  std::stable_sort(interval_vector_.begin(), interval_vector_.end(), [](const IntervalNode& lhs, const IntervalNode& rhs) {
+    return lhs.begin < rhs.begin;
+  });
+
+  indexed_ = true;
+  max_level_ = -1;
+  if (interval_vector_.empty()) {
+
+    return;
+
+  }
+
+  const size_t interval_count = interval_vector_.size();
+  size_t last_node{0};
+  ContigOffset_t last_max{0};
+
+  // Leaves are the even indexes (level 0).
+  for (size_t node = 0; node < interval_count; node += 2) {
+
+    last_node = node;
+    last_max = interval_vector_[node].max_end = interval_vector_[node].end;
+
+  }
+
+  // Internal nodes are processed bottom up.
+  int level{1};
+  for (; (static_cast<size_t>(1) << level) <= interval_count; ++level) {
+
+    const size_t half_step = static_cast<size_t>(1) << (level - 1);
+    const size_t first_node = (half_step << 1) - 1;
+    const size_t step = half_step << 2;
+
+    for (size_t node = first_node; node < interval_count; node += step) {
+
+      const ContigOffset_t left_max = interval_vector_[node - half_step].max_end;
+      const ContigOffset_t right_max = node + half_step < interval_count ? interval_vector_[node + half_step].max_end : last_max;
+      interval_vector_[node].max_end = std::max({interval_vector_[node].end, left_max, right_max});
+
+    }
+
+    // Move the last node to its parent.
+    last_node = ((last_node >> level) & 1) ? last_node - half_step : last_node + half_step;
+    if (last_node < interval_count and interval_vector_[last_node].max_end > last_max) {
+
+      last_max = interval_vector_[last_node].max_end;
+
+    }
+
+  }
+
+  max_level_ = level - 1;
+
+}
+
+
+template<class Payload>
+template<typename Func>
+void IntervalTree<Payload>::overlapIndex(ContigOffset_t begin, ContigOffset_t end, Func&& visit) const {
+
+  if (interval_vector_.empty() or begin >= end) {
+
+    return;
+
+  }
+
+  const size_t interval_count = interval_vector_.size();
+  std::array<StackCell, MAX_STACK_DEPTH_> stack;
+  size_t stack_top{0};
+
+  // Push the root, a top down traversal that visits overlapping intervals in index order.
+  stack[stack_top++] = { max_level_, (static_cast<size_t>(1) << max_level_) - 1, false };
+
+  while (stack_top > 0) {
+
+    const StackCell cell = stack[--stack_top];
+
+    if (cell.level <= LINEAR_SCAN_LEVEL_) {
+
+      // Small subtree, scan every node.
+      const size_t first = (cell.node >> cell.level) << cell.level;
+      const size_t last = std::min(first + (static_cast<size_t>(1) << (cell.level + 1)) - 1, interval_count);
+      for (size_t node = first; node < last and interval_vector_[node].begin < end; ++node) {
+
+        if (begin < interval_vector_[node].end) {
+
+          visit(node);
+
+        }
+
+      }
+
+    } else if (not cell.left_processed) {
+
+      // The left child may be out of range if the tree is not complete.
+      const size_t left_child = cell.node - (static_cast<size_t>(1) << (cell.level - 1));
+      stack[stack_top++] = { cell.level, cell.node, true };
+      if (left_child >= interval_count or interval_vector_[left_child].max_end > begin) {
+
+        stack[stack_top++] = { cell.level - 1, left_child, false };
+
+      }
+
+    } else if (cell.node < interval_count and interval_vector_[cell.node].begin < end) {
+
+      if (begin < interval_vector_[cell.node].end) {
+
+        visit(cell.node);
+
+      }
+      stack[stack_top++] = { cell.level - 1, cell.node + (static_cast<size_t>(1) << (cell.level - 1)), false };
+
+    }
+
+  }
+
+}
+
+
+template<class Payload>
+bool IntervalTree<Payload>::overlapping(ContigOffset_t begin, ContigOffset_t end, std::vector<Payload>& payload_vector) const {
+
+  payload_vector.clear();
+
+  if (not indexed_) {
+
+    ExecEnv::log().error("IntervalTree::overlapping; interval tree has not been indexed, query [{}, {}) ignored", begin, end);
+    return false;
+
+  }
+
+  overlapIndex(begin, end, [this, &payload_vector](size_t node) { payload_vector.push_back(interval_vector_[node].payload); });
+
+  return not payload_vector.empty();
+
+}
+
+
+template<class Payload>
+std::vector<Payload> IntervalTree<Payload>::overlapping(ContigOffset_t begin, ContigOffset_t end) const {
+
+  std::vector<Payload> payload_vector;
+  overlapping(begin, end, payload_vector);
+  return payload_vector;
+
+}
+
+
+template<class Payload>
+template<typename Func>
+void IntervalTree<Payload>::stabbing(const std::vector<ContigOffset_t>& offset_vector, Func&& visit) const {
+
+  if (not indexed_) {
+
+    ExecEnv::log().error("IntervalTree::stabbing; interval tree has not been indexed, batch query ignored");
+    return;
+
+  }
+
+  // Indexes of the intervals that may still contain the current offset, in begin order.
+  std::vector<size_t> active_intervals;
+  size_t next_interval{0};
+
+  for (size_t offset_index = 0; offset_index < offset_vector.size(); ++offset_index) {
+
+    const ContigOffset_t offset = offset_vector[offset_index];
+
+    // Activate all intervals beginning at or before the offset.
+    while (next_interval < interval_vector_.size() and interval_vector_[next_interval].begin <= offset) {
+
+      active_intervals.push_back(next_interval);
+      ++next_interval;
+
+    }
+
+    // Retire intervals that end at or before the offset (offsets are sorted so they cannot be stabbed again).
+    std::erase_if(active_intervals, [this, offset](size_t node) { return interval_vector_[node].end <= offset; });
+
+    for (auto node : active_intervals) {
+
+      visit(offset_index, interval_vector_[node].payload);
+
+    }
+
+  }
+
+}
+
+
+template<class Payload>
+template<typename Func>
+void IntervalTree<Payload>::visitAll(Func&& visit) const {
+
+  for (auto const& interval : interval_vector_) {
+
+    visit(interval.begin, interval.end, interval.payload);
+
+  }
+
+}
+
+
+
+
+}   // end namespace
+
+
+#endif //KGL_GENOME_INTERVAL_H
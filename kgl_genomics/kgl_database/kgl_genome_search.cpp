@@ -0,0 +1,515 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_genome_search.h"
+
+#include <bit>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Aho-Corasick genome search.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+kgl::ContigMotifMap kgl::GenomeMotifSearch::exactSearch( const std::shared_ptr<const GenomeReference>& genome_ptr,
+                                                         const std::vector<std::string>& motif_vector,
+                                                         size_t max_threads) {
+
+  const MotifAutomaton<DNA5> automaton = motifAutomaton(motif_vector);
+
+  ThreadPool thread_pool(std::max<size_t>(1, std::min(max_threads, genome_ptr->getMap().size())));
+  std::vector<std::pair<ContigId_t, std::future<MotifMatchVector>>> future_vector;
+  for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
+
+    const DNA5SequenceLinear& contig_sequence = contig_ptr->sequence();
+    future_vector.emplace_back(contig_id, thread_pool.enqueueTask(&GenomeMotifSearch::automatonSearch,
+                                                                  std::cref(automaton),
+                                                                  std::cref(contig_sequence)));
+
+  }
+
+  ContigMotifMap contig_motif_map;
+  for (auto& [contig_id, future] : future_vector) {
+
+    contig_motif_map.emplace(contig_id, future.get());
+
+  }
+
+  return contig_motif_map;
+
+}
+
+
+kgl::MotifMatchVector kgl::GenomeMotifSearch::exactSearch(const DNA5SequenceLinear& sequence, const std::vector<std::string>& motif_vector) {
+
+  return automatonSearch(motifAutomaton(motif_vector), sequence);
+
+}
+
+
+kgl::MotifAutomaton<kgl::DNA5> kgl::GenomeMotifSearch::motifAutomaton(const std::vector<std::string>& motif_vector) {
+
+  MotifAutomaton<DNA5> automaton;
+  for (auto const& motif : motif_vector) {
+
+    StringDNA5 motif_string(motif);
+    if (not automaton.addMotif(motif_string.view())) {
+
+      ExecEnv::log().warn("GenomeMotifSearch::motifAutomaton; unable to add motif: '{}'", motif);
+
+    }
+
+  }
+
+  automaton.build();
+
+  return automaton;
+
+}
+
+
+kgl::MotifMatchVector kgl::GenomeMotifSearch::automatonSearch(const MotifAutomaton<DNA5>& automaton, const DNA5SequenceLinear& sequence) {
+
+  MotifMatchVector match_vector;
+  automaton.search(sequence.getAlphabetString().view(), [&match_vector](size_t motif_index, ContigOffset_t offset) {
+    match_vector.push_back({offset, motif_index, 0});
+  });
+
+  sortMatches(match_vector);
+
+  return match_vector;
+
+}
+
+
+void kgl::GenomeMotifSearch::sortMatches(MotifMatchVector& match_vector) {
+
+  std::sort(match_vector.begin(), match_vector.end(), [](const MotifMatch& lhs, const MotifMatch& rhs) {
+    return lhs.offset < rhs.offset or (lhs.offset == rhs.offset and lhs.motif_index < rhs.motif_index);
+  });
+
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FM-index.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+kgl::FMIndex::FMIndex(const DNA5SequenceLinear& sequence) {
+
+  if (sequence.length() + 1 >= std::numeric_limits<RowIndex>::max()) {
+
+    ExecEnv::log().error("FMIndex::FMIndex; sequence length: {} exceeds the maximum index size", sequence.length());
+    return;
+
+  }
+
+  // The sentinel is the smallest symbol (0), nucleotide codes are shifted by 1.
+  std::vector<uint8_t> text;
+  text.reserve(sequence.length() + 1);
+  for (auto symbol : sequence.getAlphabetString()) {
+
+    text.push_back(static_cast<uint8_t>(DNA5::symbolToColumn(symbol) + 1));
+
+  }
+  text.push_back(0);
+
+  const std::vector<RowIndex> suffix_array = suffixArray(text);
+  const size_t row_count = suffix_array.size();
+
+  bwt_.resize(row_count);
+  sampled_rows_.resize((row_count + BITS_PER_WORD_ - 1) / BITS_PER_WORD_, 0);
+  std::array<RowIndex, DNA5::NUCLEOTIDE_COLUMNS> symbol_counts{};
+  OccCheckpoint occ_count{};
+  for (size_t row = 0; row < row_count; ++row) {
+
+    if (row % OCC_INTERVAL_ == 0) {
+
+      occ_checkpoints_.push_back(occ_count);
+
+    }
+
+    const RowIndex suffix = suffix_array[row];
+    const uint8_t preceding = text[suffix == 0 ? row_count - 1 : suffix - 1];
+    bwt_[row] = preceding == 0 ? SENTINEL_CODE_ : static_cast<uint8_t>(preceding - 1);
+    if (bwt_[row] != SENTINEL_CODE_) {
+
+      ++occ_count[bwt_[row]];
+
+    }
+
+    if (text[suffix] != 0) {
+
+      ++symbol_counts[text[suffix] - 1];
+
+    }
+
+    if (suffix % SA_SAMPLE_ == 0) {
+
+      sampled_rows_[row / BITS_PER_WORD_] |= (static_cast<uint64_t>(1) << (row % BITS_PER_WORD_));
+      sa_samples_.push_back(suffix);
+
+    }
+
+  }
+
+  // A final checkpoint so that occurrences(code, row_count) is defined.
+  occ_checkpoints_.push_back(occ_count);
+
+  RowIndex symbol_start{1};  // The sentinel suffix is row 0.
+  for (size_t code = 0; code < symbol_start_.size(); ++code) {
+
+    symbol_start_[code] = symbol_start;
+    symbol_start += symbol_counts[code];
+
+  }
+
+  sampled_rank_.reserve(sampled_rows_.size());
+  RowIndex sampled_rank{0};
+  for (auto word : sampled_rows_) {
+
+    sampled_rank_.push_back(sampled_rank);
+    sampled_rank += static_cast<RowIndex>(std::popcount(word));
+
+  }
+
+}
+
+
+// Prefix doubling of the cyclic rotations with counting sorts, the sentinel (0) is unique so rotations sort as suffixes.
+std::vector<kgl::FMIndex::RowIndex> kgl::FMIndex::suffixArray(const std::vector<uint8_t>& text) {
+
+  const size_t text_size = text.size();
+  std::vector<RowIndex> suffixes(text_size);
+  std::vector<RowIndex> classes(text_size);
+  std::vector<RowIndex> shifted(text_size);
+  std::vector<RowIndex> next_classes(text_size);
+  std::vector<RowIndex> class_count(std::max<size_t>(text_size, SENTINEL_CODE_ + 1), 0);
+
+  for (auto symbol : text) {
+
+    ++class_count[symbol];
+
+  }
+  for (size_t index = 1; index <= SENTINEL_CODE_; ++index) {
+
+    class_count[index] += class_count[index - 1];
+
+  }
+  for (size_t index = text_size; index-- > 0;) {
+
+    suffixes[--class_count[text[index]]] = static_cast<RowIndex>(index);
+
+  }
+
+  RowIndex class_total{1};
+  classes[suffixes[0]] = 0;
+  for (size_t index = 1; index < text_size; ++index) {
+
+    if (text[suffixes[index]] != text[suffixes[index - 1]]) {
+
+      ++class_total;
+
+    }
+    classes[suffixes[index]] = class_total - 1;
+
+  }
+
+  for (size_t length = 1; length < text_size and class_total < text_size; length <<= 1) {
+
+    // Sorted by the second half, the rotations are then stably sorted by the first half class.
+    for (size_t index = 0; index < text_size; ++index) {
+
+      shifted[index] = static_cast<RowIndex>(suffixes[index] >= length ? suffixes[index] - length : suffixes[index] + text_size - length);
+
+    }
+
+    std::fill(class_count.begin(), class_count.begin() + class_total, 0);
+    for (auto suffix : shifted) {
+
+      ++class_count[classes[suffix]];
+
+    }
+    for (size_t index = 1; index < class_total; ++index) {
+
+      class_count[index] += class_count[index - 1];
+
+    }
+    for (size_t index = text_size; index-- > 0;) {
+
+      suffixes[--class_count[classes[shifted[index]]]] = shifted[index];
+
+    }
+
+    class_total = 1;
+    next_classes[suffixes[0]] = 0;
+    for (size_t index = 1; index < text_size; ++index) {
+
+      const RowIndex current = suffixes[index];
+      const RowIndex previous = suffixes[index - 1];
+      if (classes[current] != classes[previous]
+          or classes[(current + length) % text_size] != classes[(previous + length) % text_size]) {
+
+        ++class_total;
+
+      }
+      next_classes[current] = class_total - 1;
+
+    }
+
+    classes.swap(next_classes);
+
+  }
+
+  return suffixes;
+
+}
+
+
+std::vector<uint8_t> kgl::FMIndex::patternCodes(const std::string& pattern) {
+
+  std::vector<uint8_t> pattern_codes;
+  pattern_codes.reserve(pattern.size());
+  for (auto symbol : pattern) {
+
+    pattern_codes.push_back(static_cast<uint8_t>(DNA5::symbolToColumn(DNA5::convertChar(symbol))));
+
+  }
+
+  return pattern_codes;
+
+}
+
+
+kgl::FMIndex::RowIndex kgl::FMIndex::occurrences(uint8_t code, RowIndex row) const {
+
+  const size_t checkpoint = row / OCC_INTERVAL_;
+  RowIndex count = occ_checkpoints_[checkpoint][code];
+  for (size_t index = checkpoint * OCC_INTERVAL_; index < row; ++index) {
+
+    if (bwt_[index] == code) {
+
+      ++count;
+
+    }
+
+  }
+
+  return count;
+
+}
+
+
+kgl::FMIndex::RowRange kgl::FMIndex::extend(uint8_t code, RowRange range) const {
+
+  return { static_cast<RowIndex>(symbol_start_[code] + occurrences(code, range.begin)),
+           static_cast<RowIndex>(symbol_start_[code] + occurrences(code, range.end)) };
+
+}
+
+
+bool kgl::FMIndex::isSampled(RowIndex row) const {
+
+  return (sampled_rows_[row / BITS_PER_WORD_] >> (row % BITS_PER_WORD_)) & 1;
+
+}
+
+
+// Step backwards through the sequence (LF mapping) to the nearest sampled suffix array entry.
+// The sentinel row (offset 0) is always sampled.
+kgl::ContigOffset_t kgl::FMIndex::locate(RowIndex row) const {
+
+  size_t steps{0};
+  while (not isSampled(row)) {
+
+    const uint8_t code = bwt_[row];
+    row = symbol_start_[code] + occurrences(code, row);
+    ++steps;
+
+  }
+
+  const size_t word = row / BITS_PER_WORD_;
+  const uint64_t preceding_mask = (static_cast<uint64_t>(1) << (row % BITS_PER_WORD_)) - 1;
+  const size_t sample_index = sampled_rank_[word] + std::popcount(sampled_rows_[word] & preceding_mask);
+
+  return static_cast<ContigOffset_t>(sa_samples_[sample_index] + steps);
+
+}
+
+
+size_t kgl::FMIndex::exactCount(const std::string& pattern) const {
+
+  if (bwt_.empty()) {
+
+    return 0;
+
+  }
+
+  const std::vector<uint8_t> pattern_codes = patternCodes(pattern);
+  RowRange range{0, static_cast<RowIndex>(bwt_.size())};
+  for (size_t index = pattern_codes.size(); index-- > 0;) {
+
+    range = extend(pattern_codes[index], range);
+    if (range.begin >= range.end) {
+
+      return 0;
+
+    }
+
+  }
+
+  return range.end - range.begin;
+
+}
+
+
+void kgl::FMIndex::approximateSearch( const std::string& pattern,
+                                      size_t max_mismatches,
+                                      size_t motif_index,
+                                      MotifMatchVector& match_vector) const {
+
+  if (bwt_.empty() or pattern.empty()) {
+
+    return;
+
+  }
+
+  const std::vector<uint8_t> pattern_codes = patternCodes(pattern);
+  const size_t begin_size = match_vector.size();
+  mismatchSearch(pattern_codes, pattern_codes.size(), {0, static_cast<RowIndex>(bwt_.size())}, 0, max_mismatches, motif_index, match_vector);
+
+  std::sort(match_vector.begin() + static_cast<std::ptrdiff_t>(begin_size), match_vector.end(), [](const MotifMatch& lhs, const MotifMatch& rhs) {
+    return lhs.offset < rhs.offset;
+  });
+
+}
+
+
+// Backward search from the end of the pattern, each substitution is a branch of the search.
+// Distinct branches match distinct strings, so each sequence offset is found at most once.
+void kgl::FMIndex::mismatchSearch( const std::vector<uint8_t>& pattern_codes,
+                                   size_t pattern_index,
+                                   RowRange range,
+                                   size_t mismatches,
+                                   size_t max_mismatches,
+                                   size_t motif_index,
+                                   MotifMatchVector& match_vector) const {
+
+  if (pattern_index == 0) {
+
+    for (RowIndex row = range.begin; row < range.end; ++row) {
+
+      match_vector.push_back({locate(row), motif_index, mismatches});
+
+    }
+
+    return;
+
+  }
+
+  const uint8_t pattern_code = pattern_codes[pattern_index - 1];
+  for (uint8_t code = 0; code < DNA5::NUCLEOTIDE_COLUMNS; ++code) {
+
+    const size_t code_mismatches = mismatches + (code == pattern_code ? 0 : 1);
+    if (code_mismatches > max_mismatches) {
+
+      continue;
+
+    }
+
+    RowRange code_range = extend(code, range);
+    if (code_range.begin < code_range.end) {
+
+      mismatchSearch(pattern_codes, pattern_index - 1, code_range, code_mismatches, max_mismatches, motif_index, match_vector);
+
+    }
+
+  }
+
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Genome FM-index.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+kgl::GenomeFMIndex::GenomeFMIndex(const std::shared_ptr<const GenomeReference>& genome_ptr, size_t max_threads) {
+
+  ThreadPool thread_pool(std::max<size_t>(1, std::min(max_threads, genome_ptr->getMap().size())));
+  std::vector<std::pair<ContigId_t, std::future<std::shared_ptr<const FMIndex>>>> future_vector;
+  for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
+
+    std::shared_ptr<const ContigReference> const_contig_ptr = contig_ptr;
+    future_vector.emplace_back(contig_id, thread_pool.enqueueTask(&GenomeFMIndex::buildIndex, const_contig_ptr));
+
+  }
+
+  for (auto& [contig_id, future] : future_vector) {
+
+    contig_index_map_.emplace(contig_id, future.get());
+
+  }
+
+  ExecEnv::log().info("GenomeFMIndex::GenomeFMIndex; FM-index built for genome: {}, contigs: {}",
+                      genome_ptr->genomeId(), contig_index_map_.size());
+
+}
+
+
+std::shared_ptr<const kgl::FMIndex> kgl::GenomeFMIndex::buildIndex(std::shared_ptr<const ContigReference> contig_ptr) {
+
+  return std::make_shared<const FMIndex>(contig_ptr->sequence());
+
+}
+
+
+kgl::ContigMotifMap kgl::GenomeFMIndex::approximateSearch( const std::vector<std::string>& motif_vector,
+                                                           size_t max_mismatches,
+                                                           size_t max_threads) const {
+
+  ThreadPool thread_pool(std::max<size_t>(1, std::min(max_threads, contig_index_map_.size())));
+  std::vector<std::pair<ContigId_t, std::future<MotifMatchVector>>> future_vector;
+  for (auto const& [contig_id, index_ptr] : contig_index_map_) {
+
+    future_vector.emplace_back(contig_id, thread_pool.enqueueTask(&GenomeFMIndex::contigSearch,
+                                                                  std::cref(*index_ptr),
+                                                                  std::cref(motif_vector),
+                                                                  max_mismatches));
+
+  }
+
+  ContigMotifMap contig_motif_map;
+  for (auto& [contig_id, future] : future_vector) {
+
+    contig_motif_map.emplace(contig_id, future.get());
+
+  }
+
+  return contig_motif_map;
+
+}
+
+
+kgl::MotifMatchVector kgl::GenomeFMIndex::contigSearch( const FMIndex& fm_index,
+                                                        const std::vector<std::string>& motif_vector,
+                                                        size_t max_mismatches) {
+
+  MotifMatchVector match_vector;
+  for (size_t motif_index = 0; motif_index < motif_vector.size(); ++motif_index) {
+
+    fm_index.approximateSearch(motif_vector[motif_index], max_mismatches, motif_index, match_vector);
+
+  }
+
+  GenomeMotifSearch::sortMatches(match_vector);
+
+  return match_vector;
+
+}
+
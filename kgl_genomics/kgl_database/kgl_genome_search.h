@@ -0,0 +1,161 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_GENOME_SEARCH_H
+#define KGL_GENOME_SEARCH_H
+
+
+#include "kgl_genome_genome.h"
+#include "kgl_sequence_motif.h"
+#include "kel_thread_pool.h"
+
+#include <vector>
+#include <array>
+#include <map>
+#include <string>
+
+
+namespace kellerberrin::genome {   //  organization level namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Multi-motif search of the genome contigs. Motifs are nucleotide strings and are only searched on the forward
+// (contig) strand, reverse strand occurrences are found by also searching the reverse complement motifs.
+// Exact searches use an Aho-Corasick automaton, approximate (k-mismatch) searches use an FM-index of each contig
+// built once per reference. Both are performed in parallel across the contigs.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct MotifMatch {
+
+  ContigOffset_t offset{0};
+  size_t motif_index{0};   // Index of the motif in the searched motif vector.
+  size_t mismatches{0};
+
+};
+
+// Matches are sorted by offset and then motif index.
+using MotifMatchVector = std::vector<MotifMatch>;
+using ContigMotifMap = std::map<ContigId_t, MotifMatchVector>;
+
+
+class GenomeMotifSearch {
+
+public:
+
+  GenomeMotifSearch() = delete;
+  ~GenomeMotifSearch() = delete;
+
+  [[nodiscard]] static ContigMotifMap exactSearch( const std::shared_ptr<const GenomeReference>& genome_ptr,
+                                                   const std::vector<std::string>& motif_vector,
+                                                   size_t max_threads = ThreadPool::defaultThreads());
+
+  // Single sequence search.
+  [[nodiscard]] static MotifMatchVector exactSearch(const DNA5SequenceLinear& sequence, const std::vector<std::string>& motif_vector);
+
+  // Sort matches by offset and then motif index.
+  static void sortMatches(MotifMatchVector& match_vector);
+
+private:
+
+  [[nodiscard]] static MotifAutomaton<DNA5> motifAutomaton(const std::vector<std::string>& motif_vector);
+  [[nodiscard]] static MotifMatchVector automatonSearch(const MotifAutomaton<DNA5>& automaton, const DNA5SequenceLinear& sequence);
+
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FM-index of a nucleotide sequence. The suffix array is built by prefix doubling, the BWT occurrence counts are
+// check-pointed every OCC_INTERVAL_ rows and the suffix array is sampled every SA_SAMPLE_ sequence offsets.
+// Sequences are limited to 2^32 - 2 nucleotides.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class FMIndex {
+
+public:
+
+  explicit FMIndex(const DNA5SequenceLinear& sequence);
+  ~FMIndex() = default;
+
+  [[nodiscard]] size_t sequenceLength() const { return bwt_.empty() ? 0 : bwt_.size() - 1; }
+  // The number of exact occurrences of the pattern.
+  [[nodiscard]] size_t exactCount(const std::string& pattern) const;
+  // Appends all occurrences of the pattern with at most max_mismatches substitutions, sorted by offset.
+  void approximateSearch( const std::string& pattern,
+                          size_t max_mismatches,
+                          size_t motif_index,
+                          MotifMatchVector& match_vector) const;
+
+private:
+
+  using RowIndex = uint32_t;
+  using OccCheckpoint = std::array<RowIndex, DNA5::NUCLEOTIDE_COLUMNS>;
+
+  constexpr static const uint8_t SENTINEL_CODE_{DNA5::NUCLEOTIDE_COLUMNS};
+  constexpr static const size_t OCC_INTERVAL_{64};
+  constexpr static const size_t SA_SAMPLE_{32};
+  constexpr static const size_t BITS_PER_WORD_{64};
+
+  std::vector<uint8_t> bwt_;   // Symbol codes as DNA5::symbolToColumn(), the sentinel is SENTINEL_CODE_.
+  std::array<RowIndex, DNA5::NUCLEOTIDE_COLUMNS> symbol_start_{};  // First row of the suffixes starting with each symbol.
+  std::vector<OccCheckpoint> occ_checkpoints_;
+  std::vector<uint64_t> sampled_rows_;   // Bit vector of the rows with a sampled suffix array entry.
+  std::vector<RowIndex> sampled_rank_;   // Number of sampled rows preceding each bit vector word.
+  std::vector<RowIndex> sa_samples_;
+
+  // A range of BWT rows [begin, end).
+  struct RowRange {
+
+    RowIndex begin;
+    RowIndex end;
+
+  };
+
+  [[nodiscard]] static std::vector<RowIndex> suffixArray(const std::vector<uint8_t>& text);
+  [[nodiscard]] static std::vector<uint8_t> patternCodes(const std::string& pattern);
+
+  // Occurrences of the symbol code in rows [0, row).
+  [[nodiscard]] RowIndex occurrences(uint8_t code, RowIndex row) const;
+  [[nodiscard]] RowRange extend(uint8_t code, RowRange range) const;
+  [[nodiscard]] bool isSampled(RowIndex row) const;
+  [[nodiscard]] ContigOffset_t locate(RowIndex row) const;
+  void mismatchSearch( const std::vector<uint8_t>& pattern_codes,
+                       size_t pattern_index,
+                       RowRange range,
+                       size_t mismatches,
+                       size_t max_mismatches,
+                       size_t motif_index,
+                       MotifMatchVector& match_vector) const;
+
+};
+
+
+// The FM-indexes of all the contigs of a reference genome, built in parallel.
+class GenomeFMIndex {
+
+public:
+
+  explicit GenomeFMIndex(const std::shared_ptr<const GenomeReference>& genome_ptr, size_t max_threads = ThreadPool::defaultThreads());
+  ~GenomeFMIndex() = default;
+
+  [[nodiscard]] ContigMotifMap approximateSearch( const std::vector<std::string>& motif_vector,
+                                                  size_t max_mismatches,
+                                                  size_t max_threads = ThreadPool::defaultThreads()) const;
+
+private:
+
+  std::map<ContigId_t, std::shared_ptr<const FMIndex>> contig_index_map_;
+
+  [[nodiscard]] static std::shared_ptr<const FMIndex> buildIndex(std::shared_ptr<const ContigReference> contig_ptr);
+  [[nodiscard]] static MotifMatchVector contigSearch( const FMIndex& fm_index,
+                                                      const std::vector<std::string>& motif_vector,
+                                                      size_t max_mismatches);
+
+};
+
+
+
+}   // end namespace
+
+
+#endif //KGL_GENOME_SEARCH_H
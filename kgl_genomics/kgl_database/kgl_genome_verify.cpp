@@ -136,8 +136,9 @@ bool kgl::ContigReference::verifyCodingSequences(const std::shared_ptr<const Gen
     }
 
     DNA5SequenceCoding coding_sequence = sequence_ptr_->codingSequence(sequence.second);
+    CodonTranslation translation = coding_table_.translateSequence(coding_sequence);
 
-    if (not coding_table_.checkStartCodon(coding_sequence)) {
+    if (not translation.start_codon) {
 
       if (verbose) {
 
@@ -152,7 +153,7 @@ bool kgl::ContigReference::verifyCodingSequences(const std::shared_ptr<const Gen
 
       result = false;
     }
-    if (not coding_table_.checkStopCodon(coding_sequence)) {
+    if (not translation.stop_codon) {
 
       if (verbose) {
 
@@ -168,7 +169,7 @@ bool kgl::ContigReference::verifyCodingSequences(const std::shared_ptr<const Gen
 
       result = false;
     }
-    size_t nonsense_index = coding_table_.checkNonsenseMutation(coding_sequence);
+    size_t nonsense_index = translation.nonsense_index;
     if (nonsense_index > 0) {
 
       if (verbose) {
@@ -260,11 +261,9 @@ bool kgl::Feature::verifyStrand(const SortedCDS& sorted_cds) const {
 // Verifies a coding sequence using the amino coding table defined for the contig.
 bool kgl::ContigReference::verifyDNACodingSequence(const DNA5SequenceCoding& coding_sequence_ptr) const {
 
-  bool result = coding_table_.checkStopCodon(coding_sequence_ptr);
-  result = result and coding_table_.checkStartCodon(coding_sequence_ptr);
-  result = result and coding_table_.checkNonsenseMutation(coding_sequence_ptr) == 0;
+  CodonTranslation translation = coding_table_.translateSequence(coding_sequence_ptr);
 
-  return result;
+  return translation.stop_codon and translation.start_codon and translation.nonsense_index == 0;
 
 }
 
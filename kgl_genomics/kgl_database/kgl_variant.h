@@ -16,6 +16,7 @@
 #include "kgl_variant_evidence.h"
 #include "kgl_variant_filter_virtual.h"
 #include "kgl_variant_factory_vcf_parse_cigar.h"
+#include "kgl_variant_db_memory.h"
 
 
 namespace kellerberrin::genome {   //  organization level namespace
@@ -65,9 +66,9 @@ public:
       contig_reference_offset_(contig_reference_offset),
       contig_allele_offset_(reference_.commonPrefix(alternate_)),
       phase_id_(phase_id),
-      identifier_(std::move(identifier)) { ++object_count_; }
+      identifier_(std::move(identifier)) { ++object_count_; SubsystemMemory::allocate(MemorySubsystem::VARIANT, objectBytes()); }
 
-  ~Variant() { --object_count_; }
+  ~Variant() { --object_count_; SubsystemMemory::deallocate(MemorySubsystem::VARIANT, objectBytes()); }
 
   // Create a copy of the variant on heap.
   // Important - all the original variant evidence is also attached to the new variant object.
@@ -135,6 +136,11 @@ public:
   [[nodiscard]] bool lessThan(const Variant& cmp_var) const {   return variantPhaseHash() < cmp_var.variantPhaseHash(); }
 
   [[nodiscard]] static size_t objectCount() { return object_count_; }
+  // Estimated size of the variant object and its strings, the shared evidence data block is not included.
+  [[nodiscard]] size_t objectBytes() const { return sizeof(Variant) + SubsystemMemory::stringHeapBytes(reference_.length())
+                                                    + SubsystemMemory::stringHeapBytes(alternate_.length())
+                                                    + SubsystemMemory::stringHeapBytes(contig_id_.length())
+                                                    + SubsystemMemory::stringHeapBytes(identifier_.length()); }
 
 private:
 
@@ -5,6 +5,8 @@
 
 #include "kgl_variant_db_contig.h"
 
+#include <queue>
+
 namespace kgl = kellerberrin::genome;
 
 
@@ -206,6 +208,24 @@ size_t kgl::ContigDB::variantCount() const {
 }
 
 
+kgl::DBMemoryFootprint kgl::ContigDB::memoryFootprint() const {
+
+  DBMemoryFootprint footprint;
+  footprint.contig_count = 1;
+  footprint.node_bytes = sizeof(ContigDB) + SubsystemMemory::stringHeapBytes(contig_id_.size());
+
+  for (auto const& [offset, offset_ptr] : getMap()) {
+
+    footprint.node_bytes += sizeof(OffsetDBMap::value_type) + DBMemoryFootprint::MAP_NODE_OVERHEAD;
+    offset_ptr->memoryFootprint(footprint);
+
+  }
+
+  return footprint;
+
+}
+
+
 // Creates a copy of the contig that only contains variants passing the filter condition.
 std::shared_ptr<kgl::ContigDB> kgl::ContigDB::filterVariants(const VariantFilter &filter) const {
 
@@ -322,16 +342,23 @@ std::optional<std::shared_ptr<const kgl::Variant>> kgl::ContigDB::findVariant(co
 // The variants in the template contig are unique. Variant phase is disregarded.
 std::shared_ptr<kgl::ContigDB> kgl::ContigDB::findContig(const std::shared_ptr<const ContigDB>& template_contig) const {
 
-  std::shared_ptr<ContigDB> found_contig_ptr(std::make_shared<ContigDB>(template_contig->contigId()));
+  return findContig(template_contig->regionView());
+
+}
+
+
+std::shared_ptr<kgl::ContigDB> kgl::ContigDB::findContig(const ContigRegionView& template_view) const {
+
+  std::shared_ptr<ContigDB> found_contig_ptr(std::make_shared<ContigDB>(template_view.contigId()));
 
-  for (auto const& [offset, offset_ptr] : template_contig->getMap()) {
+  template_view.processOffsets([this, &found_contig_ptr](ContigOffset_t offset, const OffsetDB& offset_db) {
 
     auto result = contig_offset_map_.find(offset);
     if (result != contig_offset_map_.end()) {
 
       // Create a set of allele hashs to search.
       std::unordered_set<std::string> search_hash;
-      for (auto const& variant_ptr : offset_ptr->getVariantArray()) {
+      for (auto const& variant_ptr : offset_db.getVariantArray()) {
 
         search_hash.insert(variant_ptr->variantHash());
 
@@ -357,7 +384,7 @@ std::shared_ptr<kgl::ContigDB> kgl::ContigDB::findContig(const std::shared_ptr<c
 
     } // if this offset
 
-  } // for all template offset
+  }); // for all template offset
 
   return found_contig_ptr;
 
@@ -392,7 +419,8 @@ std::pair<size_t, size_t> kgl::ContigDB::validate(const std::shared_ptr<const Co
 
       }
 
-      if (contig_sequence_ptr->subSequence(variant_ptr->referenceOffset(), variant_ptr->reference().length()) == variant_ptr->reference()) {
+      auto contig_reference = contig_sequence_ptr->subView(variant_ptr->referenceOffset(), variant_ptr->reference().length());
+      if (std::ranges::equal(contig_reference, variant_ptr->reference().getAlphabetString().view())) {
 
         ++contig_count.second;
 
@@ -549,6 +577,166 @@ std::shared_ptr<kgl::ContigDB> kgl::ContigDB::subset(ContigOffset_t start, Conti
 }
 
 
+// The offset maps of this contig and the merge contigs are k-way merged into a new offset map.
+// At the same offset, the variants of this contig are followed by the variants of the merge contigs in vector order.
+size_t kgl::ContigDB::mergeContigs(const std::vector<std::shared_ptr<const ContigDB>>& merge_contigs) {
+
+  using MergeCursor = std::pair<OffsetDBMap::const_iterator, OffsetDBMap::const_iterator>;
+  std::vector<MergeCursor> cursor_vector;
+  cursor_vector.reserve(merge_contigs.size());
+
+  for (auto const& contig_ptr : merge_contigs) {
+
+    if (contig_ptr.get() == this) {
+
+      ExecEnv::log().error("ContigDB::mergeContigs; attempt to merge contig: {} into itself ignored", contigId());
+      continue;
+
+    }
+
+    cursor_vector.emplace_back(contig_ptr->getMap().begin(), contig_ptr->getMap().end());
+
+  }
+
+  // Min heap of (offset, cursor index), ties are resolved in cursor (vector) order.
+  using MergeEntry = std::pair<ContigOffset_t, size_t>;
+  std::priority_queue<MergeEntry, std::vector<MergeEntry>, std::greater<>> merge_heap;
+  for (size_t index = 0; index < cursor_vector.size(); ++index) {
+
+    auto const& [cursor, cursor_end] = cursor_vector[index];
+    if (cursor != cursor_end) {
+
+      merge_heap.emplace(cursor->first, index);
+
+    }
+
+  }
+
+  // Lock this function to concurrent access.
+  std::scoped_lock lock(add_variant_mutex_);
+
+  OffsetDBMap merged_map;
+  auto this_iter = contig_offset_map_.begin();
+  size_t merge_count{0};
+
+  while (not merge_heap.empty()) {
+
+    auto [offset, index] = merge_heap.top();
+    merge_heap.pop();
+
+    // Move across the existing offsets that precede or are equal to the merge offset.
+    while (this_iter != contig_offset_map_.end() and this_iter->first <= offset) {
+
+      merged_map.emplace_hint(merged_map.end(), this_iter->first, std::move(this_iter->second));
+      ++this_iter;
+
+    }
+
+    if (merged_map.empty() or merged_map.rbegin()->first != offset) {
+
+      merged_map.emplace_hint(merged_map.end(), offset, std::make_unique<OffsetDB>());
+
+    }
+
+    auto& [cursor, cursor_end] = cursor_vector[index];
+    OffsetDB& merged_offset = *(merged_map.rbegin()->second);
+    for (auto const& variant_ptr : cursor->second->getVariantArray()) {
+
+      merged_offset.addVariant(variant_ptr);
+      ++merge_count;
+
+    }
+
+    ++cursor;
+    if (cursor != cursor_end) {
+
+      merge_heap.emplace(cursor->first, index);
+
+    }
+
+  }
+
+  // Move across any remaining offsets.
+  while (this_iter != contig_offset_map_.end()) {
+
+    merged_map.emplace_hint(merged_map.end(), this_iter->first, std::move(this_iter->second));
+    ++this_iter;
+
+  }
+
+  contig_offset_map_ = std::move(merged_map);
+
+  return merge_count;
+
+}
+
+
+kgl::ContigRegionView kgl::ContigDB::regionView() const {
+
+  return ContigRegionView(*this, {{contig_offset_map_.begin(), contig_offset_map_.end()}});
+
+}
+
+
+kgl::ContigRegionView kgl::ContigDB::regionView(ContigOffset_t start, ContigOffset_t end) const {
+
+  if (start >= end) {
+
+    return ContigRegionView(*this, {});
+
+  }
+
+  return ContigRegionView(*this, {{contig_offset_map_.lower_bound(start), contig_offset_map_.lower_bound(end)}});
+
+}
+
+
+kgl::ContigRegionView kgl::ContigDB::regionView(std::vector<ContigRegion> region_vector) const {
+
+  // Sort and merge overlapping (or adjacent) regions so that the iterator ranges are disjoint.
+  std::sort(region_vector.begin(), region_vector.end());
+
+  std::vector<ContigRegion> merged_regions;
+  for (auto const& [start, end] : region_vector) {
+
+    if (start >= end) {
+
+      continue;
+
+    }
+
+    if (not merged_regions.empty() and start <= merged_regions.back().second) {
+
+      merged_regions.back().second = std::max(merged_regions.back().second, end);
+
+    } else {
+
+      merged_regions.emplace_back(start, end);
+
+    }
+
+  }
+
+  OffsetDBRangeVector range_vector;
+  range_vector.reserve(merged_regions.size());
+  for (auto const& [start, end] : merged_regions) {
+
+    auto lower_iter = contig_offset_map_.lower_bound(start);
+    auto upper_iter = contig_offset_map_.lower_bound(end);
+    // Skip empty ranges.
+    if (lower_iter != upper_iter) {
+
+      range_vector.emplace_back(lower_iter, upper_iter);
+
+    }
+
+  }
+
+  return ContigRegionView(*this, std::move(range_vector));
+
+}
+
+
 std::unique_ptr<kgl::ContigDB> kgl::ContigDB::setIntersection(const ContigDB& contig_B, VariantEquality variant_equality) const {
 
   std::unique_ptr<ContigDB> intersection_contig(std::make_unique<ContigDB>(contigId()));
@@ -660,3 +848,94 @@ std::unique_ptr<kgl::ContigDB> kgl::ContigDB::setUnion(const ContigDB& contig_B,
   return union_contig;
 
 }
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ContigRegionView members.
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+const kgl::ContigId_t& kgl::ContigRegionView::contigId() const {
+
+  return contig_ptr_->contigId();
+
+}
+
+
+bool kgl::ContigRegionView::empty() const {
+
+  for (auto const& [begin_iter, end_iter] : getRanges()) {
+
+    if (begin_iter != end_iter) {
+
+      return false;
+
+    }
+
+  }
+
+  return true;
+
+}
+
+
+size_t kgl::ContigRegionView::variantCount() const {
+
+  size_t variant_count{0};
+  processOffsets([&variant_count](ContigOffset_t, const OffsetDB& offset_db) {
+
+    variant_count += offset_db.getVariantArray().size();
+
+  });
+
+  return variant_count;
+
+}
+
+
+std::shared_ptr<kgl::ContigDB> kgl::ContigRegionView::filterVariants(const VariantFilter &filter) const {
+
+  std::shared_ptr<ContigDB> filtered_contig_ptr(std::make_shared<ContigDB>(contigId()));
+
+  processOffsets([&filtered_contig_ptr, &filter](ContigOffset_t offset, const OffsetDB& offset_db) {
+
+    OffsetDB filtered_offset;
+    filtered_offset.setVariantArray(offset_db.getVariantArray());
+    filtered_offset.inSituFilter(filter);
+    if (not filtered_offset.getVariantArray().empty()) {
+
+      // The filtered contig is local to this thread.
+      if (not filtered_contig_ptr->addUnlockedOffset(offset, filtered_offset)) {
+
+        ExecEnv::log().error("ContigRegionView::filterVariants; Problem adding variant at offset: {}, to contig: {}",
+                             offset, filtered_contig_ptr->contigId());
+
+      }
+
+    }
+
+  });
+
+  return filtered_contig_ptr;
+
+}
+
+
+std::shared_ptr<kgl::ContigDB> kgl::ContigRegionView::copyContig() const {
+
+  std::shared_ptr<ContigDB> copy_contig_ptr(std::make_shared<ContigDB>(contigId()));
+
+  processOffsets([&copy_contig_ptr](ContigOffset_t offset, const OffsetDB& offset_db) {
+
+    if (not copy_contig_ptr->addUnlockedOffset(offset, offset_db)) {
+
+      ExecEnv::log().error("ContigRegionView::copyContig; Problem adding variant at offset: {}, to contig: {}",
+                           offset, copy_contig_ptr->contigId());
+
+    }
+
+  });
+
+  return copy_contig_ptr;
+
+}
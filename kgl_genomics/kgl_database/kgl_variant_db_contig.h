@@ -24,13 +24,66 @@ namespace kellerberrin::genome {   //  organization level namespace
 
 
 using OffsetDBMap = std::map<ContigOffset_t, std::unique_ptr<OffsetDB>>;
+using OffsetDBRange = std::pair<OffsetDBMap::const_iterator, OffsetDBMap::const_iterator>;
+using OffsetDBRangeVector = std::vector<OffsetDBRange>;
+using ContigRegion = std::pair<ContigOffset_t, ContigOffset_t>;  // [begin, end)
+
+class ContigDB;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// A zero-copy, read-only view of one or more offset regions of a ContigDB.
+// The view is a vector of iterator ranges into the underlying offset map, the ranges are sorted and disjoint.
+// The view references the ContigDB it was created from and must not outlive it, or be used if the contig is modified.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ContigRegionView {
+
+public:
+
+  ContigRegionView(const ContigDB& contig, OffsetDBRangeVector range_vector) : contig_ptr_(&contig), range_vector_(std::move(range_vector)) {}
+  ~ContigRegionView() = default;
+
+  ContigRegionView(const ContigRegionView &) = default;
+  ContigRegionView& operator=(const ContigRegionView &) = default;
+
+  [[nodiscard]] const ContigId_t &contigId() const;
+  [[nodiscard]] const OffsetDBRangeVector& getRanges() const { return range_vector_; }
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] size_t variantCount() const;
+
+  // Processes all variants in the view with class Obj and Func = &Obj::objFunc(const shared_ptr<const Variant>&)
+  template<class Obj, typename Func> bool processAll(Obj& object, Func objFunc) const;
+  // Visits all offsets in the view in ascending order, Func = visit(ContigOffset_t offset, const OffsetDB& offset_db).
+  template<typename Func> void processOffsets(Func&& visit) const;
+
+  // Creates a contig of the variants in the view that pass the filter condition.
+  [[nodiscard]] std::shared_ptr<ContigDB> filterVariants(const VariantFilter &filter) const;
+  // Only use if a mutable copy of the region is required.
+  [[nodiscard]] std::shared_ptr<ContigDB> copyContig() const;
+
+private:
+
+  const ContigDB* contig_ptr_;
+  OffsetDBRangeVector range_vector_;
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// This object holds variants for each contig.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 
 class ContigDB {
 
 public:
 
-  explicit ContigDB(ContigId_t contig_id) : contig_id_(std::move(contig_id)) {}
-  virtual ~ContigDB() = default;
+  explicit ContigDB(ContigId_t contig_id) : contig_id_(std::move(contig_id)) { SubsystemMemory::allocate(MemorySubsystem::DATABASE_NODE, sizeof(ContigDB)); }
+  virtual ~ContigDB() { SubsystemMemory::deallocate(MemorySubsystem::DATABASE_NODE, sizeof(ContigDB)); }
 
   ContigDB(const ContigDB &) = delete;
   [[nodiscard]] ContigDB &operator=(const ContigDB &) = delete; // Use deep copy.
@@ -54,6 +107,9 @@ public:
 
   [[nodiscard]]  size_t variantCount() const;
 
+  // Walks the offsets to estimate the memory used by the contig.
+  [[nodiscard]] DBMemoryFootprint memoryFootprint() const;
+
   [[nodiscard]] const OffsetDBMap &getMap() const { return contig_offset_map_; }
 
   // Create a filtered contig.
@@ -74,6 +130,8 @@ public:
 
   // Returns a contig containing all variants in this contig that match the template contig.
   [[nodiscard]] std::shared_ptr<ContigDB> findContig(const std::shared_ptr<const ContigDB>& template_contig) const;
+  // Returns a contig containing all variants in this contig that match the variants in the template region view.
+  [[nodiscard]] std::shared_ptr<ContigDB> findContig(const ContigRegionView& template_view) const;
 
   [[nodiscard]] std::optional<OffsetDBArray> findOffsetArray(ContigOffset_t offset) const;
 
@@ -87,8 +145,20 @@ public:
   // Retrieves a contig subset in the offset range [begin, end)
   [[nodiscard]] std::shared_ptr<ContigDB> subset(ContigOffset_t start, ContigOffset_t end) const;
 
+  // Zero-copy read-only views of the contig, prefer these to subset() when the variants are not modified.
+  // The whole contig.
+  [[nodiscard]] ContigRegionView regionView() const;
+  // The offset range [start, end).
+  [[nodiscard]] ContigRegionView regionView(ContigOffset_t start, ContigOffset_t end) const;
+  // The union of a set of [start, end) regions (e.g. exons), overlapping regions are merged so that each variant is viewed once.
+  [[nodiscard]] ContigRegionView regionView(std::vector<ContigRegion> region_vector) const;
+
   // Unconditionally add all the variants in the supplied contig to this contig.
   bool merge(const std::shared_ptr<const ContigDB>& contig) { return contig->processAll(*this, &ContigDB::addVariant); }
+  // Bulk merge, unconditionally adds (retains duplicates) all the variants in the supplied contigs to this contig.
+  // The sorted offset maps are k-way merged and the variant pointers are shared, this is much faster than
+  // merge() for large contigs. Returns the number of variants merged.
+  size_t mergeContigs(const std::vector<std::shared_ptr<const ContigDB>>& merge_contigs);
 
   //Set Functions.
   // setIntersection returns a contig that contains variants present in both contigs.
@@ -117,6 +187,52 @@ private:
 };
 
 
+// Processes all variants in the view with class Obj and Func = &(bool Obj::objFunc(const std::shared_ptr<const Variant>))
+template<class Obj, typename Func>
+bool ContigRegionView::processAll(Obj& object, Func objFunc)  const {
+
+  for (auto const& [begin_iter, end_iter] : getRanges()) {
+
+    for (auto iter = begin_iter; iter != end_iter; ++iter) {
+
+      auto const& [offset, offset_ptr] = *iter;
+      for (auto const& variant_ptr : offset_ptr->getVariantArray()) {
+
+        if (not (object.*objFunc)(variant_ptr)) {
+
+          ExecEnv::log().error("ContigRegionView::processAll<Obj, Func>; Problem executing general purpose template function at offset: {}", offset);
+          return false;
+
+        }
+
+      }
+
+    }
+
+  }
+
+  return true;
+
+}
+
+
+template<typename Func>
+void ContigRegionView::processOffsets(Func&& visit)  const {
+
+  for (auto const& [begin_iter, end_iter] : getRanges()) {
+
+    for (auto iter = begin_iter; iter != end_iter; ++iter) {
+
+      auto const& [offset, offset_ptr] = *iter;
+      visit(offset, *offset_ptr);
+
+    }
+
+  }
+
+}
+
+
 // General purpose genome processing template.
 // Processes all variants in the contig with class Obj and Func = &(bool Obj::objFunc(const std::shared_ptr<const Variant>))
 template<class Obj, typename Func>
@@ -9,12 +9,38 @@ namespace kgl = kellerberrin::genome;
 
 
 // unconditionally merge (retains duplicates) genomes and variants into this genome.
-size_t kgl::GenomeDB::mergeGenome(const std::shared_ptr<const GenomeDB>& merge_genome) {
+size_t kgl::GenomeDB::mergeGenomes(const std::vector<std::shared_ptr<const GenomeDB>>& merge_genomes) {
 
-  if (not merge_genome->processAll(*this, &GenomeDB::addVariant)) {
+  // Gather the contigs to be merged.
+  std::map<ContigId_t, std::vector<std::shared_ptr<const ContigDB>>> merge_contig_map;
+  for (auto const& genome_ptr : merge_genomes) {
 
-    ExecEnv::log().error("GenomeDB::mergeGenome, problem merging genome: {} into genome: {}",
-                         merge_genome->genomeId(), genomeId());
+    if (genome_ptr.get() == this) {
+
+      ExecEnv::log().error("GenomeDB::mergeGenomes, attempt to merge genome: {} into itself ignored", genomeId());
+      continue;
+
+    }
+
+    for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
+
+      merge_contig_map[contig_id].push_back(contig_ptr);
+
+    }
+
+  }
+
+  for (auto const& [contig_id, contig_vector] : merge_contig_map) {
+
+    auto contig_opt = getCreateContig(contig_id);
+    if (not contig_opt) {
+
+      ExecEnv::log().error("GenomeDB::mergeGenomes, Genome: {} could not get or create Contig: {}", genomeId(), contig_id);
+      continue;
+
+    }
+
+    contig_opt.value()->mergeContigs(contig_vector);
 
   }
 
@@ -165,6 +191,24 @@ size_t kgl::GenomeDB::variantCount() const {
 }
 
 
+kgl::DBMemoryFootprint kgl::GenomeDB::memoryFootprint() const {
+
+  DBMemoryFootprint footprint;
+  footprint.genome_count = 1;
+  footprint.node_bytes = sizeof(GenomeDB) + SubsystemMemory::stringHeapBytes(genome_id_.size());
+
+  for (auto const& [contig_id, contig_ptr] : getMap()) {
+
+    footprint.node_bytes += sizeof(ContigDBMap::value_type) + DBMemoryFootprint::MAP_NODE_OVERHEAD;
+    footprint += contig_ptr->memoryFootprint();
+
+  }
+
+  return footprint;
+
+}
+
+
 std::shared_ptr<kgl::GenomeDB> kgl::GenomeDB::filterVariants(const VariantFilter& filter) const {
 
   // Only genome filter is implemented at this level.
@@ -30,8 +30,8 @@ class GenomeDB {
 
 public:
 
-  explicit GenomeDB(const GenomeId_t& genome_id) : genome_id_(genome_id) {}
-  virtual ~GenomeDB() = default;
+  explicit GenomeDB(const GenomeId_t& genome_id) : genome_id_(genome_id) { SubsystemMemory::allocate(MemorySubsystem::DATABASE_NODE, sizeof(GenomeDB)); }
+  virtual ~GenomeDB() { SubsystemMemory::deallocate(MemorySubsystem::DATABASE_NODE, sizeof(GenomeDB)); }
 
   GenomeDB(const GenomeDB&) = delete;
   [[nodiscard]] GenomeDB& operator=(const GenomeDB&) = delete; // Use deep copy.
@@ -40,10 +40,15 @@ public:
   [[nodiscard]] std::shared_ptr<GenomeDB> deepCopy() const { return filterVariants(TrueFilter()); }
 
   // unconditionally merge (retains duplicates) genomes and variants into this genome.
-  [[nodiscard]] size_t mergeGenome(const std::shared_ptr<const GenomeDB>& merge_genome);
+  [[nodiscard]] size_t mergeGenome(const std::shared_ptr<const GenomeDB>& merge_genome) { return mergeGenomes({merge_genome}); }
+  // Bulk merge, the contigs of all the merge genomes are k-way merged into this genome. Returns the genome variant count.
+  [[nodiscard]] size_t mergeGenomes(const std::vector<std::shared_ptr<const GenomeDB>>& merge_genomes);
 
   [[nodiscard]] size_t variantCount() const;
 
+  // Walks the contigs to estimate the memory used by the genome.
+  [[nodiscard]] DBMemoryFootprint memoryFootprint() const;
+
   [[nodiscard]] bool addVariant(const std::shared_ptr<const Variant>& variant);
 
   // Not for use on Diploid/Haploid genomes.
@@ -0,0 +1,87 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kel_exec_env.h"
+#include "kgl_variant_db_memory.h"
+
+
+namespace kgl = kellerberrin::genome;
+
+
+std::string kgl::SubsystemMemory::subsystemName(MemorySubsystem subsystem) {
+
+  switch(subsystem) {
+
+    case MemorySubsystem::DATABASE_NODE:
+      return "DatabaseNode";
+
+    case MemorySubsystem::VARIANT:
+      return "Variant";
+
+    case MemorySubsystem::INFO_DATA:
+      return "InfoData";
+
+    case MemorySubsystem::INFO_STRING:
+      return "InfoString";
+
+  }
+
+  return "Unknown";  // Never reached.
+
+}
+
+
+void kgl::SubsystemMemory::logAllocations() {
+
+  size_t total_bytes{0};
+  for (size_t index = 0; index < SUBSYSTEM_COUNT; ++index) {
+
+    auto subsystem = static_cast<MemorySubsystem>(index);
+    const AllocationCounter& subsystem_counter = counter(subsystem);
+    total_bytes += subsystem_counter.liveBytes();
+    ExecEnv::log().info("Memory subsystem: {}, live objects: {}, live bytes: {}, allocated bytes: {}, deallocated bytes: {}",
+                        subsystemName(subsystem), subsystem_counter.liveAllocations(), subsystem_counter.liveBytes(),
+                        subsystem_counter.allocatedBytes(), subsystem_counter.deallocatedBytes());
+
+  }
+
+  ExecEnv::log().info("Memory subsystems, total live bytes: {}, audited heap bytes: {}",
+                      total_bytes, AuditMemory::allocatedBytes() - AuditMemory::deallocatedBytes());
+
+}
+
+
+kgl::DBMemoryFootprint& kgl::DBMemoryFootprint::operator+=(const DBMemoryFootprint& rhs) {
+
+  genome_count += rhs.genome_count;
+  contig_count += rhs.contig_count;
+  offset_count += rhs.offset_count;
+  variant_references += rhs.variant_references;
+  node_bytes += rhs.node_bytes;
+  variant_bytes += rhs.variant_bytes;
+  info_data_bytes += rhs.info_data_bytes;
+  info_string_bytes += rhs.info_string_bytes;
+
+  return *this;
+
+}
+
+
+size_t kgl::DBMemoryFootprint::totalBytes() const {
+
+  return node_bytes + static_cast<size_t>(variant_bytes + info_data_bytes + info_string_bytes);
+
+}
+
+
+void kgl::DBMemoryFootprint::logFootprint(const std::string& label) const {
+
+  ExecEnv::log().info("Memory footprint: {}, genomes: {}, contigs: {}, offsets: {}, variant references: {}",
+                      label, genome_count, contig_count, offset_count, variant_references);
+  ExecEnv::log().info("Memory footprint: {}, node bytes: {}, variant bytes: {}, info data bytes: {}, info string bytes: {}, total bytes: {}",
+                      label, node_bytes, static_cast<size_t>(variant_bytes), static_cast<size_t>(info_data_bytes),
+                      static_cast<size_t>(info_string_bytes), totalBytes());
+
+}
+
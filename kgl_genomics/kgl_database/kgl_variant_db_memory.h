@@ -0,0 +1,96 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_VARIANT_DB_MEMORY_H
+#define KGL_VARIANT_DB_MEMORY_H
+
+
+#include "kel_mem_alloc.h"
+
+#include <array>
+#include <string>
+
+
+namespace kellerberrin::genome {   //  organization level namespace
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Allocation counters for the subsystems that hold the bulk of the memory after a data file is loaded.
+// Objects add their (estimated) size on construction and remove it on destruction.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum class MemorySubsystem : size_t { DATABASE_NODE = 0,  // PopulationDB, GenomeDB, ContigDB and OffsetDB objects.
+                                      VARIANT = 1,        // Variant objects, including allele and identifier strings.
+                                      INFO_DATA = 2,      // DataMemoryBlock objects, numeric and array index data.
+                                      INFO_STRING = 3 };  // DataMemoryBlock evidence strings (char data and string views).
+
+
+// Static only functions, object cannot be created.
+class SubsystemMemory {
+
+public:
+
+  SubsystemMemory() = delete;
+  ~SubsystemMemory() = delete;
+
+  static void allocate(MemorySubsystem subsystem, size_t bytes) { counter_array_[static_cast<size_t>(subsystem)].allocate(bytes); }
+  static void deallocate(MemorySubsystem subsystem, size_t bytes) { counter_array_[static_cast<size_t>(subsystem)].deallocate(bytes); }
+
+  [[nodiscard]] static const AllocationCounter& counter(MemorySubsystem subsystem) { return counter_array_[static_cast<size_t>(subsystem)]; }
+  [[nodiscard]] static std::string subsystemName(MemorySubsystem subsystem);
+
+  // Estimated heap usage of a string, strings within the small string buffer do not use the heap.
+  [[nodiscard]] static size_t stringHeapBytes(size_t char_count) { return char_count > SMALL_STRING_SIZE_ ? char_count + 1 : 0; }
+
+  // Log the live allocations of each subsystem.
+  static void logAllocations();
+
+  constexpr static const size_t SUBSYSTEM_COUNT{4};
+
+private:
+
+  inline static std::array<AllocationCounter, SUBSYSTEM_COUNT> counter_array_;
+
+  constexpr static const size_t SMALL_STRING_SIZE_{15};
+
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// The memory footprint of a variant database, calculated by walking each DB level.
+// Variants and evidence blocks can be shared between genomes (and phases), so their bytes are
+// apportioned by reference count; a variant held by 10 genomes adds 1/10 of its size to each.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct DBMemoryFootprint {
+
+  size_t genome_count{0};
+  size_t contig_count{0};
+  size_t offset_count{0};
+  size_t variant_references{0};
+  size_t node_bytes{0};                 // DB objects, map nodes and variant pointer vectors.
+  double variant_bytes{0.0};
+  double info_data_bytes{0.0};
+  double info_string_bytes{0.0};
+
+  DBMemoryFootprint& operator+=(const DBMemoryFootprint& rhs);
+
+  [[nodiscard]] size_t totalBytes() const;
+  void logFootprint(const std::string& label) const;
+
+  // Estimated overhead of a std::map node (red-black tree links and colour).
+  constexpr static const size_t MAP_NODE_OVERHEAD{32};
+
+};
+
+
+
+}   // end namespace
+
+
+#endif //KGL_VARIANT_DB_MEMORY_H
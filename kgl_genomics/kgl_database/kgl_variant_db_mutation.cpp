@@ -107,20 +107,25 @@ bool kgl::GenomeMutation::mutantCodingDNA( const ContigId_t& contig_id,
   }
 
 
-  if (not contig_opt.value()->getDNA5SequenceCoding(coding_sequence_ptr, reference_sequence))  {
+  // The reference coding sequence and exon offsets are generated once and shared with the mutation task.
+  auto coding_reference_ptr = SequenceOffset::codingReference(coding_sequence_ptr, contig_opt.value()->sequence());
+  if (coding_reference_ptr->referenceSequence().length() == 0)  {
 
     ExecEnv::log().warn("No valid DNA sequence for contig: {}, gene: {}, sequence id: {}", contig_id, gene_id, sequence_id);
     return false;
 
   }
+  reference_sequence = coding_reference_ptr->copyReference();
 
-  if (not VariantMutation().mutateDNA(variant_map, contig_opt.value(), coding_sequence_ptr, mutant_sequence)) {
+  auto [result, mutant] = mutantCodingTask(contig_opt.value(), *coding_reference_ptr, variant_map);
+  if (not result) {
 
     ExecEnv::log().warn("Problem mutating DNA sequence for contig: {}, gene: {}, sequence id: {}",
                         contig_id, gene_id, sequence_id);
     return false;
 
   }
+  mutant_sequence = std::move(mutant);
 
   // Check the reference sequence for good measure.
   if (not reference_sequence.verifySequence()) {
@@ -146,6 +151,79 @@ bool kgl::GenomeMutation::mutantCodingDNA( const ContigId_t& contig_id,
 
 }
 
+// The reference exon map and coding sequence are generated once and shared by all genome tasks.
+bool kgl::GenomeMutation::mutantCodingBatch( const std::shared_ptr<const ContigReference>& contig_ptr,
+                                            const std::shared_ptr<const CodingSequence>& coding_sequence_ptr,
+                                            const std::vector<OffsetVariantMap>& variant_map_vector,
+                                            std::shared_ptr<const CodingReference>& coding_reference_ptr,
+                                            std::vector<DNA5SequenceCoding>& mutant_sequence_vector,
+                                            size_t max_threads) {
+
+  coding_reference_ptr = SequenceOffset::codingReference(coding_sequence_ptr, contig_ptr->sequence());
+  mutant_sequence_vector.clear();
+  if (coding_reference_ptr->referenceSequence().length() == 0)  {
+
+    ExecEnv::log().warn("mutantCodingBatch(), No valid DNA sequence for contig: {}, sequence id: {}",
+                        contig_ptr->contigId(), coding_sequence_ptr->getCDSParent()->id());
+    return false;
+
+  }
+
+  mutant_sequence_vector.reserve(variant_map_vector.size());
+
+  size_t thread_count = std::max<size_t>(1, std::min(max_threads, variant_map_vector.size()));
+  ThreadPool thread_pool(thread_count);
+  std::vector<std::future<std::pair<bool, DNA5SequenceCoding>>> future_vector;
+  future_vector.reserve(variant_map_vector.size());
+
+  for (auto const& variant_map : variant_map_vector) {
+
+    future_vector.push_back(thread_pool.enqueueTask(&GenomeMutation::mutantCodingTask,
+                                                    contig_ptr,
+                                                    std::cref(*coding_reference_ptr),
+                                                    std::cref(variant_map)));
+
+  }
+
+  bool return_result = true;
+  for (auto& future : future_vector) {
+
+    auto [result, mutant_sequence] = future.get();
+    if (not result) {
+
+      ExecEnv::log().warn("mutantCodingBatch(), Problem mutating DNA sequence for contig: {}, sequence id: {}",
+                          contig_ptr->contigId(), coding_sequence_ptr->getCDSParent()->id());
+      return_result = false;
+
+    }
+    mutant_sequence_vector.push_back(std::move(mutant_sequence));
+
+  }
+
+  return return_result;
+
+}
+
+
+// Genomes without variants receive a copy of the reference, the reference exon offsets are not regenerated.
+std::pair<bool, kgl::DNA5SequenceCoding> kgl::GenomeMutation::mutantCodingTask( const std::shared_ptr<const ContigReference>& contig_ptr,
+                                                                                 const CodingReference& coding_reference,
+                                                                                 const OffsetVariantMap& variant_map) {
+
+  if (variant_map.empty()) {
+
+    return {true, coding_reference.copyReference()};
+
+  }
+
+  DNA5SequenceCoding mutant_sequence;
+  bool result = VariantMutation().mutateDNA(variant_map, contig_ptr, coding_reference.exonOffsets(), mutant_sequence);
+
+  return {result, std::move(mutant_sequence)};
+
+}
+
+
 bool kgl::GenomeMutation::mutantRegion( const ContigId_t& contig_id,
                                        ContigOffset_t region_offset,
                                        ContigSize_t region_size,
@@ -12,6 +12,8 @@
 #include "kgl_genome_attributes.h"
 #include "kgl_variant.h"
 #include "kgl_variant_db_population.h"
+#include "kgl_sequence_offset.h"
+#include "kel_thread_pool.h"
 
 
 namespace kellerberrin::genome {   //  organization level namespace
@@ -46,6 +48,15 @@ public:
                                             DNA5SequenceCoding &reference_sequence,
                                             DNA5SequenceCoding &mutant_sequence);
 
+  // Applies the variant maps of many genomes to a single reference coding sequence in parallel.
+  // Mutant stranded DNA sequences are returned in variant map order, the shared reference in coding_reference_ptr.
+  [[nodiscard]] static bool mutantCodingBatch( const std::shared_ptr<const ContigReference>& contig_ptr,
+                                               const std::shared_ptr<const CodingSequence>& coding_sequence_ptr,
+                                               const std::vector<OffsetVariantMap>& variant_map_vector,
+                                               std::shared_ptr<const CodingReference>& coding_reference_ptr,
+                                               std::vector<DNA5SequenceCoding>& mutant_sequence_vector,
+                                               size_t max_threads = ThreadPool::defaultThreads());
+
   // Returns reference and mutant unstranded DNA region
   [[nodiscard]] static bool mutantRegion(const ContigId_t &contig_id,
                                          ContigOffset_t region_offset,
@@ -62,6 +73,12 @@ public:
                                          const OffsetVariantMap& variant_map,
                                          DNA5SequenceContig &mutant_contig_ptr);
 
+private:
+
+  // Single genome task of mutantCodingBatch() and mutantCodingDNA().
+  [[nodiscard]] static std::pair<bool, DNA5SequenceCoding> mutantCodingTask( const std::shared_ptr<const ContigReference>& contig_ptr,
+                                                                             const CodingReference& coding_reference,
+                                                                             const OffsetVariantMap& variant_map);
 
 };
 
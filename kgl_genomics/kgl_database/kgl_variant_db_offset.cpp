@@ -5,6 +5,7 @@
 
 #include "kgl_variant_db_offset.h"
 #include "kgl_variant_db_freq.h"
+#include "kgl_variant_factory_vcf_evidence_data_blk.h"
 #include <unordered_set>
 
 
@@ -12,6 +13,33 @@ namespace kgl = kellerberrin::genome;
 
 
 
+// Shared variants and info blocks are apportioned by reference count.
+void kgl::OffsetDB::memoryFootprint(DBMemoryFootprint& footprint) const {
+
+  ++footprint.offset_count;
+  footprint.node_bytes += sizeof(OffsetDB) + (variant_vector_.capacity() * sizeof(OffsetDBArray::value_type));
+
+  for (auto const& variant_ptr : variant_vector_) {
+
+    ++footprint.variant_references;
+    const double variant_share = 1.0 / static_cast<double>(variant_ptr.use_count());
+    footprint.variant_bytes += variant_share * static_cast<double>(variant_ptr->objectBytes());
+
+    // The returned info pointer is a copy, so is not counted as a reference.
+    auto info_data_ptr = variant_ptr->evidence().infoData();
+    if (info_data_ptr and info_data_ptr.use_count() > 1) {
+
+      const double info_share = variant_share / static_cast<double>(info_data_ptr.use_count() - 1);
+      footprint.info_data_bytes += info_share * static_cast<double>(info_data_ptr->dataBytes());
+      footprint.info_string_bytes += info_share * static_cast<double>(info_data_ptr->stringBytes());
+
+    }
+
+  }
+
+}
+
+
 std::pair<size_t, size_t> kgl::OffsetDB::inSituFilter(const VariantFilter &filter) {
 
   switch(filter.filterType()) {
@@ -30,8 +30,8 @@ class OffsetDB {
 
 public:
 
-  OffsetDB() { variant_vector_.reserve(INITIAL_VECTOR_SIZE_); }
-  ~OffsetDB() = default;
+  OffsetDB() { variant_vector_.reserve(INITIAL_VECTOR_SIZE_); SubsystemMemory::allocate(MemorySubsystem::DATABASE_NODE, sizeof(OffsetDB)); }
+  ~OffsetDB() { SubsystemMemory::deallocate(MemorySubsystem::DATABASE_NODE, sizeof(OffsetDB)); }
 
   OffsetDB(const OffsetDB &) = delete;
   OffsetDB& operator=(const OffsetDB &) = delete;
@@ -42,6 +42,9 @@ public:
   void addVariant(const std::shared_ptr<const Variant>& variant_ptr) { variant_vector_.push_back(variant_ptr); }
   std::pair<size_t, size_t> inSituFilter(const VariantFilter &filter);
 
+  // Adds the memory used by the offset and its variants.
+  void memoryFootprint(DBMemoryFootprint& footprint) const;
+
   // setIntersection returns an OffsetDB that contains unique variants present in both offsets.
   // The VariantEquality flag determines whether variant phase is used in the equality.
   [[nodiscard]] std::unique_ptr<OffsetDB> setIntersection(const OffsetDB& intersection_offset, VariantEquality variant_equality) const;
@@ -121,6 +121,45 @@ size_t kgl::PopulationDB::variantCount() const {
 
 
 
+kgl::DBMemoryFootprint kgl::PopulationDB::memoryFootprint() const {
+
+  DBMemoryFootprint footprint;
+  footprint.node_bytes = nodeBytes();
+
+  if (getMap().empty()) {
+
+    return footprint;
+
+  }
+
+  size_t thread_count = std::min(getMap().size(), ThreadPool::defaultThreads());
+  ThreadPool thread_pool(thread_count);
+  std::vector<std::future<DBMemoryFootprint>> future_vector;
+
+  struct FootprintClass {
+
+    static DBMemoryFootprint genomeFootprint(std::shared_ptr<const GenomeDB> genome_ptr) { return genome_ptr->memoryFootprint(); };
+
+  } ;
+
+  for (auto const& [genome_id, genome_ptr] : getMap()) {
+
+    footprint.node_bytes += sizeof(GenomeDBMap::value_type) + DBMemoryFootprint::MAP_NODE_OVERHEAD;
+    future_vector.push_back(thread_pool.enqueueTask(&FootprintClass::genomeFootprint, genome_ptr));
+
+  }
+
+  for (auto& future : future_vector) {
+
+    footprint += future.get();
+
+  }
+
+  return footprint;
+
+}
+
+
 // Multi-tasking filtering for large populations.
 // We can do this because smart pointer reference counting (only) is thread safe.
 std::shared_ptr<kgl::PopulationDB> kgl::PopulationDB::filterVariants(const VariantFilter& filter) const {
@@ -285,19 +324,62 @@ bool kgl::PopulationDB::addVariant(const std::shared_ptr<const Variant>& variant
 
 
 // Unconditional Merge.
-size_t kgl::PopulationDB::mergePopulation(const std::shared_ptr<const PopulationDB>& merge_population) {
+// Genomes are independent and are merged in parallel.
+// We can multi-thread because smart pointer reference counting (only) is thread safe.
+size_t kgl::PopulationDB::mergePopulations(const std::vector<std::shared_ptr<const PopulationDB>>& merge_populations) {
 
-  size_t variant_count = 0;
-  for (const auto& [genome, genome_ptr] : merge_population->getMap()) {
+  // Gather the genomes to be merged.
+  std::map<GenomeId_t, std::vector<std::shared_ptr<const GenomeDB>>> merge_genome_map;
+  for (auto const& population_ptr : merge_populations) {
 
-    auto genome_opt = getCreateGenome(genome);
+    if (population_ptr.get() == this) {
+
+      ExecEnv::log().error("PopulationDB::mergePopulations; attempt to merge population: {} into itself ignored", populationId());
+      continue;
+
+    }
+
+    for (auto const& [genome_id, genome_ptr] : population_ptr->getMap()) {
+
+      merge_genome_map[genome_id].push_back(genome_ptr);
+
+    }
+
+  }
+
+  // Edge Condition, if no genomes then simply exit.
+  if (merge_genome_map.empty()) {
+
+    return 0;
+
+  }
+
+  // Calc how many threads required.
+  size_t thread_count = std::min(merge_genome_map.size(), ThreadPool::defaultThreads());
+  ThreadPool thread_pool(thread_count);
+  // A vector for futures.
+  std::vector<std::future<size_t>> future_vector;
+
+  // Queue a thread for each genome.
+  for (auto const& [genome_id, genome_vector] : merge_genome_map) {
+
+    auto genome_opt = getCreateGenome(genome_id);
     if (not genome_opt) {
 
-      ExecEnv::log().error("PopulationDB::addUniqueVariant; Could not add/create genome: {}", genome);
+      ExecEnv::log().error("PopulationDB::mergePopulations; Could not add/create genome: {}", genome_id);
       continue;
+
     }
 
-    variant_count += genome_opt.value()->mergeGenome(genome_ptr);
+    std::future<size_t> future = thread_pool.enqueueTask(&GenomeDB::mergeGenomes, genome_opt.value(), genome_vector);
+    future_vector.push_back(std::move(future));
+
+  }
+
+  size_t variant_count = 0;
+  for (auto& future : future_vector) {
+
+    variant_count += future.get();
 
   }
 
@@ -35,9 +35,14 @@ class PopulationDB : public DataDB {
 public:
 
   explicit PopulationDB(const PopulationId_t& population_id, DataSourceEnum data_source) : DataDB(data_source),
-                                                                                           population_id_(population_id) {}
+                                                                                           population_id_(population_id) {
+    SubsystemMemory::allocate(MemorySubsystem::DATABASE_NODE, nodeBytes());
+  }
   PopulationDB(const PopulationDB&) = delete; // Use deep copy.
-  ~PopulationDB() override { clear(); }  // Experimental, may be quicker than relying on smart pointer reference counting.
+  ~PopulationDB() override {
+    clear();  // Experimental, may be quicker than relying on smart pointer reference counting.
+    SubsystemMemory::deallocate(MemorySubsystem::DATABASE_NODE, nodeBytes());
+  }
 
   // Preferred to fieldId().
   [[nodiscard]] const std::string& populationId() const { return population_id_; }
@@ -60,6 +65,9 @@ public:
   // Total variants held in this population, not unique variants.
   [[nodiscard]] size_t variantCount() const;
 
+  // Walks the genomes (multi-threaded) to estimate the memory used by the population.
+  [[nodiscard]] DBMemoryFootprint memoryFootprint() const;
+
   // Creates a filtered copy of the population database.
   // We can multi-thread because smart pointer reference counting (only) is thread safe.
   [[nodiscard]] std::shared_ptr<PopulationDB> filterVariants(const VariantFilter& filter) const;
@@ -83,7 +91,9 @@ public:
                                  const std::vector<GenomeId_t>& genome_vector);
 
   // unconditionally merge (retains duplicates) genomes and variants into this population.
-  [[nodiscard]] size_t mergePopulation(const std::shared_ptr<const PopulationDB>& merge_population);
+  [[nodiscard]] size_t mergePopulation(const std::shared_ptr<const PopulationDB>& merge_population) { return mergePopulations({merge_population}); }
+  // Bulk merge of several populations (e.g. chromosome or cohort files), genomes are merged in parallel.
+  [[nodiscard]] size_t mergePopulations(const std::vector<std::shared_ptr<const PopulationDB>>& merge_populations);
   // Validate returns a pair<size_t, size_t>. The first integer is the number of variants examined.
   // The second integer is the number variants that pass inspection by comparison to the reference genome.
   [[nodiscard]] std::pair<size_t, size_t> validate(const std::shared_ptr<const GenomeReference>& genome_db) const;
@@ -110,6 +120,9 @@ private:
   // mutex to lock the structure when performing an inSituFilter.
   mutable std::mutex insitufilter_mutex_;
 
+  // Estimated size of the population object, the genomes are counted separately.
+  [[nodiscard]] size_t nodeBytes() const { return sizeof(PopulationDB) + SubsystemMemory::stringHeapBytes(population_id_.size()); }
+
 };
 
 // General purpose population processing template.
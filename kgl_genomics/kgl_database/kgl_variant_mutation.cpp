@@ -15,6 +15,17 @@ bool kgl::VariantMutation::mutateDNA(const OffsetVariantMap& variant_map,
                                      const std::shared_ptr<const CodingSequence>& coding_sequence_ptr,
                                      DNA5SequenceCoding& dna_sequence) {
 
+  return mutateDNA(variant_map, contig_ptr, SequenceOffset::codingExonOffsets(coding_sequence_ptr), dna_sequence);
+
+}
+
+
+bool kgl::VariantMutation::mutateDNA(const OffsetVariantMap& variant_map,
+                                     const std::shared_ptr<const ContigReference>& contig_ptr,
+                                     const CodingExonOffsets& reference_offsets,
+                                     DNA5SequenceCoding& dna_sequence) {
+
+  const std::shared_ptr<const CodingSequence>& coding_sequence_ptr = reference_offsets.codingSequence();
 
   // Mutate unstranded DNA and then convert to STRANDED DNA
   ContigSize_t sequence_size = coding_sequence_ptr->end() - coding_sequence_ptr->start();
@@ -30,7 +41,7 @@ bool kgl::VariantMutation::mutateDNA(const OffsetVariantMap& variant_map,
   }
 
   // Convert to stranded DNA.
-  dna_sequence = kgl::SequenceOffset::mutantCodingSubSequence( coding_sequence_ptr,
+  dna_sequence = kgl::SequenceOffset::mutantCodingSubSequence( reference_offsets,
                                                                unstranded,
                                                                variant_mutation_offset_,
                                                                0,
@@ -26,6 +26,7 @@ namespace kellerberrin::genome {   //  organization level namespace
 
 
 using OffsetVariantMap = std::map<ContigOffset_t, std::shared_ptr<const Variant>>;
+class CodingExonOffsets;
 
 
 class VariantMutation {
@@ -41,6 +42,12 @@ public:
                                 const std::shared_ptr<const CodingSequence>& coding_sequence_ptr,
                                 DNA5SequenceCoding &dna_sequence);
 
+  // As above, using the previously generated reference exon offsets of the coding sequence.
+  [[nodiscard]] bool mutateDNA( const OffsetVariantMap &variant_map,
+                                const std::shared_ptr<const ContigReference>& contig_ptr,
+                                const CodingExonOffsets& reference_offsets,
+                                DNA5SequenceCoding &dna_sequence);
+
   [[nodiscard]] bool mutateDNA( const OffsetVariantMap &insert_variant_map,
                                 const std::shared_ptr<const ContigReference>& contig_ptr,
                                 const ContigOffset_t contig_offset,
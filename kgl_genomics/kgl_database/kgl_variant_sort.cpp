@@ -290,3 +290,236 @@ std::shared_ptr<kgl::VariantGenomeIndexMap> kgl::VariantSort::variantGenomeIndex
 }
 
 
+
+// Each contig is partitioned by key hash into the index shards.
+kgl::ShardPartition kgl::VariantSort::partitionContig( std::shared_ptr<const ContigDB> contig_ptr,
+                                                       const IndexKeyFactory& key_factory,
+                                                       size_t shard_count) {
+
+  ShardPartition partition(shard_count);
+  IndexKeyFunction key_function = key_factory();
+  std::vector<std::string> key_vector;
+
+  for (auto const& [offset, offset_ptr] : contig_ptr->getMap()) {
+
+    for (auto const& variant_ptr : offset_ptr->getVariantArray()) {
+
+      key_vector.clear();
+      key_function(*variant_ptr, key_vector);
+      for (auto& key : key_vector) {
+
+        const size_t shard = VariantHashIndex::shardIndex(VariantHashIndex::keyHash(key), shard_count);
+        partition[shard].push_back({std::move(key), variant_ptr});
+
+      }
+
+    }
+
+  }
+
+  return partition;
+
+}
+
+
+// A task for each contig partitions the keyed variants, then each index shard is built by a separate thread.
+std::shared_ptr<const kgl::VariantHashIndex> kgl::VariantSort::createHashIndex(const std::vector<std::shared_ptr<const ContigDB>>& contig_vector,
+                                                                               const IndexKeyFactory& key_factory,
+                                                                               size_t max_threads) {
+
+  size_t thread_count = std::max<size_t>(1, max_threads);
+  thread_count = std::min(thread_count, ThreadPool::defaultThreads());
+  const size_t shard_count = VariantHashIndex::shardCount(thread_count);
+
+  std::vector<ShardPartition> partition_vector;
+  partition_vector.reserve(contig_vector.size());
+
+  {
+
+    ThreadPool thread_pool(std::max<size_t>(1, std::min(thread_count, contig_vector.size())));
+    std::vector<std::future<ShardPartition>> future_vector;
+    for (auto const& contig_ptr : contig_vector) {
+
+      future_vector.push_back(thread_pool.enqueueTask(&VariantSort::partitionContig, contig_ptr, std::cref(key_factory), shard_count));
+
+    }
+
+    // Retrieved in contig order so that the index is deterministic.
+    for (auto& future : future_vector) {
+
+      partition_vector.push_back(future.get());
+
+    }
+
+  }
+
+  return std::make_shared<const VariantHashIndex>(std::move(partition_vector), shard_count, thread_count);
+
+}
+
+
+kgl::VariantSort::IndexKeyFactory kgl::VariantSort::variantIdKeys() {
+
+  return []() -> IndexKeyFunction {
+
+    return [](const Variant& variant, std::vector<std::string>& key_vector) {
+
+      if (not variant.identifier().empty()) {
+
+        key_vector.push_back(variant.identifier());
+
+      }
+
+    };
+
+  };
+
+}
+
+
+std::shared_ptr<const kgl::EnsemblHashIndex> kgl::VariantSort::ensemblHashIndex(const std::shared_ptr<const PopulationDB>& population_ptr,
+                                                                                 const std::vector<std::string>& ensembl_gene_list,
+                                                                                 size_t max_threads) {
+
+  std::vector<std::shared_ptr<const ContigDB>> contig_vector;
+  for (auto const& [genome_id, genome_ptr] : population_ptr->getMap()) {
+
+    for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
+
+      contig_vector.push_back(contig_ptr);
+
+    }
+
+  }
+
+  auto ensembl_gene_set = std::make_shared<const std::set<std::string>>(ensembl_gene_list.begin(), ensembl_gene_list.end());
+
+  // The vep field indexes are looked up once per task.
+  IndexKeyFactory key_factory = [ensembl_gene_set]() -> IndexKeyFunction {
+
+    return [ensembl_gene_set, field_index = VepIndexVector(), initialized = false](const Variant& variant, std::vector<std::string>& key_vector) mutable {
+
+      if (not initialized) {
+
+        field_index = InfoEvidenceAnalysis::getVepIndexes(variant, std::vector<std::string>{VEP_ENSEMBL_FIELD_});
+        initialized = true;
+
+      }
+
+      // Only unique gene idents.
+      for (auto const& field : InfoEvidenceAnalysis::getVepData(variant, field_index)) {
+
+        // Only 1 field in the map.
+        if (not field.empty()) {
+
+          const auto& [field_ident, field_value] = *field.begin();
+          if (not field_value.empty()
+              and (ensembl_gene_set->empty() or ensembl_gene_set->contains(field_value))
+              and std::find(key_vector.begin(), key_vector.end(), field_value) == key_vector.end()) {
+
+            key_vector.push_back(field_value);
+
+          }
+
+        }
+
+      }
+
+    };
+
+  };
+
+  return createHashIndex(contig_vector, key_factory, max_threads);
+
+}
+
+
+std::shared_ptr<const kgl::VariantIdHashIndex> kgl::VariantSort::variantIdHashIndex(const std::shared_ptr<const PopulationDB>& population_ptr,
+                                                                                    size_t max_threads) {
+
+  std::vector<std::shared_ptr<const ContigDB>> contig_vector;
+  for (auto const& [genome_id, genome_ptr] : population_ptr->getMap()) {
+
+    for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
+
+      contig_vector.push_back(contig_ptr);
+
+    }
+
+  }
+
+  return createHashIndex(contig_vector, variantIdKeys(), max_threads);
+
+}
+
+
+// A thread for each genome, each genome index is a single shard.
+std::shared_ptr<kgl::VariantGenomeHashIndex> kgl::VariantSort::variantGenomeHashIndex(const std::shared_ptr<const PopulationDB>& population_ptr,
+                                                                                      size_t max_threads) {
+
+  struct GenomeIndex {
+
+    static std::shared_ptr<const VariantIdHashIndex> indexGenome(std::shared_ptr<const GenomeDB> genome_ptr) {
+
+      IndexKeyFunction key_function = variantIdKeys()();
+      std::vector<std::string> key_vector;
+      KeyedVariantVector entry_vector;
+
+      for (auto const& [contig_id, contig_ptr] : genome_ptr->getMap()) {
+
+        for (auto const& [offset, offset_ptr] : contig_ptr->getMap()) {
+
+          for (auto const& variant_ptr : offset_ptr->getVariantArray()) {
+
+            key_vector.clear();
+            key_function(*variant_ptr, key_vector);
+            for (auto& key : key_vector) {
+
+              entry_vector.push_back({std::move(key), variant_ptr});
+
+            }
+
+          }
+
+        }
+
+      }
+
+      return std::make_shared<const VariantIdHashIndex>(std::move(entry_vector));
+
+    }
+
+  };
+
+  // Thread count strategy
+  size_t thread_count = std::max<size_t>(1, max_threads);
+  thread_count = std::min(thread_count, ThreadPool::defaultThreads());
+  thread_count = std::max<size_t>(1, std::min( thread_count, population_ptr->getMap().size()));
+  ThreadPool thread_pool(thread_count);
+
+  using GenomeIndexFuture = std::future<std::shared_ptr<const VariantIdHashIndex>>;
+  std::vector<std::pair<std::string, GenomeIndexFuture>> future_vector;
+
+  for (auto const&[genome_id, genome_ptr] : population_ptr->getMap()) {
+
+    GenomeIndexFuture future = thread_pool.enqueueTask(&GenomeIndex::indexGenome, genome_ptr);
+    future_vector.emplace_back(genome_id, std::move(future));
+
+  }
+
+  std::shared_ptr<VariantGenomeHashIndex> genome_index_map(std::make_shared<VariantGenomeHashIndex>());
+  for (auto& [genome_id, genome_future] : future_vector) {
+
+    auto [iter, result] = genome_index_map->try_emplace(genome_id, genome_future.get());
+    if (not result) {
+
+      ExecEnv::log().error("VariantSort::variantGenomeHashIndex; Unable to add (duplicate) genome: {}", genome_id);
+
+    }
+
+  }
+
+  return genome_index_map;
+
+}
+
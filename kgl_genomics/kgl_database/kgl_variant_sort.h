@@ -8,10 +8,12 @@
 
 #include "kgl_variant.h"
 #include "kgl_variant_db_population.h"
+#include "kgl_variant_sort_index.h"
 
 #include <map>
 #include <string>
 #include <memory>
+#include <functional>
 
 
 namespace kellerberrin::genome {   //  organization::project level namespace
@@ -32,6 +34,15 @@ using VariantIdIndexMap = std::map<std::string, std::shared_ptr<const Variant>>;
 // Variants indexed by genome and then by variant id ('rsXXXXXXXXX').
 using VariantGenomeIndexMap = std::map<std::string,  std::shared_ptr<VariantIdIndexMap>>;
 
+// Hashed variants indexed by their Ensembl gene id retrieved from the vep field.
+using EnsemblHashIndex = VariantHashIndex;
+
+// Hashed variants indexed by their variant id ('rsXXXXXXXXX'), duplicate ids are retained.
+using VariantIdHashIndex = VariantHashIndex;
+
+// Hashed variants indexed by genome and then by variant id ('rsXXXXXXXXX').
+using VariantGenomeHashIndex = std::map<std::string,  std::shared_ptr<const VariantIdHashIndex>>;
+
 
 // Static only functions, object cannot be created.
 class VariantSort {
@@ -61,8 +72,33 @@ public:
   [[nodiscard]] static std::shared_ptr<VariantGenomeIndexMap> variantGenomeIndexMT(const std::shared_ptr<const PopulationDB>& population_ptr,
                                                                                    size_t max_threads = ThreadPool::defaultThreads());
 
+  // Hashed indexes are built in parallel using a task for each genome contig.
+  // Ensembl gene ids are read from the vep field, an empty gene list indexes all variants.
+  [[nodiscard]] static std::shared_ptr<const EnsemblHashIndex> ensemblHashIndex(const std::shared_ptr<const PopulationDB>& population_ptr,
+                                                                                const std::vector<std::string>& ensembl_gene_list = {},
+                                                                                size_t max_threads = ThreadPool::defaultThreads());
+
+  [[nodiscard]] static std::shared_ptr<const VariantIdHashIndex> variantIdHashIndex(const std::shared_ptr<const PopulationDB>& population_ptr,
+                                                                                    size_t max_threads = ThreadPool::defaultThreads());
+
+  [[nodiscard]] static std::shared_ptr<VariantGenomeHashIndex> variantGenomeHashIndex(const std::shared_ptr<const PopulationDB>& population_ptr,
+                                                                                      size_t max_threads = ThreadPool::defaultThreads());
+
 private:
 
+  // Appends the index keys of a variant to the key vector.
+  using IndexKeyFunction = std::function<void(const Variant&, std::vector<std::string>&)>;
+  // Each indexing task obtains its own (possibly stateful) key function.
+  using IndexKeyFactory = std::function<IndexKeyFunction()>;
+
+  [[nodiscard]] static std::shared_ptr<const VariantHashIndex> createHashIndex(const std::vector<std::shared_ptr<const ContigDB>>& contig_vector,
+                                                                               const IndexKeyFactory& key_factory,
+                                                                               size_t max_threads);
+  [[nodiscard]] static ShardPartition partitionContig( std::shared_ptr<const ContigDB> contig_ptr,
+                                                       const IndexKeyFactory& key_factory,
+                                                       size_t shard_count);
+  [[nodiscard]] static IndexKeyFactory variantIdKeys();
+
   constexpr static const char* VEP_ENSEMBL_FIELD_ = "Gene";
   constexpr static const size_t PMR_BUFFER_SIZE_ = 4096;
 
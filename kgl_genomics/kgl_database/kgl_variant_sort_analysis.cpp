@@ -15,14 +15,9 @@ kgl::EnsemblIndexMap  kgl::SortedVariantAnalysis::filterEnsembl(const std::vecto
 
   for (auto const& ensembl_code : ensembl_list) {
 
-    auto lower_bound = ensembl_index_map_->lower_bound(ensembl_code);
-    auto upper_bound = ensembl_index_map_->upper_bound(ensembl_code);
+    for (auto const& variant_ptr : ensembl_index_ptr_->find(ensembl_code)) {
 
-    while(lower_bound != upper_bound) {
-
-      filtered_map.insert(*lower_bound);
-
-      ++lower_bound;
+      filtered_map.emplace(ensembl_code, variant_ptr);
 
     }
 
@@ -24,18 +24,18 @@ class SortedVariantAnalysis {
 public:
 
   explicit SortedVariantAnalysis(const std::shared_ptr<const PopulationDB>& population_ptr)
-    : ensembl_index_map_(VariantSort::ensemblIndex(population_ptr)) {}
+    : ensembl_index_ptr_(VariantSort::ensemblHashIndex(population_ptr)) {}
   ~SortedVariantAnalysis() = default;
 
-  // Access the ensembl map.
-  [[nodiscard]] const std::shared_ptr<const EnsemblIndexMap>& ensemblMap() const { return ensembl_index_map_; }
+  // Access the ensembl index.
+  [[nodiscard]] const std::shared_ptr<const EnsemblHashIndex>& ensemblIndex() const { return ensembl_index_ptr_; }
   // Filter on on list of Ensembl Codes.
   [[nodiscard]] EnsemblIndexMap filterEnsembl(const std::vector<std::string>& ensembl_list) const;
 
 private:
 
   // A population of variants indexed by Ensembl gene code from the vep field.
-  const std::shared_ptr<const EnsemblIndexMap> ensembl_index_map_;
+  const std::shared_ptr<const EnsemblHashIndex> ensembl_index_ptr_;
 
 
 };
@@ -0,0 +1,212 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_variant_sort_index.h"
+#include "kel_thread_pool.h"
+
+#include <bit>
+#include <limits>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+
+kgl::VariantHashIndex::VariantHashIndex(KeyedVariantVector&& entry_vector) {
+
+  std::vector<ShardPartition> partition_vector(1);
+  partition_vector.front().push_back(std::move(entry_vector));
+
+  shard_vector_.resize(1);
+  buildShard(0, partition_vector);
+  updateCounts();
+
+}
+
+
+kgl::VariantHashIndex::VariantHashIndex(std::vector<ShardPartition>&& partition_vector, size_t shard_count, size_t max_threads) {
+
+  shard_count = std::max<size_t>(1, shard_count);
+  for (auto const& partition : partition_vector) {
+
+    if (partition.size() != shard_count) {
+
+      ExecEnv::log().error("VariantHashIndex::VariantHashIndex; partition size: {} does not match shard count: {}, index is empty",
+                           partition.size(), shard_count);
+      return;
+
+    }
+
+  }
+
+  shard_vector_.resize(shard_count);
+
+  size_t thread_count = std::max<size_t>(1, max_threads);
+  thread_count = std::min(thread_count, shard_count);
+  ThreadPool thread_pool(thread_count);
+
+  // Shards are disjoint, each thread reads only its own shard entries from the partitions.
+  std::vector<std::future<bool>> future_vector;
+  for (size_t shard = 0; shard < shard_count; ++shard) {
+
+    future_vector.push_back(thread_pool.enqueueTask(&VariantHashIndex::buildShard, this, shard, std::ref(partition_vector)));
+
+  }
+
+  for (auto& future : future_vector) {
+
+    if (not future.get()) {
+
+      ExecEnv::log().error("VariantHashIndex::VariantHashIndex; problem building index shard");
+
+    }
+
+  }
+
+  updateCounts();
+
+}
+
+
+void kgl::VariantHashIndex::updateCounts() {
+
+  variant_count_ = 0;
+  key_count_ = 0;
+  for (auto const& shard : shard_vector_) {
+
+    variant_count_ += shard.variant_vector.size();
+    key_count_ += shard.key_vector.size();
+
+  }
+
+}
+
+
+bool kgl::VariantHashIndex::buildShard(size_t shard, std::vector<ShardPartition>& partition_vector) {
+
+  // Gather the shard entries in partition order.
+  std::vector<std::pair<size_t, KeyedVariant*>> entry_vector;
+  size_t entry_count{0};
+  for (auto const& partition : partition_vector) {
+
+    entry_count += partition[shard].size();
+
+  }
+  entry_vector.reserve(entry_count);
+
+  for (auto& partition : partition_vector) {
+
+    for (auto& entry : partition[shard]) {
+
+      entry_vector.emplace_back(keyHash(entry.key), &entry);
+
+    }
+
+  }
+
+  // Group identical keys, the sort is stable so variants retain partition order.
+  std::stable_sort(entry_vector.begin(), entry_vector.end(), [](const auto& lhs, const auto& rhs) {
+
+    if (lhs.first != rhs.first) return lhs.first < rhs.first;
+    return lhs.second->key < rhs.second->key;
+
+  });
+
+  IndexShard& index_shard = shard_vector_[shard];
+  index_shard.variant_vector.reserve(entry_vector.size());
+
+  for (auto& [hash, entry_ptr] : entry_vector) {
+
+    if (index_shard.key_vector.empty() or hash != index_shard.hash_vector.back() or entry_ptr->key != index_shard.key_vector.back()) {
+
+      // The key is interned once, the entries are consumed.
+      index_shard.variant_offset.push_back(index_shard.variant_vector.size());
+      index_shard.hash_vector.push_back(hash);
+      index_shard.key_vector.push_back(std::move(entry_ptr->key));
+
+    }
+
+    index_shard.variant_vector.push_back(std::move(entry_ptr->variant_ptr));
+
+  }
+  index_shard.variant_offset.push_back(index_shard.variant_vector.size());
+
+  // Release the consumed entries.
+  for (auto& partition : partition_vector) {
+
+    KeyedVariantVector().swap(partition[shard]);
+
+  }
+
+  const size_t key_count = index_shard.key_vector.size();
+  if (key_count == 0) {
+
+    return true;
+
+  }
+
+  if (key_count >= std::numeric_limits<SlotIndex>::max()) {
+
+    ExecEnv::log().error("VariantHashIndex::buildShard; shard key count: {} exceeds the slot index limit", key_count);
+    return false;
+
+  }
+
+  // Linear probing table with a power of 2 size.
+  const size_t slot_count = std::bit_ceil(key_count * SLOT_LOAD_FACTOR_);
+  index_shard.slot_vector.assign(slot_count, 0);
+  index_shard.slot_mask = slot_count - 1;
+
+  for (size_t key_index = 0; key_index < key_count; ++key_index) {
+
+    size_t slot = index_shard.hash_vector[key_index] & index_shard.slot_mask;
+    while (index_shard.slot_vector[slot] != 0) {
+
+      slot = (slot + 1) & index_shard.slot_mask;
+
+    }
+    index_shard.slot_vector[slot] = static_cast<SlotIndex>(key_index + 1);
+
+  }
+
+  return true;
+
+}
+
+
+kgl::VariantSpan kgl::VariantHashIndex::find(std::string_view key) const {
+
+  if (shard_vector_.empty()) {
+
+    return {};
+
+  }
+
+  const size_t hash = keyHash(key);
+  const IndexShard& index_shard = shard_vector_[shardIndex(hash, shard_vector_.size())];
+  if (index_shard.slot_vector.empty()) {
+
+    return {};
+
+  }
+
+  size_t slot = hash & index_shard.slot_mask;
+  while (index_shard.slot_vector[slot] != 0) {
+
+    const size_t key_index = index_shard.slot_vector[slot] - 1;
+    if (index_shard.hash_vector[key_index] == hash and index_shard.key_vector[key_index] == key) {
+
+      const size_t begin = index_shard.variant_offset[key_index];
+      return { index_shard.variant_vector.data() + begin, index_shard.variant_offset[key_index + 1] - begin };
+
+    }
+
+    slot = (slot + 1) & index_shard.slot_mask;
+
+  }
+
+  return {};
+
+}
+
@@ -0,0 +1,133 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_VARIANT_SORT_INDEX_H
+#define KGL_VARIANT_SORT_INDEX_H
+
+
+#include "kgl_variant.h"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <memory>
+
+
+namespace kellerberrin::genome {   //  organization::project level namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// A flat open-addressing hash index of variants. Keys (Ensembl gene ids, variant ids etc.) are interned once
+// per index and the variants of each key are held contiguously so that a lookup returns a span.
+// The index is partitioned into shards by key hash. Indexing tasks partition their entries by shard
+// so that each shard can be built by a separate thread without locking. The index is immutable once built.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// A key and the indexed variant.
+struct KeyedVariant {
+
+  std::string key;
+  std::shared_ptr<const Variant> variant_ptr;
+
+};
+
+using KeyedVariantVector = std::vector<KeyedVariant>;
+// The entries of an indexing task partitioned by shard, the vector size is the index shard count.
+using ShardPartition = std::vector<KeyedVariantVector>;
+// The variants indexed by a key.
+using VariantSpan = std::span<const std::shared_ptr<const Variant>>;
+
+
+class VariantHashIndex {
+
+public:
+
+  // Single shard index built on the calling thread.
+  explicit VariantHashIndex(KeyedVariantVector&& entry_vector);
+  // Built from task partitions, each shard is built by a separate thread.
+  // The variants of a key are held in partition order, and within a partition, in insertion order.
+  VariantHashIndex(std::vector<ShardPartition>&& partition_vector, size_t shard_count, size_t max_threads);
+  VariantHashIndex(const VariantHashIndex&) = delete;
+  ~VariantHashIndex() = default;
+
+  VariantHashIndex& operator=(const VariantHashIndex&) = delete;
+
+  // All variants indexed by the key, an empty span if the key is not present.
+  [[nodiscard]] VariantSpan find(std::string_view key) const;
+  [[nodiscard]] bool contains(std::string_view key) const { return not find(key).empty(); }
+
+  // Total indexed variants.
+  [[nodiscard]] size_t size() const { return variant_count_; }
+  // Total unique keys.
+  [[nodiscard]] size_t keyCount() const { return key_count_; }
+  [[nodiscard]] size_t shardCount() const { return shard_vector_.size(); }
+
+  // Visit all keys as visit(const std::string& key, VariantSpan variants), keys are not visited in sorted order.
+  template<typename Func> void visitAll(Func&& visit) const;
+
+  // Used by indexing tasks to partition entries.
+  [[nodiscard]] static size_t keyHash(std::string_view key) { return std::hash<std::string_view>{}(key); }
+  [[nodiscard]] static size_t shardIndex(size_t key_hash, size_t shard_count) { return (key_hash >> SHARD_HASH_SHIFT_) % shard_count; }
+  // Shard count for a given number of indexing threads.
+  [[nodiscard]] static size_t shardCount(size_t max_threads) { return std::max<size_t>(1, max_threads) * SHARDS_PER_THREAD_; }
+
+private:
+
+  // Empty slots are zero, otherwise the slot holds the key index + 1.
+  using SlotIndex = uint32_t;
+
+  struct IndexShard {
+
+    std::vector<std::string> key_vector;
+    std::vector<size_t> hash_vector;
+    // Size is key_vector.size() + 1, the variants of key i are [variant_offset[i], variant_offset[i+1]).
+    std::vector<size_t> variant_offset;
+    std::vector<std::shared_ptr<const Variant>> variant_vector;
+    std::vector<SlotIndex> slot_vector;
+    size_t slot_mask{0};
+
+  };
+
+  std::vector<IndexShard> shard_vector_;
+  size_t variant_count_{0};
+  size_t key_count_{0};
+
+  // Builds a shard from the entries of all partitions that hash to the shard.
+  bool buildShard(size_t shard, std::vector<ShardPartition>& partition_vector);
+  void updateCounts();
+
+  // Top bits select the shard, low bits select the probe slot.
+  constexpr static const size_t SHARD_HASH_SHIFT_{40};
+  constexpr static const size_t SHARDS_PER_THREAD_{4};
+  // Slot table size is at least this multiple of the key count.
+  constexpr static const size_t SLOT_LOAD_FACTOR_{2};
+
+};
+
+
+template<typename Func>
+void VariantHashIndex::visitAll(Func&& visit) const {
+
+  for (auto const& shard : shard_vector_) {
+
+    for (size_t key_index = 0; key_index < shard.key_vector.size(); ++key_index) {
+
+      const size_t begin = shard.variant_offset[key_index];
+      const size_t count = shard.variant_offset[key_index + 1] - begin;
+      visit(shard.key_vector[key_index], VariantSpan(shard.variant_vector.data() + begin, count));
+
+    }
+
+  }
+
+}
+
+
+
+} // namespace
+
+#endif //KGL_VARIANT_SORT_INDEX_H
@@ -4,6 +4,7 @@
 
 #include "kgl_variant_factory_vcf_evidence_data_blk.h"
 #include "kgl_variant_factory_vcf_evidence.h"
+#include "kgl_variant_db_memory.h"
 #include "kel_utility.h"
 
 #include <algorithm>
@@ -85,6 +86,8 @@ kgl::DataMemoryBlock::DataMemoryBlock( std::shared_ptr<const InfoEvidenceHeader>
   }
 
   ++object_count_;
+  SubsystemMemory::allocate(MemorySubsystem::INFO_DATA, dataBytes());
+  SubsystemMemory::allocate(MemorySubsystem::INFO_STRING, stringBytes());
 
 }
 
@@ -92,6 +95,24 @@ kgl::DataMemoryBlock::DataMemoryBlock( std::shared_ptr<const InfoEvidenceHeader>
 kgl::DataMemoryBlock::~DataMemoryBlock() {
 
   --object_count_;
+  SubsystemMemory::deallocate(MemorySubsystem::INFO_DATA, dataBytes());
+  SubsystemMemory::deallocate(MemorySubsystem::INFO_STRING, stringBytes());
+
+}
+
+
+size_t kgl::DataMemoryBlock::dataBytes() const {
+
+  return sizeof(DataMemoryBlock) + (mem_count_.integerCount() * sizeof(InfoIntegerType))
+                                 + (mem_count_.floatCount() * sizeof(InfoFloatType))
+                                 + (mem_count_.arrayCount() * sizeof(InfoArrayIndex));
+
+}
+
+
+size_t kgl::DataMemoryBlock::stringBytes() const {
+
+  return (mem_count_.charCount() * sizeof(char)) + (mem_count_.stringCount() * sizeof(std::string_view));
 
 }
 
@@ -58,6 +58,11 @@ public:
 
   [[nodiscard]] static size_t objectCount() { return object_count_; }
 
+  // Estimated memory of the object and its numeric and array index data.
+  [[nodiscard]] size_t dataBytes() const;
+  // Memory of the evidence strings, the char data and string views.
+  [[nodiscard]] size_t stringBytes() const;
+
 private:
 
 
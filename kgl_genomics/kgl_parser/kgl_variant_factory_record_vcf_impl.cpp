@@ -40,11 +40,15 @@ kgl::ParseVCFRecord::ParseVCFRecord( const VcfRecord& vcf_record,
 
   contig_ptr_ = contig_opt.value();
 
-  const DNA5SequenceLinear contig_ref = contig_ptr_->sequence().subSequence(allele_offset_, reference_.length());
-  if (contig_ref.getSequenceAsString() != reference_) {
+  // Compared in place, the contig region is only copied for the error message.
+  auto contig_ref = contig_ptr_->sequence().subView(allele_offset_, reference_.length());
+  auto compare_base = [](DNA5::Alphabet base, char reference_char) { return static_cast<char>(base) == reference_char; };
+  if (not std::ranges::equal(contig_ref, reference_, compare_base)) {
 
+    std::string contig_ref_string;
+    std::transform(contig_ref.begin(), contig_ref.end(), std::back_inserter(contig_ref_string), DNA5::convertToChar);
     ExecEnv::log().error("ParseVCFRecord::parseRecord; Variant reference: {} does not match Contig region: {} at offset: {}",
-                         reference_, contig_ref.getSequenceAsString(), allele_offset_);
+                         reference_, contig_ref_string, allele_offset_);
     parse_result_ = false;
     return;
 
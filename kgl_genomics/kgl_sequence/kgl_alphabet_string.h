@@ -13,6 +13,7 @@
 #include "kgl_genome_types.h"
 #include "kgl_alphabet_dna5.h"
 #include "kgl_alphabet_amino.h"
+#include "kgl_sequence_motif.h"
 
 
 namespace kellerberrin::genome {   //  organization level namespace
@@ -30,7 +31,7 @@ class AlphabetString {
 public:
 
   AlphabetString() = default;
-  AlphabetString(AlphabetString<Alphabet>&& alphabet_string) noexcept : base_string_(alphabet_string.base_string_) {}
+  AlphabetString(AlphabetString<Alphabet>&& alphabet_string) noexcept : base_string_(std::move(alphabet_string.base_string_)) {}
   AlphabetString(const AlphabetString<Alphabet>& alphabet_string) : base_string_(alphabet_string.base_string_) {}
   explicit AlphabetString(const std::string& alphabet_str) { convertFromCharString(alphabet_str); }
   ~AlphabetString() = default;
@@ -41,7 +42,7 @@ public:
   // Only allow move assignments
   AlphabetString& operator=(AlphabetString&& moved) noexcept {
 
-    base_string_ = moved.base_string_;
+    base_string_ = std::move(moved.base_string_);
     return *this;
 
   }
@@ -59,6 +60,9 @@ public:
   void pop_back() { base_string_.pop_back(); }
 
 
+  // A view of the underlying symbols, valid until the string is modified.
+  [[nodiscard]] std::basic_string_view<typename Alphabet::Alphabet> view() const { return base_string_; }
+
   [[nodiscard]] ContigSize_t length() const { return base_string_.length(); }
   [[nodiscard]] bool empty() const { return base_string_.empty(); }
 
@@ -144,18 +148,42 @@ public:
 
   bool operator==(const AlphabetString& compare_string) const { return (base_string_ == compare_string.base_string_); }
 
+  // All (overlapping) offsets of the sub string, found in a single pass of the Aho-Corasick automaton.
   std::vector<ContigOffset_t> findAll(const AlphabetString& sub_string) const {
 
     std::vector<ContigOffset_t> offset_vector;
-    size_t offset = base_string_.find(sub_string.base_string_);
+    if (sub_string.empty()) {
+
+      // The empty string is found at every offset.
+      for (size_t offset = 0; offset <= base_string_.length(); ++offset) {
+
+        offset_vector.push_back(static_cast<ContigOffset_t>(offset));
 
-    while (offset != std::basic_string<Alphabet>::npos) {
+      }
 
-      offset_vector.push_back(static_cast<ContigOffset_t>(offset));
-      offset = base_string_.find(sub_string.base_string_, offset + 1);
+      return offset_vector;
 
     }
 
+    MotifAutomaton<Alphabet> automaton;
+    if (not automaton.addMotif(sub_string.view())) {
+
+      // Symbols not enumerated by the alphabet (amino acids U and O) are searched directly.
+      size_t offset = base_string_.find(sub_string.base_string_);
+      while (offset != std::basic_string<typename Alphabet::Alphabet>::npos) {
+
+        offset_vector.push_back(static_cast<ContigOffset_t>(offset));
+        offset = base_string_.find(sub_string.base_string_, offset + 1);
+
+      }
+
+      return offset_vector;
+
+    }
+
+    automaton.build();
+    automaton.search(view(), [&offset_vector](size_t, ContigOffset_t offset) { offset_vector.push_back(offset); });
+
     return offset_vector;
 
   }
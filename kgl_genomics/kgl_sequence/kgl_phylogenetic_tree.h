@@ -10,6 +10,8 @@
 #include <map>
 #include <vector>
 #include <fstream>
+#include <optional>
+#include <string>
 
 #include "kel_exec_env.h"
 
@@ -23,6 +25,8 @@ namespace kellerberrin::genome {   //  organization level namespace
 
 using DistanceType_t = double;
 
+class SequenceDistance; // fwd.
+
 class VirtualDistanceNode {
 
 public:
@@ -40,6 +44,10 @@ public:
   // This function is only re-defined and used if the distance metric needs to set a particular
   // condition for a zero distance. Most distance metrics will not need to re-define this function.
   [[nodiscard]] virtual bool zeroDistance(std::shared_ptr<const VirtualDistanceNode> node) const;
+  // Nodes that are compared using a single sequence can have their distances calculated as a batch.
+  // If all nodes share the same batch metric then the distance matrix is calculated by SequenceDistance::batchDistance().
+  [[nodiscard]] virtual std::optional<std::string> batchSequence() const { return std::nullopt; }
+  [[nodiscard]] virtual const SequenceDistance* batchMetric() const { return nullptr; }
 
 private:
 
@@ -0,0 +1,344 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_sequence_align_kernel.h"
+#include "kel_exec_env.h"
+
+#include <cctype>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Substitution matrices.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+kgl::SubstitutionMatrix::SubstitutionMatrix(const std::string& alphabet, const std::vector<AlignScore_t>& score_vector, char wildcard)
+: alphabet_size_(alphabet.size()), score_vector_(score_vector) {
+
+  if (score_vector_.size() != alphabet_size_ * alphabet_size_) {
+
+    ExecEnv::log().critical("SubstitutionMatrix::SubstitutionMatrix; alphabet size: {} does not match score matrix size: {}",
+                            alphabet_size_, score_vector_.size());
+
+  }
+
+  size_t wildcard_code = alphabet.find(wildcard);
+  if (wildcard_code == std::string::npos) {
+
+    ExecEnv::log().critical("SubstitutionMatrix::SubstitutionMatrix; wildcard symbol: {} not in alphabet: {}", wildcard, alphabet);
+
+  }
+
+  code_map_.fill(wildcard_code);
+  for (size_t code = 0; code < alphabet.size(); ++code) {
+
+    const auto symbol = static_cast<unsigned char>(alphabet[code]);
+    code_map_[symbol] = code;
+    code_map_[static_cast<unsigned char>(std::tolower(symbol))] = code;
+
+  }
+
+}
+
+
+const kgl::SubstitutionMatrix& kgl::SubstitutionMatrix::blosum80() {
+
+  static const SubstitutionMatrix blosum80_matrix("ARNDCQEGHILKMFPSTWYVBZX*",
+    { 7, -3, -3, -3, -1, -2, -2,  0, -3, -3, -3, -1, -2, -4, -1,  2,  0, -5, -4, -1, -3, -2, -1, -8,
+     -3,  9, -1, -3, -6,  1, -1, -4,  0, -5, -4,  3, -3, -5, -3, -2, -2, -5, -4, -4, -2,  0, -2, -8,
+     -3, -1,  9,  2, -5,  0, -1, -1,  1, -6, -6,  0, -4, -6, -4,  1,  0, -7, -4, -5,  5, -1, -2, -8,
+     -3, -3,  2, 10, -7, -1,  2, -3, -2, -7, -7, -2, -6, -6, -3, -1, -2, -8, -6, -6,  6,  1, -3, -8,
+     -1, -6, -5, -7, 13, -5, -7, -6, -7, -2, -3, -6, -3, -4, -6, -2, -2, -5, -5, -2, -6, -7, -4, -8,
+     -2,  1,  0, -1, -5,  9,  3, -4,  1, -5, -4,  2, -1, -5, -3, -1, -1, -4, -3, -4, -1,  5, -2, -8,
+     -2, -1, -1,  2, -7,  3,  8, -4,  0, -6, -6,  1, -4, -6, -2, -1, -2, -6, -5, -4,  1,  6, -2, -8,
+      0, -4, -1, -3, -6, -4, -4,  9, -4, -7, -7, -3, -5, -6, -5, -1, -3, -6, -6, -6, -2, -4, -3, -8,
+     -3,  0,  1, -2, -7,  1,  0, -4, 12, -6, -5, -1, -4, -2, -4, -2, -3, -4,  3, -5, -1,  0, -2, -8,
+     -3, -5, -6, -7, -2, -5, -6, -7, -6,  7,  2, -5,  2, -1, -5, -4, -2, -5, -3,  4, -6, -6, -2, -8,
+     -3, -4, -6, -7, -3, -4, -6, -7, -5,  2,  6, -4,  3,  0, -5, -4, -3, -4, -2,  1, -7, -5, -2, -8,
+     -1,  3,  0, -2, -6,  2,  1, -3, -1, -5, -4,  8, -3, -5, -2, -1, -1, -6, -4, -4, -1,  1, -2, -8,
+     -2, -3, -4, -6, -3, -1, -4, -5, -4,  2,  3, -3,  9,  0, -4, -3, -1, -3, -3,  1, -5, -3, -2, -8,
+     -4, -5, -6, -6, -4, -5, -6, -6, -2, -1,  0, -5,  0, 10, -6, -4, -4,  0,  4, -2, -6, -6, -3, -8,
+     -1, -3, -4, -3, -6, -3, -2, -5, -4, -5, -5, -2, -4, -6, 12, -2, -3, -7, -6, -4, -4, -2, -3, -8,
+      2, -2,  1, -1, -2, -1, -1, -1, -2, -4, -4, -1, -3, -4, -2,  7,  2, -6, -3, -3,  0, -1, -1, -8,
+      0, -2,  0, -2, -2, -1, -2, -3, -3, -2, -3, -1, -1, -4, -3,  2,  8, -5, -3,  0, -1, -2, -1, -8,
+     -5, -5, -7, -8, -5, -4, -6, -6, -4, -5, -4, -6, -3,  0, -7, -6, -5, 16,  3, -5, -8, -5, -5, -8,
+     -4, -4, -4, -6, -5, -3, -5, -6,  3, -3, -2, -4, -3,  4, -6, -3, -3,  3, 11, -3, -5, -4, -3, -8,
+     -1, -4, -5, -6, -2, -4, -4, -6, -5,  4,  1, -4,  1, -2, -4, -3,  0, -5, -3,  7, -6, -4, -2, -8,
+     -3, -2,  5,  6, -6, -1,  1, -2, -1, -6, -7, -1, -5, -6, -4,  0, -1, -8, -5, -6,  6,  0, -3, -8,
+     -2,  0, -1,  1, -7,  5,  6, -4,  0, -6, -5,  1, -3, -6, -2, -1, -2, -5, -4, -4,  0,  6, -1, -8,
+     -1, -2, -2, -3, -4, -2, -2, -3, -2, -2, -2, -2, -2, -3, -3, -1, -1, -5, -3, -2, -3, -1, -2, -8,
+     -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8, -8,  1 },
+    'X');
+
+  return blosum80_matrix;
+
+}
+
+
+kgl::SubstitutionMatrix kgl::SubstitutionMatrix::nucleotide(AlignScore_t match, AlignScore_t mismatch) {
+
+  const std::string alphabet{"ACGTN"};
+  const size_t wildcard_code = alphabet.size() - 1;
+  std::vector<AlignScore_t> score_vector(alphabet.size() * alphabet.size(), mismatch);
+  for (size_t code = 0; code < wildcard_code; ++code) {
+
+    score_vector[(code * alphabet.size()) + code] = match;
+
+  }
+
+  return SubstitutionMatrix(alphabet, score_vector, alphabet[wildcard_code]);
+
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Striped alignment kernel.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+kgl::StripedAlignKernel::AlignWorkspace& kgl::StripedAlignKernel::workspace() {
+
+  thread_local AlignWorkspace align_workspace;
+  return align_workspace;
+
+}
+
+
+void kgl::StripedAlignKernel::laneMax(LaneVector& result, const LaneVector& operand) {
+
+  for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+
+    result[lane] = std::max(result[lane], operand[lane]);
+
+  }
+
+}
+
+
+void kgl::StripedAlignKernel::laneAdd(LaneVector& result, const LaneVector& operand) {
+
+  for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+
+    result[lane] += operand[lane];
+
+  }
+
+}
+
+
+void kgl::StripedAlignKernel::laneSub(LaneVector& result, AlignScore_t operand) {
+
+  for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+
+    result[lane] -= operand;
+
+  }
+
+}
+
+
+kgl::StripedAlignKernel::LaneVector kgl::StripedAlignKernel::laneShift(const LaneVector& operand, AlignScore_t insert) {
+
+  LaneVector result;
+  result[0] = insert;
+  for (size_t lane = 1; lane < LANE_COUNT; ++lane) {
+
+    result[lane] = operand[lane - 1];
+
+  }
+
+  return result;
+
+}
+
+
+bool kgl::StripedAlignKernel::laneAnyGreater(const LaneVector& lhs, const LaneVector& rhs) {
+
+  bool greater{false};
+  for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+
+    greater = greater or (lhs[lane] > rhs[lane]);
+
+  }
+
+  return greater;
+
+}
+
+
+kgl::AlignScore_t kgl::StripedAlignKernel::boundaryScore(size_t index, const AffineGap& affine_gap, AlignMode mode) {
+
+  if (mode == AlignMode::LOCAL or index == 0) {
+
+    return 0;
+
+  }
+
+  // The boundary gap follows the same recurrence as the interior cells, a gap can be re-opened.
+  const AlignScore_t boundary_extend = std::min(affine_gap.gap_open, affine_gap.gap_extend);
+  return -(affine_gap.gap_open + (static_cast<AlignScore_t>(index - 1) * boundary_extend));
+
+}
+
+
+// Query row (l * segment_length) + k is held in lane l of segment vector k, rows past the query end score zero.
+void kgl::StripedAlignKernel::queryProfile( const std::string& query,
+                                            const SubstitutionMatrix& matrix,
+                                            size_t segment_length,
+                                            AlignWorkspace& workspace) {
+
+  workspace.query_profile.resize(matrix.alphabetSize() * segment_length);
+  for (size_t symbol = 0; symbol < matrix.alphabetSize(); ++symbol) {
+
+    for (size_t segment = 0; segment < segment_length; ++segment) {
+
+      LaneVector& profile = workspace.query_profile[(symbol * segment_length) + segment];
+      for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+
+        const size_t row = (lane * segment_length) + segment;
+        profile[lane] = row < query.size() ? matrix.score(matrix.symbolCode(query[row]), symbol) : 0;
+
+      }
+
+    }
+
+  }
+
+}
+
+
+// Farrar's striped algorithm. H is the alignment score, E the horizontal gap score (gap in the query)
+// and F the vertical gap score (gap in the target). Vertical gaps crossing segment boundaries are
+// resolved by the 'lazy F' loop, which terminates as soon as F can no longer change any H value.
+kgl::AlignScore_t kgl::StripedAlignKernel::alignScore( const std::string& query,
+                                                       const std::string& target,
+                                                       const SubstitutionMatrix& matrix,
+                                                       const AffineGap& affine_gap,
+                                                       AlignMode mode) {
+
+  const bool local = mode == AlignMode::LOCAL;
+  if (query.empty() or target.empty()) {
+
+    return boundaryScore(query.size() + target.size(), affine_gap, mode);
+
+  }
+
+  const size_t segment_length = (query.size() + LANE_COUNT - 1) / LANE_COUNT;
+  AlignWorkspace& align_workspace = workspace();
+  queryProfile(query, matrix, segment_length, align_workspace);
+
+  align_workspace.H_load.resize(segment_length);
+  align_workspace.H_store.resize(segment_length);
+  align_workspace.E.resize(segment_length);
+  for (size_t segment = 0; segment < segment_length; ++segment) {
+
+    for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+
+      const size_t row = (lane * segment_length) + segment;
+      const AlignScore_t row_boundary = boundaryScore(row + 1, affine_gap, mode);
+      align_workspace.H_load[segment][lane] = row_boundary;
+      align_workspace.E[segment][lane] = row_boundary - affine_gap.gap_open;
+
+    }
+
+  }
+
+  LaneVector zero_vector;
+  zero_vector.fill(0);
+  LaneVector max_vector;
+  max_vector.fill(0);
+
+  for (size_t column = 1; column <= target.size(); ++column) {
+
+    const LaneVector* profile = &align_workspace.query_profile[matrix.symbolCode(target[column - 1]) * segment_length];
+    std::vector<LaneVector>& H_load = align_workspace.H_load;
+    std::vector<LaneVector>& H_store = align_workspace.H_store;
+    std::vector<LaneVector>& E = align_workspace.E;
+
+    LaneVector F;
+    F.fill(NEGATIVE_INFINITY_);
+    F[0] = boundaryScore(column, affine_gap, mode) - affine_gap.gap_open;
+    LaneVector H = laneShift(H_load[segment_length - 1], boundaryScore(column - 1, affine_gap, mode));
+
+    for (size_t segment = 0; segment < segment_length; ++segment) {
+
+      laneAdd(H, profile[segment]);
+      laneMax(H, E[segment]);
+      laneMax(H, F);
+      if (local) {
+
+        laneMax(H, zero_vector);
+        laneMax(max_vector, H);
+
+      }
+      H_store[segment] = H;
+
+      laneSub(H, affine_gap.gap_open);
+      laneSub(E[segment], affine_gap.gap_extend);
+      laneMax(E[segment], H);
+      laneSub(F, affine_gap.gap_extend);
+      laneMax(F, H);
+
+      H = H_load[segment];
+
+    }
+
+    // Lazy F, at most one pass per lane boundary.
+    bool converged{false};
+    for (size_t pass = 0; pass < LANE_COUNT and not converged; ++pass) {
+
+      F = laneShift(F, NEGATIVE_INFINITY_);
+      for (size_t segment = 0; segment < segment_length; ++segment) {
+
+        LaneVector H_open = H_store[segment];
+        laneSub(H_open, affine_gap.gap_open);
+        if (not laneAnyGreater(F, H_open)) {
+
+          converged = true;
+          break;
+
+        }
+
+        laneMax(H_store[segment], F);
+        if (local) {
+
+          laneMax(max_vector, H_store[segment]);
+
+        }
+        H_open = H_store[segment];
+        laneSub(H_open, affine_gap.gap_open);
+        laneMax(E[segment], H_open);
+        laneSub(F, affine_gap.gap_extend);
+        laneMax(F, H_open);
+
+      }
+
+    }
+
+    std::swap(H_load, H_store);
+
+  }
+
+  if (local) {
+
+    AlignScore_t max_score{0};
+    for (auto lane_score : max_vector) {
+
+      max_score = std::max(max_score, lane_score);
+
+    }
+
+    return max_score;
+
+  }
+
+  // Global score is the last query row of the last column.
+  const size_t last_row = query.size() - 1;
+  return align_workspace.H_load[last_row % segment_length][last_row / segment_length];
+
+}
@@ -0,0 +1,127 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_SEQUENCE_ALIGN_KERNEL_H
+#define KGL_SEQUENCE_ALIGN_KERNEL_H
+
+
+#include "kgl_genome_types.h"
+
+#include <vector>
+#include <string>
+#include <array>
+#include <limits>
+
+
+namespace kellerberrin::genome {   //  organization level namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// A symbol substitution score matrix, characters are mapped to dense symbol codes.
+// Characters not in the alphabet are mapped to the wildcard symbol (X for amino acids and N for DNA).
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using AlignScore_t = int32_t;
+
+class SubstitutionMatrix {
+
+public:
+
+  SubstitutionMatrix(const std::string& alphabet, const std::vector<AlignScore_t>& score_vector, char wildcard);
+  ~SubstitutionMatrix() = default;
+
+  [[nodiscard]] size_t alphabetSize() const { return alphabet_size_; }
+  [[nodiscard]] size_t symbolCode(char symbol) const { return code_map_[static_cast<unsigned char>(symbol)]; }
+  [[nodiscard]] AlignScore_t score(size_t code_a, size_t code_b) const { return score_vector_[(code_a * alphabet_size_) + code_b]; }
+
+  // NCBI BLOSUM80 (1/3 bit units), alphabet "ARNDCQEGHILKMFPSTWYVBZX*".
+  [[nodiscard]] static const SubstitutionMatrix& blosum80();
+  // Nucleotide match/mismatch matrix, alphabet "ACGTN", N mismatches all symbols.
+  [[nodiscard]] static SubstitutionMatrix nucleotide(AlignScore_t match, AlignScore_t mismatch);
+
+private:
+
+  size_t alphabet_size_;
+  std::vector<AlignScore_t> score_vector_;
+  std::array<size_t, 256> code_map_;
+
+};
+
+
+// Gap penalties are positive, a gap of length k scores -(gap_open + ((k - 1) * gap_extend)).
+// As in Gotoh (and seqan), a gap can be re-opened from any cell, so if gap_open < gap_extend
+// a gap of length k scores -(k * gap_open).
+struct AffineGap {
+
+  AlignScore_t gap_open;
+  AlignScore_t gap_extend;
+
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Farrar striped affine gap alignment score (Smith-Waterman local and Needleman-Wunsch global).
+// The query is laid out in LANE_COUNT interleaved segments so that each target column is processed as
+// vector operations on segment lanes, the lane loops are written to be vectorized by the compiler.
+// The query profile and DP columns are held in a thread local workspace that is reused between calls.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum class AlignMode { GLOBAL, LOCAL };
+
+// Static only functions, object cannot be created.
+class StripedAlignKernel {
+
+public:
+
+  StripedAlignKernel() = delete;
+  ~StripedAlignKernel() = delete;
+
+  // Optimal alignment score of the query and target.
+  [[nodiscard]] static AlignScore_t alignScore( const std::string& query,
+                                                const std::string& target,
+                                                const SubstitutionMatrix& matrix,
+                                                const AffineGap& affine_gap,
+                                                AlignMode mode);
+
+  // Lanes in a striped vector, 8 x 32 bit matches a 256 bit SIMD register.
+  constexpr static const size_t LANE_COUNT{8};
+
+private:
+
+  using LaneVector = std::array<AlignScore_t, LANE_COUNT>;
+
+  // Reusable DP storage, only grows.
+  struct AlignWorkspace {
+
+    std::vector<LaneVector> query_profile;    // [(symbol * segment_length) + segment]
+    std::vector<LaneVector> H_load;
+    std::vector<LaneVector> H_store;
+    std::vector<LaneVector> E;
+
+  };
+
+  [[nodiscard]] static AlignWorkspace& workspace();
+  static void queryProfile(const std::string& query, const SubstitutionMatrix& matrix, size_t segment_length, AlignWorkspace& workspace);
+  // Row 0 (boundary) score of a column.
+  [[nodiscard]] static AlignScore_t boundaryScore(size_t index, const AffineGap& affine_gap, AlignMode mode);
+
+  static void laneMax(LaneVector& result, const LaneVector& operand);
+  static void laneAdd(LaneVector& result, const LaneVector& operand);
+  static void laneSub(LaneVector& result, AlignScore_t operand);
+  // Shift lanes up by one, lane 0 is set to the insert value.
+  [[nodiscard]] static LaneVector laneShift(const LaneVector& operand, AlignScore_t insert);
+  // True if any lane of lhs is greater than rhs.
+  [[nodiscard]] static bool laneAnyGreater(const LaneVector& lhs, const LaneVector& rhs);
+
+  // Large negative value that will not overflow when penalties are subtracted.
+  constexpr static const AlignScore_t NEGATIVE_INFINITY_{std::numeric_limits<AlignScore_t>::min() / 4};
+
+};
+
+
+
+}   // end namespace
+
+
+#endif //KGL_SEQUENCE_ALIGN_KERNEL_H
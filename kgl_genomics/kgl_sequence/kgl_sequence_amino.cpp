@@ -66,19 +66,9 @@ kgl::AminoSequence kgl::AminoSequence::subSequence( ContigOffset_t sub_sequence_
 
 kgl::AminoSequence kgl::TranslateToAmino::getAminoSequence(const DNA5SequenceCoding& coding_sequence) const {
 
-  StringAminoAcid protein_string;
-  AminoAcid::Alphabet amino_acid;
+  CodonTranslation translation = table_ptr_->translateSequence(coding_sequence);
 
-  protein_string.reserve(Codon::codonLength(coding_sequence));
-
-  for (size_t index = 0; index < Codon::codonLength(coding_sequence); ++index) {
-
-    amino_acid = table_ptr_->getAmino(Codon(coding_sequence,index));
-    protein_string.push_back(amino_acid);
-
-  }
-
-  return AminoSequence(std::move(protein_string));
+  return AminoSequence(std::move(translation.amino_string));
 
 }
 
@@ -96,6 +96,9 @@ public:
 
   [[nodiscard]] AminoSequence getAminoSequence(const DNA5SequenceCoding& coding_sequence) const;
 
+  // Single pass translation, also checks the start, stop and nonsense codons.
+  [[nodiscard]] CodonTranslation translateSequence(const DNA5SequenceCoding& coding_sequence) const { return table_ptr_->translateSequence(coding_sequence); }
+
   [[nodiscard]] AminoSequence getAminoSequence( const std::shared_ptr<const CodingSequence>& coding_seq_ptr,
                                                 const DNA5SequenceContig& contig_sequence) const;
 
@@ -8,8 +8,11 @@
 #include "kgl_genome_types.h"
 #include "kgl_sequence_virtual.h"
 #include "kgl_sequence_distance_impl.h"
+#include "kgl_sequence_distance_batch.h"
 #include "kgl_sequence_amino.h"
 
+#include <optional>
+
 
 namespace kellerberrin::genome {   //  organization::project level namespace
 
@@ -40,6 +43,10 @@ public:
 
   [[nodiscard]] virtual std::string distanceType() const = 0;
 
+  // All-pairs distances of the sequences, indexed in the order of the sequence vector.
+  // Returns std::nullopt if the distance metric has no batch implementation.
+  [[nodiscard]] virtual std::optional<PackedDistanceMatrix> batchDistance(const std::vector<std::string>& /* sequence_vector */) const { return std::nullopt; }
+
 protected:
 
   [[nodiscard]] virtual CompareDistance_t distanceImpl( const VirtualSequence& sequenceA,
@@ -180,6 +187,11 @@ public:
 
   [[nodiscard]] std::string distanceType() const override { return "Levenshtein Global"; }
 
+  [[nodiscard]] std::optional<PackedDistanceMatrix> batchDistance(const std::vector<std::string>& sequence_vector) const override {
+
+    return BatchLevenshtein::distanceMatrix(sequence_vector, LevenshteinMode::GLOBAL);
+
+  }
 
 
 protected:
@@ -208,6 +220,12 @@ public:
 
   [[nodiscard]] std::string distanceType() const override { return "Levenshtein Local"; }
 
+  [[nodiscard]] std::optional<PackedDistanceMatrix> batchDistance(const std::vector<std::string>& sequence_vector) const override {
+
+    return BatchLevenshtein::distanceMatrix(sequence_vector, LevenshteinMode::LOCAL);
+
+  }
+
 protected:
 
   [[nodiscard]] CompareDistance_t distanceImpl( const VirtualSequence& sequenceA,
@@ -0,0 +1,312 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_sequence_distance_batch.h"
+
+#include <bit>
+#include <numeric>
+#include <algorithm>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+
+kgl::PackedDistanceMatrix kgl::BatchLevenshtein::distanceMatrix(const std::vector<std::string>& sequence_vector,
+                                                                LevenshteinMode mode,
+                                                                size_t max_threads) {
+
+  PackedDistanceMatrix distance_matrix(sequence_vector.size());
+  if (sequence_vector.size() < 2) {
+
+    return distance_matrix;
+
+  }
+
+  EncodedBatch encoded_batch = encodeBatch(sequence_vector);
+
+  // Patterns are always compared to texts of equal or greater length.
+  // For local distance the shorter sequence must be the pattern, this also keeps the pattern blocks small.
+  // Equal length sequences use the later sequence as the pattern, as SequenceDistanceImpl::LevenshteinLocal(row, column).
+  std::vector<size_t> length_order(sequence_vector.size());
+  std::iota(length_order.begin(), length_order.end(), 0);
+  std::sort(length_order.begin(), length_order.end(), [&sequence_vector](size_t lhs, size_t rhs) {
+    if (sequence_vector[lhs].size() != sequence_vector[rhs].size()) return sequence_vector[lhs].size() < sequence_vector[rhs].size();
+    return lhs > rhs;
+  });
+
+  size_t thread_count = std::max<size_t>(1, max_threads);
+  thread_count = std::min(thread_count, ThreadPool::defaultThreads());
+  ThreadPool thread_pool(thread_count);
+  std::vector<std::future<bool>> future_vector;
+
+  // Each tile writes a disjoint set of matrix elements.
+  for (size_t pattern_rank = 0; pattern_rank < length_order.size(); ++pattern_rank) {
+
+    for (size_t text_begin = pattern_rank + 1; text_begin < length_order.size(); text_begin += TILE_TEXTS) {
+
+      const size_t text_end = std::min(text_begin + TILE_TEXTS, length_order.size());
+      future_vector.push_back(thread_pool.enqueueTask(&BatchLevenshtein::tileDistance,
+                                                      std::cref(encoded_batch),
+                                                      std::cref(length_order),
+                                                      pattern_rank,
+                                                      text_begin,
+                                                      text_end,
+                                                      mode,
+                                                      std::ref(distance_matrix)));
+
+    }
+
+  }
+
+  for (auto& future : future_vector) {
+
+    if (not future.get()) {
+
+      ExecEnv::log().error("BatchLevenshtein::distanceMatrix; problem calculating distance matrix tile");
+
+    }
+
+  }
+
+  return distance_matrix;
+
+}
+
+
+size_t kgl::BatchLevenshtein::editDistance(const std::string& sequence_a, const std::string& sequence_b, LevenshteinMode mode) {
+
+  // Sequence a is the pattern if the sequences are of equal length.
+  auto distance_matrix = distanceMatrix({sequence_b, sequence_a}, mode, 1);
+  return static_cast<size_t>(distance_matrix.getDistance(0, 1));
+
+}
+
+
+kgl::BatchLevenshtein::EncodedBatch kgl::BatchLevenshtein::encodeBatch(const std::vector<std::string>& sequence_vector) {
+
+  constexpr static const SymbolCode NO_CODE{std::numeric_limits<SymbolCode>::max()};
+  std::array<SymbolCode, 256> code_map;
+  code_map.fill(NO_CODE);
+
+  EncodedBatch encoded_batch;
+  encoded_batch.encoded_vector.reserve(sequence_vector.size());
+
+  for (auto const& sequence : sequence_vector) {
+
+    EncodedSequence encoded;
+    encoded.reserve(sequence.size());
+    for (auto symbol : sequence) {
+
+      SymbolCode& code = code_map[static_cast<unsigned char>(symbol)];
+      if (code == NO_CODE) {
+
+        code = static_cast<SymbolCode>(encoded_batch.alphabet_size);
+        ++encoded_batch.alphabet_size;
+
+      }
+      encoded.push_back(code);
+
+    }
+
+    encoded_batch.encoded_vector.push_back(std::move(encoded));
+
+  }
+
+  return encoded_batch;
+
+}
+
+
+kgl::BatchLevenshtein::PatternBlocks kgl::BatchLevenshtein::patternBlocks(const EncodedSequence& pattern, size_t alphabet_size) {
+
+  PatternBlocks pattern_blocks;
+  pattern_blocks.pattern_length = pattern.size();
+  pattern_blocks.block_count = std::max<size_t>(1, (pattern.size() + BLOCK_BITS_ - 1) / BLOCK_BITS_);
+  // The additional (zero) symbol row is the padding symbol.
+  pattern_blocks.peq.assign((alphabet_size + 1) * pattern_blocks.block_count, 0);
+
+  for (size_t row = 0; row < pattern.size(); ++row) {
+
+    const size_t block = row / BLOCK_BITS_;
+    const size_t bit = row % BLOCK_BITS_;
+    pattern_blocks.peq[(pattern[row] * pattern_blocks.block_count) + block] |= static_cast<BitVector>(1) << bit;
+
+  }
+
+  return pattern_blocks;
+
+}
+
+
+bool kgl::BatchLevenshtein::tileDistance( const EncodedBatch& encoded_batch,
+                                          const std::vector<size_t>& length_order,
+                                          size_t pattern_rank,
+                                          size_t text_begin,
+                                          size_t text_end,
+                                          LevenshteinMode mode,
+                                          PackedDistanceMatrix& distance_matrix) {
+
+  const size_t pattern_index = length_order[pattern_rank];
+  const PatternBlocks pattern = patternBlocks(encoded_batch.encoded_vector[pattern_index], encoded_batch.alphabet_size);
+
+  LaneTexts lane_texts{};
+  LaneDistances lane_distances{};
+
+  for (size_t lane_begin = text_begin; lane_begin < text_end; lane_begin += LANE_COUNT) {
+
+    const size_t lane_count = std::min(LANE_COUNT, text_end - lane_begin);
+    for (size_t lane = 0; lane < lane_count; ++lane) {
+
+      lane_texts[lane] = &encoded_batch.encoded_vector[length_order[lane_begin + lane]];
+
+    }
+
+    laneDistance(pattern, lane_texts, lane_count, encoded_batch.alphabet_size, mode, lane_distances);
+
+    for (size_t lane = 0; lane < lane_count; ++lane) {
+
+      distance_matrix.setDistance(pattern_index, length_order[lane_begin + lane], static_cast<CompareDistance_t>(lane_distances[lane]));
+
+    }
+
+  }
+
+  return true;
+
+}
+
+
+// Block based Myers/Hyyro bit-vector edit distance (as used by edlib), each lane holds the state of a separate text.
+// For each text column and pattern block the vertical deltas (Pv, Mv) are updated and the horizontal delta
+// at the bottom of the block is carried into the next block.
+// Global (NW) alignment has a horizontal delta of +1 entering the first block, local (HW) has zero.
+void kgl::BatchLevenshtein::laneDistance( const PatternBlocks& pattern,
+                                          const LaneTexts& lane_texts,
+                                          size_t lane_count,
+                                          size_t pad_symbol,
+                                          LevenshteinMode mode,
+                                          LaneDistances& lane_distances) {
+
+  const size_t pattern_length = pattern.pattern_length;
+  const bool global = mode == LevenshteinMode::GLOBAL;
+
+  size_t max_text_length{0};
+  for (size_t lane = 0; lane < lane_count; ++lane) {
+
+    max_text_length = std::max(max_text_length, lane_texts[lane]->size());
+    // Zero length text.
+    lane_distances[lane] = pattern_length;
+
+  }
+
+  if (pattern_length == 0) {
+
+    for (size_t lane = 0; lane < lane_count; ++lane) {
+
+      lane_distances[lane] = global ? lane_texts[lane]->size() : 0;
+
+    }
+    return;
+
+  }
+
+  const size_t block_count = pattern.block_count;
+  std::vector<BitVector> Pv(block_count * LANE_COUNT, ~static_cast<BitVector>(0));
+  std::vector<BitVector> Mv(block_count * LANE_COUNT, 0);
+  std::vector<int64_t> score(block_count * LANE_COUNT);
+  for (size_t block = 0; block < block_count; ++block) {
+
+    for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+
+      score[(block * LANE_COUNT) + lane] = static_cast<int64_t>((block + 1) * BLOCK_BITS_);
+
+    }
+
+  }
+
+  // Bits of the last block that are below the pattern (padding rows).
+  const size_t last_block = block_count - 1;
+  const size_t last_row_bits = pattern_length - (last_block * BLOCK_BITS_);
+  const BitVector pad_mask = last_row_bits == BLOCK_BITS_ ? 0 : ~static_cast<BitVector>(0) << last_row_bits;
+
+  std::array<const BitVector*, LANE_COUNT> lane_peq{};
+  std::array<BitVector, LANE_COUNT> hin_pos{};
+  std::array<BitVector, LANE_COUNT> hin_neg{};
+
+  for (size_t column = 0; column < max_text_length; ++column) {
+
+    for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+
+      // Inactive lanes and completed texts are padded.
+      const size_t symbol = (lane < lane_count and column < lane_texts[lane]->size()) ? (*lane_texts[lane])[column] : pad_symbol;
+      lane_peq[lane] = &pattern.peq[symbol * block_count];
+      hin_pos[lane] = global ? 1 : 0;
+      hin_neg[lane] = 0;
+
+    }
+
+    for (size_t block = 0; block < block_count; ++block) {
+
+      BitVector* block_Pv = &Pv[block * LANE_COUNT];
+      BitVector* block_Mv = &Mv[block * LANE_COUNT];
+      int64_t* block_score = &score[block * LANE_COUNT];
+
+      for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+
+        BitVector Eq = lane_peq[lane][block];
+        const BitVector Xv = Eq | block_Mv[lane];
+        Eq |= hin_neg[lane];
+        const BitVector Xh = (((Eq & block_Pv[lane]) + block_Pv[lane]) ^ block_Pv[lane]) | Eq;
+        BitVector Ph = block_Mv[lane] | ~(Xh | block_Pv[lane]);
+        BitVector Mh = block_Pv[lane] & Xh;
+
+        const BitVector hout_pos = (Ph & HIGH_BIT_) >> (BLOCK_BITS_ - 1);
+        const BitVector hout_neg = (Mh & HIGH_BIT_) >> (BLOCK_BITS_ - 1);
+
+        Ph = (Ph << 1) | hin_pos[lane];
+        Mh = (Mh << 1) | hin_neg[lane];
+        block_Pv[lane] = Mh | ~(Xv | Ph);
+        block_Mv[lane] = Ph & Xv;
+
+        block_score[lane] += static_cast<int64_t>(hout_pos) - static_cast<int64_t>(hout_neg);
+        hin_pos[lane] = hout_pos;
+        hin_neg[lane] = hout_neg;
+
+      }
+
+    }
+
+    // The score of the last pattern row is the block score less the vertical deltas of the padding rows.
+    for (size_t lane = 0; lane < lane_count; ++lane) {
+
+      if (column >= lane_texts[lane]->size()) {
+
+        continue;
+
+      }
+
+      const size_t state = (last_block * LANE_COUNT) + lane;
+      const int64_t row_score = score[state] - std::popcount(Pv[state] & pad_mask) + std::popcount(Mv[state] & pad_mask);
+
+      if (global) {
+
+        if (column + 1 == lane_texts[lane]->size()) {
+
+          lane_distances[lane] = static_cast<size_t>(row_score);
+
+        }
+
+      } else {
+
+        lane_distances[lane] = std::min(lane_distances[lane], static_cast<size_t>(row_score));
+
+      }
+
+    }
+
+  }
+
+}
+
@@ -0,0 +1,172 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_SEQUENCE_DISTANCE_BATCH_H
+#define KGL_SEQUENCE_DISTANCE_BATCH_H
+
+
+#include "kgl_genome_types.h"
+#include "kel_thread_pool.h"
+
+#include <vector>
+#include <string>
+#include <array>
+#include <new>
+
+
+namespace kellerberrin::genome {   //  organization level namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Allocates storage aligned to a cache line, so that large distance arrays do not straddle cache lines.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+class CacheAlignedAllocator {
+
+public:
+
+  using value_type = T;
+
+  CacheAlignedAllocator() noexcept = default;
+  template<typename U> CacheAlignedAllocator(const CacheAlignedAllocator<U>&) noexcept {}
+  ~CacheAlignedAllocator() = default;
+
+  [[nodiscard]] T* allocate(size_t count) { return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{CACHE_LINE_BYTES})); }
+  void deallocate(T* ptr, size_t) noexcept { ::operator delete(ptr, std::align_val_t{CACHE_LINE_BYTES}); }
+
+  template<typename U> bool operator==(const CacheAlignedAllocator<U>&) const noexcept { return true; }
+  template<typename U> bool operator!=(const CacheAlignedAllocator<U>&) const noexcept { return false; }
+
+  constexpr static const size_t CACHE_LINE_BYTES{64};
+
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// A symmetric distance matrix with a zero diagonal, only the strict lower triangle is stored (row major).
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using PackedDistanceVector = std::vector<CompareDistance_t, CacheAlignedAllocator<CompareDistance_t>>;
+
+class PackedDistanceMatrix {
+
+public:
+
+  explicit PackedDistanceMatrix(size_t matrix_size = 0) : matrix_size_(matrix_size), packed_distances_(packedSize(matrix_size), 0.0) {}
+  PackedDistanceMatrix(const PackedDistanceMatrix&) = default;
+  PackedDistanceMatrix(PackedDistanceMatrix&&) noexcept = default;
+  ~PackedDistanceMatrix() = default;
+
+  PackedDistanceMatrix& operator=(const PackedDistanceMatrix&) = default;
+  PackedDistanceMatrix& operator=(PackedDistanceMatrix&&) noexcept = default;
+
+  [[nodiscard]] size_t size() const { return matrix_size_; }
+  // d(i, j) = d(j, i) and d(i, i) = 0.
+  [[nodiscard]] CompareDistance_t getDistance(size_t i, size_t j) const { return i == j ? 0.0 : packed_distances_[packedIndex(i, j)]; }
+  // Setting the diagonal is ignored.
+  void setDistance(size_t i, size_t j, CompareDistance_t distance) { if (i != j) packed_distances_[packedIndex(i, j)] = distance; }
+
+  [[nodiscard]] const PackedDistanceVector& packedDistances() const { return packed_distances_; }
+  [[nodiscard]] PackedDistanceVector& packedDistances() { return packed_distances_; }
+
+  [[nodiscard]] static size_t packedSize(size_t matrix_size) { return matrix_size < 2 ? 0 : (matrix_size * (matrix_size - 1)) / 2; }
+  [[nodiscard]] static size_t packedIndex(size_t i, size_t j) { return i > j ? ((i * (i - 1)) / 2) + j : ((j * (j - 1)) / 2) + i; }
+
+private:
+
+  size_t matrix_size_;
+  PackedDistanceVector packed_distances_;
+
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// All-pairs Levenshtein (edit) distance using the Myers/Hyyro bit-vector algorithm.
+// The pattern (row) sequence is encoded once per tile and compared against several text sequences
+// simultaneously, each text occupies a lane of the bit-vector state so that the lane loops can be vectorized.
+// Tiles of the distance matrix are calculated in parallel.
+// Global distance is the edit distance of the two sequences (edlib NW).
+// Local distance is the edit distance of the shorter sequence aligned anywhere within the longer sequence (edlib HW).
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum class LevenshteinMode { GLOBAL, LOCAL };
+
+// Static only functions, object cannot be created.
+class BatchLevenshtein {
+
+public:
+
+  BatchLevenshtein() = delete;
+  ~BatchLevenshtein() = delete;
+
+  // The returned matrix is indexed in the order of the sequence vector.
+  // Local distances of equal length sequences use the later sequence (row) as the pattern.
+  [[nodiscard]] static PackedDistanceMatrix distanceMatrix(const std::vector<std::string>& sequence_vector,
+                                                           LevenshteinMode mode,
+                                                           size_t max_threads = ThreadPool::defaultThreads());
+
+  // A single pair, the shorter sequence (or sequence_a) is the pattern for local distance.
+  [[nodiscard]] static size_t editDistance(const std::string& sequence_a, const std::string& sequence_b, LevenshteinMode mode);
+
+  // Texts compared simultaneously against a pattern.
+  constexpr static const size_t LANE_COUNT{4};
+  // Texts (matrix columns) in a tile task.
+  constexpr static const size_t TILE_TEXTS{64};
+
+private:
+
+  using BitVector = uint64_t;
+  using SymbolCode = uint16_t;
+  using EncodedSequence = std::vector<SymbolCode>;
+
+  // Sequences encoded with a dense alphabet, the code alphabet_size is a padding symbol that matches nothing.
+  struct EncodedBatch {
+
+    std::vector<EncodedSequence> encoded_vector;
+    size_t alphabet_size{0};
+
+  };
+
+  // The pattern match bit-vectors (Peq) for each symbol, peq[(symbol * block_count) + block].
+  struct PatternBlocks {
+
+    size_t pattern_length{0};
+    size_t block_count{0};
+    std::vector<BitVector> peq;
+
+  };
+
+  using LaneTexts = std::array<const EncodedSequence*, LANE_COUNT>;
+  using LaneDistances = std::array<size_t, LANE_COUNT>;
+
+  [[nodiscard]] static EncodedBatch encodeBatch(const std::vector<std::string>& sequence_vector);
+  [[nodiscard]] static PatternBlocks patternBlocks(const EncodedSequence& pattern, size_t alphabet_size);
+  // Distance of the pattern to the (lane_count) texts.
+  static void laneDistance( const PatternBlocks& pattern,
+                            const LaneTexts& lane_texts,
+                            size_t lane_count,
+                            size_t pad_symbol,
+                            LevenshteinMode mode,
+                            LaneDistances& lane_distances);
+  // Distances of the pattern (by length rank) to the texts [text_begin, text_end) by length rank.
+  static bool tileDistance( const EncodedBatch& encoded_batch,
+                            const std::vector<size_t>& length_order,
+                            size_t pattern_rank,
+                            size_t text_begin,
+                            size_t text_end,
+                            LevenshteinMode mode,
+                            PackedDistanceMatrix& distance_matrix);
+
+  constexpr static const size_t BLOCK_BITS_{64};
+  constexpr static const BitVector HIGH_BIT_{static_cast<BitVector>(1) << (BLOCK_BITS_ - 1)};
+
+};
+
+
+
+}   // end namespace
+
+
+#endif //KGL_SEQUENCE_DISTANCE_BATCH_H
@@ -8,10 +8,9 @@
 #include <tuple>                        // for std::make_pair
 #include <iterator>
 #include <string>
+#include <array>
 //#include <span>
 
-#include <seqan/align.h>
-#include <seqan/graph_msa.h>
 
 #include <seqan3/alphabet/all.hpp>
 #include <seqan3/std/ranges>                    // include all of the standard library's views
@@ -23,6 +22,7 @@
 #include <edlib.h>
 
 #include "kgl_sequence_distance_impl.h"
+#include "kgl_sequence_align_kernel.h"
 #include "kel_exec_env.h"
 #include "kgl_genome_types.h"
 
@@ -43,29 +43,52 @@ public:
   kgl::CompareDistance_t globalblosum80Distance(const std::string& sequenceA, const std::string& sequenceB) const;
   kgl::CompareDistance_t localblosum80Distance(const std::string& sequenceA, const std::string& sequenceB) const;
 
-  
+  [[nodiscard]] bool verifyBlosum80() const;
+
+private:
+
+  // The seqan2 scoring was Blosum80(-8, -3), which is Score(gap_extend, gap_open), so gap open 3, gap extend 8.
+  constexpr static const AffineGap BLOSUM80_GAP_{3, 8};
+
+  // Fixed protein pairs and the alignment scores of the seqan2 Blosum80(-8, -3) global and local alignments.
+  struct Blosum80Check {
+
+    const char* sequenceA;
+    const char* sequenceB;
+    AlignScore_t global_score;
+    AlignScore_t local_score;
+
+  };
+  constexpr static const size_t BLOSUM80_CHECK_SIZE_{6};
+  constexpr static const std::array<Blosum80Check, BLOSUM80_CHECK_SIZE_> BLOSUM80_CHECK_ = {{
+      {"MKTAYIAKQRQISFVKSHFSRQ", "MKTAYIAKQRQISFVKSHFSRQ", 185, 185},
+      {"MKTAYIAKQRQISFVKSHFSRQ", "MKTAYIAKQISFVKSHFSRQLEERLGLIEVQ", 128, 161},
+      {"HEAGAWGHEE", "PAWHEAE", 35, 45},
+      {"MVLSPADKTNVKAAWGKVGAHAGEYGAEALERMFLSFPTTKTYFPHF", "MVHLTPEEKSAVTALWGKVNVDEVGGEALGRLLVVYPWTQRFFESF", 162, 162},
+      {"ACDEFGHIKLMNPQRSTVWY", "YWVTSRQPNMLKIHGFEDCA", -26, 16},
+      {"GGGGGGGGGG", "WWW", -39, 0} }};
+
 };
 
 
 
+// The striped kernel reuses a thread local DP workspace and query profile between calls.
 kgl::CompareDistance_t kgl::SequenceDistanceImpl::SequenceManipImpl::globalblosum80Distance(const std::string& sequenceA,
                                                                                           const std::string& sequenceB) const {
-  using TSequence = seqan::String<seqan::AminoAcid> ;
-  using TAlign = seqan::Align<TSequence, seqan::ArrayGaps> ;
-  int open_gap = -8;
-  int extend_gap = -3;
 
-  TSequence seq1 = sequenceA.c_str();
-  TSequence seq2 = sequenceB.c_str();
+  AlignScore_t score = StripedAlignKernel::alignScore(sequenceA, sequenceB, SubstitutionMatrix::blosum80(), BLOSUM80_GAP_, AlignMode::GLOBAL);
+
+  return static_cast<double>(score) * -1.0;  // Invert the scores.
+
+}
+
+
 
-  TAlign align;
-  resize(rows(align), 2);
-  seqan::assignSource(row(align, 0), seq1);
-  seqan::assignSource(row(align, 1), seq2);
 
-  std::stringstream ss;
+kgl::CompareDistance_t kgl::SequenceDistanceImpl::SequenceManipImpl::localblosum80Distance(const std::string& sequenceA,
+                                                                                            const std::string& sequenceB) const {
 
-  long score = seqan::globalAlignment(align, seqan::Blosum80(open_gap, extend_gap));
+  AlignScore_t score = StripedAlignKernel::alignScore(sequenceA, sequenceB, SubstitutionMatrix::blosum80(), BLOSUM80_GAP_, AlignMode::LOCAL);
 
   return static_cast<double>(score) * -1.0;  // Invert the scores.
 
@@ -73,32 +96,29 @@ kgl::CompareDistance_t kgl::SequenceDistanceImpl::SequenceManipImpl::globalblosu
 
 
 
+// The distances are the inverted alignment scores.
+bool kgl::SequenceDistanceImpl::SequenceManipImpl::verifyBlosum80() const {
 
-kgl::CompareDistance_t kgl::SequenceDistanceImpl::SequenceManipImpl::localblosum80Distance(const std::string& sequenceA,
-                                                                                            const std::string& sequenceB) const {
-  using TSequence = seqan::String<seqan::AminoAcid> ;
-  using TAlign = seqan::Align<TSequence, seqan::ArrayGaps> ;
-  int open_gap = -8;
-  int extend_gap = -3;
+  bool verified{true};
+  for (auto const& check : BLOSUM80_CHECK_) {
 
-  TSequence seq1 = sequenceA.c_str();
-  TSequence seq2 = sequenceB.c_str();
+    const CompareDistance_t global_distance = globalblosum80Distance(check.sequenceA, check.sequenceB);
+    const CompareDistance_t local_distance = localblosum80Distance(check.sequenceA, check.sequenceB);
+    if (global_distance != static_cast<double>(-check.global_score) or local_distance != static_cast<double>(-check.local_score)) {
 
-  TAlign align;
-  resize(rows(align), 2);
-  seqan::assignSource(row(align, 0), seq1);
-  seqan::assignSource(row(align, 1), seq2);
+      ExecEnv::log().error("SequenceManipImpl::verifyBlosum80; sequenceA: {}, sequenceB: {}, global distance: {} expected: {}, local distance: {} expected: {}",
+                           check.sequenceA, check.sequenceB, global_distance, -check.global_score, local_distance, -check.local_score);
+      verified = false;
 
-  std::stringstream ss;
+    }
 
-  long score = seqan::localAlignment(align, seqan::Blosum80(open_gap, extend_gap));
+  }
 
-  return static_cast<double>(score) * -1.0;  // Invert the scores.
+  return verified;
 
 }
 
 
-
 kgl::CompareDistance_t kgl::SequenceDistanceImpl::SequenceManipImpl::LevenshteinGlobalSeqan3(const std::string& sequenceA,
                                                                                              const std::string& sequenceB) const {
 
@@ -239,3 +259,10 @@ kgl::CompareDistance_t kgl::SequenceDistanceImpl::localblosum80Distance(const st
 
 }
 
+
+bool kgl::SequenceDistanceImpl::verifyBlosum80() const {
+
+  return sequence_manip_impl_ptr_->verifyBlosum80();
+
+}
+
@@ -34,6 +34,9 @@ public:
 
   [[nodiscard]] CompareDistance_t localblosum80Distance(const std::string& sequenceA, const std::string& sequenceB) const;
 
+  // Check the BLOSUM80 distances of fixed protein pairs against the seqan2 alignment scores.
+  [[nodiscard]] bool verifyBlosum80() const;
+
 private:
 
   class SequenceManipImpl;       // Forward declaration of the Sequence Manipulation implementation class
@@ -0,0 +1,183 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_sequence_kmer.h"
+
+#include <cmath>
+#include <algorithm>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+const std::array<uint8_t, 256> kgl::KmerEncoder::SYMBOL_CODE_ = kgl::KmerEncoder::symbolCodes();
+
+
+kgl::KmerEncoder::KmerEncoder(size_t kmer_size) : kmer_size_(kmer_size) {
+
+  if (kmer_size_ == 0 or kmer_size_ > MAX_KMER_SIZE) {
+
+    ExecEnv::log().error("KmerEncoder::KmerEncoder; k-mer size: {} must be in the range [1, {}]", kmer_size_, MAX_KMER_SIZE);
+    kmer_size_ = std::clamp<size_t>(kmer_size_, 1, MAX_KMER_SIZE);
+
+  }
+
+  kmer_mask_ = kmer_size_ == MAX_KMER_SIZE ? ~static_cast<KmerCode_t>(0) : (static_cast<KmerCode_t>(1) << (2 * kmer_size_)) - 1;
+
+}
+
+
+// Upper and lower case nucleotides are encoded, U is encoded as T.
+std::array<uint8_t, 256> kgl::KmerEncoder::symbolCodes() {
+
+  std::array<uint8_t, 256> symbol_codes{};
+  symbol_codes.fill(INVALID_CODE_);
+
+  symbol_codes['A'] = 0;
+  symbol_codes['a'] = 0;
+  symbol_codes['C'] = 1;
+  symbol_codes['c'] = 1;
+  symbol_codes['G'] = 2;
+  symbol_codes['g'] = 2;
+  symbol_codes['T'] = 3;
+  symbol_codes['t'] = 3;
+  symbol_codes['U'] = 3;
+  symbol_codes['u'] = 3;
+
+  return symbol_codes;
+
+}
+
+
+std::optional<kgl::KmerCode_t> kgl::KmerEncoder::encode(const std::string& kmer) const {
+
+  if (kmer.size() != kmer_size_) {
+
+    return std::nullopt;
+
+  }
+
+  RollingKmer rolling;
+  bool valid{false};
+  for (auto symbol : kmer) {
+
+    valid = push(rolling, symbol);
+
+  }
+
+  if (not valid) {
+
+    return std::nullopt;
+
+  }
+
+  return rolling.code;
+
+}
+
+
+kgl::KmerCounter::KmerCounter(size_t kmer_size) : kmer_size_(kmer_size) {
+
+  if (kmer_size_ <= DENSE_KMER_LIMIT) {
+
+    dense_counts_.resize(KmerEncoder(kmer_size_).codeCount(), 0);
+
+  }
+
+}
+
+
+void kgl::KmerCounter::clear() {
+
+  std::fill(dense_counts_.begin(), dense_counts_.end(), 0);
+  hash_counts_.clear();
+  total_kmers_ = 0;
+  distinct_kmers_ = 0;
+  count_log_count_ = 0.0;
+
+}
+
+
+size_t kgl::KmerCounter::count(KmerCode_t code) const {
+
+  if (not dense_counts_.empty()) {
+
+    return code < dense_counts_.size() ? dense_counts_[code] : 0;
+
+  }
+
+  auto find_iter = hash_counts_.find(code);
+  return find_iter == hash_counts_.end() ? 0 : find_iter->second;
+
+}
+
+
+// The entropy is maintained using H = log(N) - (sum c.log(c)) / N, so each update only adjusts the changed count.
+void kgl::KmerCounter::updateCount(KmerCode_t code, bool increment) {
+
+  uint32_t* count_ptr{nullptr};
+  if (not dense_counts_.empty()) {
+
+    count_ptr = &dense_counts_[code];
+
+  } else {
+
+    count_ptr = &hash_counts_[code];
+
+  }
+
+  const uint32_t previous = *count_ptr;
+  if (not increment and previous == 0) {
+
+    ExecEnv::log().error("KmerCounter::updateCount; attempt to remove absent k-mer code: {}", code);
+    return;
+
+  }
+
+  const uint32_t updated = increment ? previous + 1 : previous - 1;
+  *count_ptr = updated;
+
+  auto countLog = [](uint32_t count) -> double { return count > 1 ? static_cast<double>(count) * std::log(static_cast<double>(count)) : 0.0; };
+  count_log_count_ += countLog(updated) - countLog(previous);
+
+  if (increment) {
+
+    ++total_kmers_;
+    if (previous == 0) ++distinct_kmers_;
+
+  } else {
+
+    --total_kmers_;
+    if (updated == 0) {
+
+      --distinct_kmers_;
+      if (dense_counts_.empty()) {
+
+        hash_counts_.erase(code);
+
+      }
+
+    }
+
+  }
+
+}
+
+
+double kgl::KmerCounter::kmerEntropy() const {
+
+  if (total_kmers_ == 0) {
+
+    return 0.0;
+
+  }
+
+  const auto total = static_cast<double>(total_kmers_);
+  double entropy = std::log(total) - (count_log_count_ / total);
+  entropy = std::max(entropy, 0.0) / std::log(2.0);
+
+  return entropy / static_cast<double>(2 * kmer_size_);
+
+}
+
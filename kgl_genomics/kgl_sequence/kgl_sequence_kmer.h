@@ -0,0 +1,148 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_SEQUENCE_KMER_H
+#define KGL_SEQUENCE_KMER_H
+
+
+#include "kgl_sequence_virtual.h"
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <optional>
+#include <string>
+
+
+namespace kellerberrin::genome {   //  organization level namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rolling 2 bit k-mer encoder for nucleotide sequences (A=0, C=1, G=2, T=3), up to 32 nucleotides per k-mer.
+// Any other symbol (N) is not encoded and restarts the rolling k-mer, so k-mers containing N are skipped.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using KmerCode_t = uint64_t;
+
+class KmerEncoder {
+
+public:
+
+  explicit KmerEncoder(size_t kmer_size);
+  ~KmerEncoder() = default;
+
+  // The k-mer ending at the last symbol pushed.
+  struct RollingKmer {
+
+    KmerCode_t code{0};
+    size_t valid_symbols{0};
+
+  };
+
+  [[nodiscard]] size_t kmerSize() const { return kmer_size_; }
+  // The number of distinct k-mer codes, 4^k (k < 32).
+  [[nodiscard]] size_t codeCount() const { return static_cast<size_t>(kmer_mask_) + 1; }
+
+  // Returns true if the pushed symbol completes a k-mer, the k-mer code is then rolling.code.
+  [[nodiscard]] bool push(RollingKmer& rolling, char symbol) const {
+
+    const uint8_t symbol_code = SYMBOL_CODE_[static_cast<unsigned char>(symbol)];
+    if (symbol_code == INVALID_CODE_) {
+
+      rolling.valid_symbols = 0;
+      return false;
+
+    }
+
+    rolling.code = ((rolling.code << 2) | symbol_code) & kmer_mask_;
+    ++rolling.valid_symbols;
+    return rolling.valid_symbols >= kmer_size_;
+
+  }
+
+  // Calls kmer_function(offset, code) for each k-mer (without N) in the sequence, offset is the start of the k-mer.
+  template<typename Alphabet, typename KmerFunction>
+  void scan(const AlphabetSequence<Alphabet>& sequence, KmerFunction&& kmer_function) const;
+
+  // The code of a nucleotide string of length k, nullopt if the string contains N or is the wrong size.
+  [[nodiscard]] std::optional<KmerCode_t> encode(const std::string& kmer) const;
+
+  constexpr static const size_t MAX_KMER_SIZE{32};
+
+private:
+
+  size_t kmer_size_;
+  KmerCode_t kmer_mask_;
+
+  constexpr static const uint8_t INVALID_CODE_{0xFF};
+  static const std::array<uint8_t, 256> SYMBOL_CODE_;
+
+  [[nodiscard]] static std::array<uint8_t, 256> symbolCodes();
+
+};
+
+
+template<typename Alphabet, typename KmerFunction>
+void KmerEncoder::scan(const AlphabetSequence<Alphabet>& sequence, KmerFunction&& kmer_function) const {
+
+  RollingKmer rolling;
+  ContigOffset_t offset{0};
+  for (auto symbol : sequence.getAlphabetString()) {
+
+    if (push(rolling, static_cast<char>(symbol))) {
+
+      kmer_function(offset + 1 - kmer_size_, rolling.code);
+
+    }
+    ++offset;
+
+  }
+
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// k-mer occurrence counts. For k <= DENSE_KMER_LIMIT the counts are held in a dense array indexed by the k-mer code,
+// longer k-mers are counted in a hash table. Counts can be removed as well as added (for sliding windows),
+// the number of distinct k-mers and the k-mer entropy are maintained incrementally.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class KmerCounter {
+
+public:
+
+  explicit KmerCounter(size_t kmer_size);
+  ~KmerCounter() = default;
+
+  void add(KmerCode_t code) { updateCount(code, true); }
+  void remove(KmerCode_t code) { updateCount(code, false); }
+  void clear();
+
+  [[nodiscard]] size_t count(KmerCode_t code) const;
+  [[nodiscard]] size_t totalKmers() const { return total_kmers_; }
+  [[nodiscard]] size_t distinctKmers() const { return distinct_kmers_; }
+  // Shannon entropy of the k-mer distribution in bits, divided by the maximum (2 * k bits), range [0, 1].
+  [[nodiscard]] double kmerEntropy() const;
+
+  constexpr static const size_t DENSE_KMER_LIMIT{12};
+
+private:
+
+  size_t kmer_size_;
+  std::vector<uint32_t> dense_counts_;
+  std::unordered_map<KmerCode_t, uint32_t> hash_counts_;
+  size_t total_kmers_{0};
+  size_t distinct_kmers_{0};
+  double count_log_count_{0.0};  // Sum of c * log(c) over the k-mer counts.
+
+  void updateCount(KmerCode_t code, bool increment);
+
+};
+
+
+
+}   // end namespace
+
+
+#endif //KGL_SEQUENCE_KMER_H
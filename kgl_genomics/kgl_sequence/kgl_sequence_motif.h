@@ -0,0 +1,249 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_SEQUENCE_MOTIF_H
+#define KGL_SEQUENCE_MOTIF_H
+
+
+#include "kgl_genome_types.h"
+#include "kel_exec_env.h"
+
+#include <vector>
+#include <array>
+#include <deque>
+#include <string_view>
+#include <optional>
+#include <limits>
+#include <cstdint>
+
+
+namespace kellerberrin::genome {   //  organization level namespace
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Aho-Corasick automaton for exact multi-motif search over the symbols of an alphabet (DNA5, CodingDNA5, AminoAcid).
+// The motifs are added and the automaton built once, a search is then a single pass over the sequence.
+// All (overlapping) occurrences of every motif are reported. Symbols not in the alphabet restart the search.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename Alphabet>
+class MotifAutomaton {
+
+public:
+
+  using Symbol = typename Alphabet::Alphabet;
+  using SymbolView = std::basic_string_view<Symbol>;
+
+  MotifAutomaton();
+  ~MotifAutomaton() = default;
+
+  // Returns the index of the motif. Empty motifs and motifs with symbols that are not enumerated by the alphabet
+  // are not added (nullopt). The automaton must be (re-)built before searching.
+  [[nodiscard]] std::optional<size_t> addMotif(SymbolView motif);
+  void build();
+
+  [[nodiscard]] size_t motifCount() const { return motif_lengths_.size(); }
+  [[nodiscard]] size_t motifLength(size_t motif_index) const { return motif_lengths_[motif_index]; }
+
+  // Calls match_function(motif_index, offset) for each motif occurrence, offset is the start of the motif.
+  // Occurrences are reported in order of their end offset.
+  template<typename MatchFunction>
+  void search(SymbolView sequence, MatchFunction&& match_function) const;
+
+private:
+
+  using NodeIndex = uint32_t;
+
+  constexpr static const NodeIndex ROOT_NODE_{0};
+  constexpr static const NodeIndex NO_NODE_{std::numeric_limits<NodeIndex>::max()};
+  constexpr static const uint8_t INVALID_COLUMN_{0xFF};
+
+  std::array<uint8_t, 256> symbol_column_;
+  size_t column_count_;
+  // Transitions are held as dense (node x column) tables, after build() every search transition is defined.
+  std::vector<NodeIndex> trie_transitions_;
+  std::vector<NodeIndex> transitions_;
+  std::vector<NodeIndex> failure_links_;
+  // The nearest node on the failure chain (including the node) that ends a motif.
+  std::vector<NodeIndex> output_links_;
+  std::vector<std::vector<uint32_t>> node_motifs_;
+  std::vector<size_t> motif_lengths_;
+  bool built_{false};
+
+  [[nodiscard]] NodeIndex addNode();
+
+};
+
+
+template<typename Alphabet>
+MotifAutomaton<Alphabet>::MotifAutomaton() {
+
+  symbol_column_.fill(INVALID_COLUMN_);
+  const auto& alphabet = Alphabet::enumerateAlphabet();
+  column_count_ = alphabet.size();
+  for (size_t column = 0; column < alphabet.size(); ++column) {
+
+    symbol_column_[static_cast<uint8_t>(alphabet[column])] = static_cast<uint8_t>(column);
+
+  }
+
+  static_cast<void>(addNode());
+
+}
+
+
+template<typename Alphabet>
+typename MotifAutomaton<Alphabet>::NodeIndex MotifAutomaton<Alphabet>::addNode() {
+
+  const auto node = static_cast<NodeIndex>(node_motifs_.size());
+  trie_transitions_.resize(trie_transitions_.size() + column_count_, NO_NODE_);
+  failure_links_.push_back(ROOT_NODE_);
+  output_links_.push_back(NO_NODE_);
+  node_motifs_.emplace_back();
+
+  return node;
+
+}
+
+
+template<typename Alphabet>
+std::optional<size_t> MotifAutomaton<Alphabet>::addMotif(SymbolView motif) {
+
+  if (motif.empty()) {
+
+    return std::nullopt;
+
+  }
+
+  NodeIndex node{ROOT_NODE_};
+  for (auto symbol : motif) {
+
+    const uint8_t column = symbol_column_[static_cast<uint8_t>(symbol)];
+    if (column == INVALID_COLUMN_) {
+
+      return std::nullopt;
+
+    }
+
+    NodeIndex next_node = trie_transitions_[(node * column_count_) + column];
+    if (next_node == NO_NODE_) {
+
+      next_node = addNode();
+      trie_transitions_[(node * column_count_) + column] = next_node;
+
+    }
+
+    node = next_node;
+
+  }
+
+  const size_t motif_index = motif_lengths_.size();
+  motif_lengths_.push_back(motif.size());
+  node_motifs_[node].push_back(static_cast<uint32_t>(motif_index));
+  built_ = false;
+
+  return motif_index;
+
+}
+
+
+// Breadth first, the failure link of a node is the longest proper suffix of the node that is also a trie prefix.
+// Undefined transitions are replaced by the transition of the failure node, so the search never backtracks.
+template<typename Alphabet>
+void MotifAutomaton<Alphabet>::build() {
+
+  transitions_ = trie_transitions_;
+
+  std::deque<NodeIndex> node_queue;
+  for (size_t column = 0; column < column_count_; ++column) {
+
+    NodeIndex& child = transitions_[column];
+    if (child == NO_NODE_) {
+
+      child = ROOT_NODE_;
+
+    } else {
+
+      failure_links_[child] = ROOT_NODE_;
+      node_queue.push_back(child);
+
+    }
+
+  }
+
+  output_links_[ROOT_NODE_] = NO_NODE_;
+  while (not node_queue.empty()) {
+
+    NodeIndex node = node_queue.front();
+    node_queue.pop_front();
+
+    output_links_[node] = node_motifs_[node].empty() ? output_links_[failure_links_[node]] : node;
+
+    for (size_t column = 0; column < column_count_; ++column) {
+
+      NodeIndex& child = transitions_[(node * column_count_) + column];
+      NodeIndex failure_child = transitions_[(failure_links_[node] * column_count_) + column];
+      if (child == NO_NODE_) {
+
+        child = failure_child;
+
+      } else {
+
+        failure_links_[child] = failure_child;
+        node_queue.push_back(child);
+
+      }
+
+    }
+
+  }
+
+  built_ = true;
+
+}
+
+
+template<typename Alphabet>
+template<typename MatchFunction>
+void MotifAutomaton<Alphabet>::search(SymbolView sequence, MatchFunction&& match_function) const {
+
+  if (not built_) {
+
+    ExecEnv::log().error("MotifAutomaton::search; automaton with: {} motifs has not been built", motifCount());
+    return;
+
+  }
+
+  NodeIndex node{ROOT_NODE_};
+  for (size_t offset = 0; offset < sequence.size(); ++offset) {
+
+    const uint8_t column = symbol_column_[static_cast<uint8_t>(sequence[offset])];
+    if (column == INVALID_COLUMN_) {
+
+      node = ROOT_NODE_;
+      continue;
+
+    }
+
+    node = transitions_[(node * column_count_) + column];
+    for (NodeIndex output = output_links_[node]; output != NO_NODE_; output = output_links_[failure_links_[output]]) {
+
+      for (auto motif_index : node_motifs_[output]) {
+
+        match_function(static_cast<size_t>(motif_index), static_cast<ContigOffset_t>(offset + 1 - motif_lengths_[motif_index]));
+
+      }
+
+    }
+
+  }
+
+}
+
+
+
+}   // end namespace
+
+
+#endif //KGL_SEQUENCE_MOTIF_H
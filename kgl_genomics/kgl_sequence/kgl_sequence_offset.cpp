@@ -15,17 +15,16 @@ kgl::DNA5SequenceCoding kgl::SequenceOffset::refCodingSubSequence( const std::sh
                                                                    ContigSize_t sub_sequence_length,
                                                                    ContigOffset_t contig_offset) {
 
-  StrandSense strand;
-  ExonOffsetMap exon_offset_map;
-  if (not exonOffsetAdapter(coding_seq_ptr, strand, exon_offset_map)) {
+  auto exon_offsets = codingExonOffsets(coding_seq_ptr);
+  if (not exon_offsets.valid()) {
 
     ExecEnv::log().error("refCodingSubSequence(), DNA Sequence length: {} cannot generate EXON map for subsequence offset: {}, length: {}",
                          sequence_ptr.length(), sub_sequence_offset, sub_sequence_length);
-    exon_offset_map.clear();
+    return DNA5SequenceCoding();
 
   }
 
-  return codingSubSequence(sequence_ptr, exon_offset_map, coding_seq_ptr->strand(), sub_sequence_offset, sub_sequence_length, contig_offset);
+  return codingSubSequence(sequence_ptr, exon_offsets.exonOffsetMap(), coding_seq_ptr->strand(), sub_sequence_offset, sub_sequence_length, contig_offset);
 
 }
 
@@ -135,9 +134,20 @@ kgl::DNA5SequenceCoding kgl::SequenceOffset::mutantCodingSubSequence( const std:
                                                                       ContigSize_t sub_sequence_length,
                                                                       ContigOffset_t contig_offset) {
 
-  StrandSense strand;
+  return mutantCodingSubSequence(codingExonOffsets(coding_seq_ptr), sequence_ptr, indel_adjust, sub_sequence_offset, sub_sequence_length, contig_offset);
+
+}
+
+
+kgl::DNA5SequenceCoding kgl::SequenceOffset::mutantCodingSubSequence( const CodingExonOffsets& reference_offsets,
+                                                                      const DNA5SequenceLinear& sequence_ptr,
+                                                                      const VariantMutationOffset& indel_adjust,
+                                                                      ContigOffset_t sub_sequence_offset,
+                                                                      ContigSize_t sub_sequence_length,
+                                                                      ContigOffset_t contig_offset) {
+
   ExonOffsetMap exon_offset_map;
-  if (not exonMutantOffset(coding_seq_ptr, indel_adjust, strand, exon_offset_map)) {
+  if (not exonMutantOffset(reference_offsets, indel_adjust, exon_offset_map)) {
 
     ExecEnv::log().error("mutantCodingSubSequence(), DNA Sequence length: {} cannot generate EXON map for INDEL adjusted subsequence offset: {}, length: {}",
                          sequence_ptr.length(), sub_sequence_offset, sub_sequence_length);
@@ -145,7 +155,7 @@ kgl::DNA5SequenceCoding kgl::SequenceOffset::mutantCodingSubSequence( const std:
 
   }
 
-  return codingSubSequence(sequence_ptr, exon_offset_map, coding_seq_ptr->strand(), sub_sequence_offset, sub_sequence_length, contig_offset);
+  return codingSubSequence(sequence_ptr, exon_offset_map, reference_offsets.strand(), sub_sequence_offset, sub_sequence_length, contig_offset);
 
 }
 
@@ -258,18 +268,14 @@ bool kgl::SequenceOffset::intronOffsetAdapter( const std::shared_ptr<const Codin
 
 
 
-// Adjusted for indel mutations.
-bool kgl::SequenceOffset::exonMutantOffset(const std::shared_ptr<const CodingSequence>& coding_seq_ptr,
+// The reference exon offsets adjusted for indel mutations.
+bool kgl::SequenceOffset::exonMutantOffset(const CodingExonOffsets& reference_offsets,
                                            const VariantMutationOffset& indel_adjust,
-                                           StrandSense& strand,
                                            ExonOffsetMap& exon_offset_map) {
 
-  bool return_result = true;
+  bool return_result = reference_offsets.valid();
 
-  ExonOffsetMap ref_exon_offset_map;
-  return_result = exonOffsetAdapter(coding_seq_ptr, strand, ref_exon_offset_map);
-
-  for (auto exon : ref_exon_offset_map) {
+  for (auto exon : reference_offsets.exonOffsetMap()) {
 
     ContigOffset_t begin_offset = exon.first + indel_adjust.adjustIndelOffsets(exon.first);
     ContigOffset_t end_offset = exon.second + indel_adjust.adjustIndelOffsets(exon.second);
@@ -278,8 +284,8 @@ bool kgl::SequenceOffset::exonMutantOffset(const std::shared_ptr<const CodingSeq
 
     if (not result.second) {
 
-      ExecEnv::log().error("exonMutantOffset(), Duplicate exon offset: {} for coding sequence id:",
-                           begin_offset, coding_seq_ptr->getCDSParent()->id());
+      ExecEnv::log().error("exonMutantOffset(), Duplicate exon offset: {} for coding sequence id: {}",
+                           begin_offset, reference_offsets.codingSequence()->getCDSParent()->id());
       return_result = false;
 
     }
@@ -291,6 +297,38 @@ bool kgl::SequenceOffset::exonMutantOffset(const std::shared_ptr<const CodingSeq
 }
 
 
+kgl::CodingExonOffsets kgl::SequenceOffset::codingExonOffsets(const std::shared_ptr<const CodingSequence>& coding_seq_ptr) {
+
+  StrandSense strand;
+  ExonOffsetMap exon_offset_map;
+  bool valid = exonOffsetAdapter(coding_seq_ptr, strand, exon_offset_map);
+
+  return CodingExonOffsets(coding_seq_ptr, strand, std::move(exon_offset_map), valid);
+
+}
+
+
+std::shared_ptr<const kgl::CodingReference> kgl::SequenceOffset::codingReference( const std::shared_ptr<const CodingSequence>& coding_seq_ptr,
+                                                                                  const DNA5SequenceLinear& contig_sequence) {
+
+  auto exon_offsets = codingExonOffsets(coding_seq_ptr);
+  DNA5SequenceCoding reference_sequence;
+  if (exon_offsets.valid()) {
+
+    reference_sequence = codingSubSequence(contig_sequence, exon_offsets.exonOffsetMap(), exon_offsets.strand(), 0, 0, 0);
+
+  } else {
+
+    ExecEnv::log().error("SequenceOffset::codingReference(), cannot generate EXON map for coding sequence id: {}",
+                         coding_seq_ptr->getCDSParent()->id());
+
+  }
+
+  return std::make_shared<const CodingReference>(std::move(exon_offsets), std::move(reference_sequence));
+
+}
+
+
 kgl::DNA5SequenceCoding kgl::SequenceOffset::codingSubSequence(const DNA5SequenceLinear& base_sequence,
                                                                const ExonOffsetMap& exon_offset_map,
                                                                StrandSense strand,
@@ -522,16 +560,15 @@ bool kgl::SequenceOffset::refOffsetWithinCodingSequence(const std::shared_ptr<co
                                                         ContigOffset_t &coding_sequence_offset,
                                                         ContigSize_t &coding_sequence_length) {
 
-  StrandSense strand;
-  ExonOffsetMap exon_offset_map;
-  if (not exonOffsetAdapter(coding_seq_ptr, strand, exon_offset_map)) {
+  auto exon_offsets = codingExonOffsets(coding_seq_ptr);
+  if (not exon_offsets.valid()) {
 
     ExecEnv::log().error("refOffsetWithinCodingSequence(), Contig: {}, Gene: {},  cannot generate EXON map for contig offset: {}",
                          coding_seq_ptr->contig()->contigId(), coding_seq_ptr->getGene()->id(), contig_offset);
     return false;
   }
 
-  return offsetWithinCodingSequence(exon_offset_map, coding_seq_ptr->strand(), contig_offset, 0, coding_sequence_offset, coding_sequence_length);
+  return offsetWithinCodingSequence(exon_offsets.exonOffsetMap(), coding_seq_ptr->strand(), contig_offset, 0, coding_sequence_offset, coding_sequence_length);
 
 }
 
@@ -642,9 +679,8 @@ bool kgl::SequenceOffset::refCodingSequenceContigOffset(const std::shared_ptr<co
                                                         ContigOffset_t &contig_offset,
                                                         ContigSize_t &coding_sequence_length) {
 
-  StrandSense strand;
-  ExonOffsetMap exon_offset_map;
-  if (not exonOffsetAdapter(coding_seq_ptr, strand, exon_offset_map)) {
+  auto exon_offsets = codingExonOffsets(coding_seq_ptr);
+  if (not exon_offsets.valid()) {
 
     ExecEnv::log().error("refCodingSequenceContigOffset(), Contig: {}, Gene: {},  cannot generate EXON map for CODING sequence offset: {}",
                          coding_seq_ptr->contig()->contigId(), coding_seq_ptr->getGene()->id(), contig_offset);
@@ -652,7 +688,7 @@ bool kgl::SequenceOffset::refCodingSequenceContigOffset(const std::shared_ptr<co
 
   }
 
-  return codingSequenceContigOffset(exon_offset_map, strand, coding_sequence_offset, contig_offset, coding_sequence_length);
+  return codingSequenceContigOffset(exon_offsets.exonOffsetMap(), exon_offsets.strand(), coding_sequence_offset, contig_offset, coding_sequence_length);
 
 }
 
@@ -9,7 +9,6 @@
 #include "kgl_variant_mutation_offset.h"
 
 
-
 namespace kellerberrin::genome {   //  organization level namespace
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -22,6 +21,65 @@ namespace kellerberrin::genome {   //  organization level namespace
 using ExonOffsetMap = std::map<ContigOffset_t, ContigOffset_t>;
 using IntronOffsetMap = ExonOffsetMap;
 
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The reference exon offsets of a coding sequence. Held by a CodingReference so that the exon map is generated once
+// and then shared when generating the (reference and mutant) coding sequences of many genomes.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CodingExonOffsets {
+
+public:
+
+  CodingExonOffsets(std::shared_ptr<const CodingSequence> coding_seq_ptr, StrandSense strand, ExonOffsetMap&& exon_offset_map, bool valid)
+  : coding_seq_ptr_(std::move(coding_seq_ptr)), strand_(strand), exon_offset_map_(std::move(exon_offset_map)), valid_(valid) {}
+  CodingExonOffsets(CodingExonOffsets&&) = default;
+  ~CodingExonOffsets() = default;
+
+  [[nodiscard]] const std::shared_ptr<const CodingSequence>& codingSequence() const { return coding_seq_ptr_; }
+  [[nodiscard]] StrandSense strand() const { return strand_; }
+  [[nodiscard]] const ExonOffsetMap& exonOffsetMap() const { return exon_offset_map_; }
+  // False if the exon map could not be generated (duplicate exon offsets).
+  [[nodiscard]] bool valid() const { return valid_; }
+
+private:
+
+  std::shared_ptr<const CodingSequence> coding_seq_ptr_;
+  StrandSense strand_;
+  ExonOffsetMap exon_offset_map_;
+  bool valid_;
+
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The strand adjusted reference coding sequence and the exon offsets of a CodingSequence.
+// Generated once per batch of genomes and shared (read only) when generating their mutant sequences.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CodingReference {
+
+public:
+
+  CodingReference(CodingExonOffsets&& exon_offsets, DNA5SequenceCoding&& reference_sequence)
+  : exon_offsets_(std::move(exon_offsets)), reference_sequence_(std::move(reference_sequence)) {}
+  ~CodingReference() = default;
+
+  [[nodiscard]] const CodingExonOffsets& exonOffsets() const { return exon_offsets_; }
+  [[nodiscard]] const DNA5SequenceCoding& referenceSequence() const { return reference_sequence_; }
+  // Returns a copy of the reference coding sequence.
+  [[nodiscard]] DNA5SequenceCoding copyReference() const {
+
+    return DNA5SequenceCoding(StringCodingDNA5(reference_sequence_.getAlphabetString()), reference_sequence_.strand());
+
+  }
+
+private:
+
+  CodingExonOffsets exon_offsets_;
+  DNA5SequenceCoding reference_sequence_;
+
+};
+
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // This class implements the tricky offset logic associated with generating a coding sequence after the underlying
 // DNA sequence has been modified by indel variants.
@@ -76,6 +134,14 @@ public:
                                                                    ContigSize_t sub_sequence_length,
                                                                    ContigOffset_t contig_offset);
 
+  // As above, using the previously generated reference exon offsets of the coding sequence.
+  [[nodiscard]] static DNA5SequenceCoding mutantCodingSubSequence( const CodingExonOffsets& reference_offsets,
+                                                                   const DNA5SequenceLinear& sequence,
+                                                                   const VariantMutationOffset& indel_adjust,
+                                                                   ContigOffset_t sub_sequence_offset,
+                                                                   ContigSize_t sub_sequence_length,
+                                                                   ContigOffset_t contig_offset);
+
 // Returns bool false if contig_offset is not within the coding sequence defined by the coding_seq_ptr.
 // If the contig_offset is in the coding sequence then a valid sequence_offset and the sequence length is returned.
 // The offset is adjusted for strand type; the offset arithmetic is reversed for -ve strand sequences.
@@ -108,6 +174,14 @@ public:
   // Converts linear DNA to a coding DNA sequence.
   [[nodiscard]] static DNA5SequenceCoding codingSequence(const DNA5SequenceLinear& base_sequence, StrandSense strand);
 
+  // The reference exon offsets of a coding sequence.
+  [[nodiscard]] static CodingExonOffsets codingExonOffsets(const std::shared_ptr<const CodingSequence>& coding_seq_ptr);
+
+  // The strand adjusted reference coding sequence generated from the (unmutated) contig sequence.
+  // The contig_sequence must be the entire contig sequence of the coding sequence.
+  [[nodiscard]] static std::shared_ptr<const CodingReference> codingReference( const std::shared_ptr<const CodingSequence>& coding_seq_ptr,
+                                                                               const DNA5SequenceLinear& contig_sequence);
+
 private:
 
   // Returns a defined subsequence (generally a single/group of codons) of the coding sequence
@@ -128,10 +202,9 @@ private:
                                                StrandSense& strand,
                                                ExonOffsetMap& exon_offset_map);
 
-  // Adjusted for indel mutations.
-  [[nodiscard]] static bool exonMutantOffset( const std::shared_ptr<const CodingSequence>& coding_seq_ptr,
+  // The reference exon offsets adjusted for indel mutations.
+  [[nodiscard]] static bool exonMutantOffset( const CodingExonOffsets& reference_offsets,
                                               const VariantMutationOffset& indel_adjust,
-                                              StrandSense& strand,
                                               ExonOffsetMap& exon_offset_map);
 
 
@@ -7,6 +7,7 @@
 
 #include <string>
 #include <set>
+#include <span>
 #include "kgl_alphabet_string.h"
 
 
@@ -41,8 +42,8 @@ class  AlphabetSequence : public VirtualSequence {
 
 public:
 
-  AlphabetSequence(AlphabetSequence&& sequence) noexcept : alphabet_string_(sequence.alphabet_string_) {}
-  explicit AlphabetSequence(AlphabetString<Alphabet>&& sequence) noexcept : alphabet_string_(sequence) {}
+  AlphabetSequence(AlphabetSequence&& sequence) noexcept : alphabet_string_(std::move(sequence.alphabet_string_)) {}
+  explicit AlphabetSequence(AlphabetString<Alphabet>&& sequence) noexcept : alphabet_string_(std::move(sequence)) {}
   AlphabetSequence() = default;
   AlphabetSequence(const AlphabetSequence&) = delete; // For Performance reasons, don't allow copy constructors
   ~AlphabetSequence() override = default;
@@ -63,6 +64,9 @@ public:
   [[nodiscard]] ContigSize_t length() const { return alphabet_string_.length(); }
   [[nodiscard]] std::string getSequenceAsString() const override { return alphabet_string_.str(); }
   [[nodiscard]] const AlphabetString<Alphabet>& getAlphabetString() const { return alphabet_string_; }
+  // A read only view of [offset, offset + length) that does not copy the sequence, empty if out of bounds.
+  // The view is only valid until the sequence is modified, moved or destroyed.
+  [[nodiscard]] std::span<const typename Alphabet::Alphabet> subView(ContigOffset_t offset, ContigSize_t length) const;
 
   // Check for memory corruption.
   [[nodiscard]] bool verifySequence() const { return alphabet_string_.verifyString(); }
@@ -209,6 +213,21 @@ bool AlphabetSequence<Alphabet>::getSubsequence(ContigOffset_t substring_offset,
 }
 
 
+template<typename Alphabet>
+std::span<const typename Alphabet::Alphabet> AlphabetSequence<Alphabet>::subView(ContigOffset_t offset, ContigSize_t length) const {
+
+  auto sequence_view = alphabet_string_.view();
+  if (offset > sequence_view.size() or length > sequence_view.size() - offset) {
+
+    return {};
+
+  }
+
+  return { sequence_view.data() + offset, length };
+
+}
+
+
 template<typename Alphabet>
 size_t AlphabetSequence<Alphabet>::commonPrefix(const AlphabetSequence& cmp_sequence) const {
 
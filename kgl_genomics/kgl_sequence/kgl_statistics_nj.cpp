@@ -0,0 +1,267 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_statistics_nj.h"
+
+#include <numeric>
+#include <algorithm>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+void kgl::NeighbourJoiningTree::calculateTree(std::shared_ptr<PhyloNodeVector> node_vector_ptr) {
+
+  node_vector_ptr_ = node_vector_ptr;
+  initializeDistance();
+  joinTree();
+
+}
+
+
+void kgl::NeighbourJoiningTree::joinTree() {
+
+  if (node_vector_ptr_->size() < 2) {
+
+    node_vector_ptr_ = std::make_shared<PhyloNodeVector>(*node_vector_ptr_);
+    return;
+
+  }
+
+  JoinState state = initialState();
+
+  while (state.active_slots.size() > 3) {
+
+    auto [row_slot, column_slot] = minimumPair(state);
+    joinPair(state, row_slot, column_slot);
+
+  }
+
+  node_vector_ptr_ = std::make_shared<PhyloNodeVector>(1, rootNode(state));
+
+}
+
+
+// Each leaf row holds the leaves with a lower index, so every pair of clusters is held in exactly one row.
+kgl::NeighbourJoiningTree::JoinState kgl::NeighbourJoiningTree::initialState() const {
+
+  const size_t leaf_count = node_vector_ptr_->size();
+
+  JoinState state;
+  state.active_slots.resize(leaf_count);
+  std::iota(state.active_slots.begin(), state.active_slots.end(), 0);
+  state.slot_cluster = state.active_slots;
+  state.cluster_slot.resize(2 * leaf_count, 0);
+  std::iota(state.cluster_slot.begin(), state.cluster_slot.begin() + static_cast<std::ptrdiff_t>(leaf_count), 0);
+  state.cluster_active.resize(2 * leaf_count, false);
+  std::fill(state.cluster_active.begin(), state.cluster_active.begin() + static_cast<std::ptrdiff_t>(leaf_count), true);
+  state.row_sum.resize(leaf_count, 0.0);
+  state.sorted_rows.resize(leaf_count);
+  state.row_begin.resize(leaf_count, 0);
+  state.slot_nodes = *node_vector_ptr_;
+  state.next_cluster = leaf_count;
+
+  for (size_t row = 0; row < leaf_count; ++row) {
+
+    SortedRow& sorted_row = state.sorted_rows[row];
+    sorted_row.reserve(row);
+    for (size_t column = 0; column < leaf_count; ++column) {
+
+      DistanceType_t distance = distance_matrix_.getDistance(row, column);
+      state.row_sum[row] += distance;
+      if (column < row) {
+
+        sorted_row.push_back({distance, column});
+
+      }
+
+    }
+
+    std::sort(sorted_row.begin(), sorted_row.end(), [](const SortedDistance& lhs, const SortedDistance& rhs) {
+      return lhs.distance < rhs.distance;
+    });
+
+  }
+
+  return state;
+
+}
+
+
+// Q(i, j) = d(i, j) - u(i) - u(j), where u(i) = row_sum(i) / (n - 2).
+// Entries for joined clusters are skipped and entries for clusters created after a row are held in the later rows.
+std::pair<size_t, size_t> kgl::NeighbourJoiningTree::minimumPair(JoinState& state) const {
+
+  const auto divisor = static_cast<DistanceType_t>(state.active_slots.size() - 2);
+
+  std::vector<DistanceType_t> slot_u(state.row_sum.size(), 0.0);
+  DistanceType_t max_u = std::numeric_limits<DistanceType_t>::lowest();
+  for (auto slot : state.active_slots) {
+
+    slot_u[slot] = state.row_sum[slot] / divisor;
+    max_u = std::max(max_u, slot_u[slot]);
+
+  }
+
+  DistanceType_t minimum_q = std::numeric_limits<DistanceType_t>::max();
+  std::pair<size_t, size_t> minimum_pair{state.active_slots[1], state.active_slots[0]};
+
+  for (auto row_slot : state.active_slots) {
+
+    const SortedRow& sorted_row = state.sorted_rows[row_slot];
+    size_t& row_begin = state.row_begin[row_slot];
+    while (row_begin < sorted_row.size() and not state.cluster_active[sorted_row[row_begin].cluster]) {
+
+      ++row_begin;
+
+    }
+
+    const DistanceType_t row_u = slot_u[row_slot];
+    for (size_t index = row_begin; index < sorted_row.size(); ++index) {
+
+      const SortedDistance& entry = sorted_row[index];
+      if (entry.distance - row_u - max_u >= minimum_q) {
+
+        break;
+
+      }
+
+      if (not state.cluster_active[entry.cluster]) {
+
+        continue;
+
+      }
+
+      const size_t column_slot = state.cluster_slot[entry.cluster];
+      DistanceType_t q = entry.distance - row_u - slot_u[column_slot];
+      if (q < minimum_q) {
+
+        minimum_q = q;
+        minimum_pair = {row_slot, column_slot};
+
+      }
+
+    }
+
+  }
+
+  return minimum_pair;
+
+}
+
+
+// The joined cluster occupies the row slot, distances to the remaining clusters are d(k, ij) = (d(i, k) + d(j, k) - d(i, j)) / 2.
+void kgl::NeighbourJoiningTree::joinPair(JoinState& state, size_t row_slot, size_t column_slot) {
+
+  const auto divisor = static_cast<DistanceType_t>(state.active_slots.size() - 2);
+  const DistanceType_t pair_distance = distance_matrix_.getDistance(row_slot, column_slot);
+  const DistanceType_t row_branch = (pair_distance / 2) + ((state.row_sum[row_slot] - state.row_sum[column_slot]) / (2 * divisor));
+  const DistanceType_t column_branch = pair_distance - row_branch;
+
+  std::shared_ptr<PhyloNode> row_node = state.slot_nodes[row_slot];
+  std::shared_ptr<PhyloNode> column_node = state.slot_nodes[column_slot];
+  row_node->distance(row_branch);
+  column_node->distance(column_branch);
+  std::shared_ptr<PhyloNode> joined_node(std::make_shared<PhyloNode>(row_node->node()));
+  joined_node->addOutNode(row_node);
+  joined_node->addOutNode(column_node);
+
+  state.cluster_active[state.slot_cluster[row_slot]] = false;
+  state.cluster_active[state.slot_cluster[column_slot]] = false;
+  state.active_slots.erase(std::find(state.active_slots.begin(), state.active_slots.end(), column_slot));
+
+  DistanceType_t joined_sum{0.0};
+  for (auto slot : state.active_slots) {
+
+    if (slot == row_slot) {
+
+      continue;
+
+    }
+
+    DistanceType_t row_distance = distance_matrix_.getDistance(row_slot, slot);
+    DistanceType_t column_distance = distance_matrix_.getDistance(column_slot, slot);
+    DistanceType_t joined_distance = (row_distance + column_distance - pair_distance) / 2;
+    distance_matrix_.setDistance(row_slot, slot, joined_distance);
+    state.row_sum[slot] += joined_distance - row_distance - column_distance;
+    joined_sum += joined_distance;
+
+  }
+
+  const size_t joined_cluster = state.next_cluster++;
+  state.slot_cluster[row_slot] = joined_cluster;
+  state.cluster_slot[joined_cluster] = row_slot;
+  state.cluster_active[joined_cluster] = true;
+  state.row_sum[row_slot] = joined_sum;
+  state.slot_nodes[row_slot] = joined_node;
+  state.slot_nodes[column_slot] = nullptr;
+
+  state.sorted_rows[row_slot] = sortedRow(state, row_slot);
+  state.row_begin[row_slot] = 0;
+  SortedRow().swap(state.sorted_rows[column_slot]);
+
+}
+
+
+// A new cluster row holds all the active clusters.
+kgl::NeighbourJoiningTree::SortedRow kgl::NeighbourJoiningTree::sortedRow(const JoinState& state, size_t slot) const {
+
+  SortedRow sorted_row;
+  sorted_row.reserve(state.active_slots.size());
+  for (auto column_slot : state.active_slots) {
+
+    if (column_slot != slot) {
+
+      sorted_row.push_back({distance_matrix_.getDistance(slot, column_slot), state.slot_cluster[column_slot]});
+
+    }
+
+  }
+
+  std::sort(sorted_row.begin(), sorted_row.end(), [](const SortedDistance& lhs, const SortedDistance& rhs) {
+    return lhs.distance < rhs.distance;
+  });
+
+  return sorted_row;
+
+}
+
+
+// The remaining two or three clusters are joined at the root.
+std::shared_ptr<kgl::PhyloNode> kgl::NeighbourJoiningTree::rootNode(const JoinState& state) const {
+
+  const std::vector<size_t>& slots = state.active_slots;
+  std::shared_ptr<PhyloNode> root_node(std::make_shared<PhyloNode>(state.slot_nodes[slots[0]]->node()));
+
+  if (slots.size() == 2) {
+
+    DistanceType_t branch = distance_matrix_.getDistance(slots[0], slots[1]) / 2;
+    for (auto slot : slots) {
+
+      state.slot_nodes[slot]->distance(branch);
+      root_node->addOutNode(state.slot_nodes[slot]);
+
+    }
+
+    return root_node;
+
+  }
+
+  const DistanceType_t distance_01 = distance_matrix_.getDistance(slots[0], slots[1]);
+  const DistanceType_t distance_02 = distance_matrix_.getDistance(slots[0], slots[2]);
+  const DistanceType_t distance_12 = distance_matrix_.getDistance(slots[1], slots[2]);
+  state.slot_nodes[slots[0]]->distance((distance_01 + distance_02 - distance_12) / 2);
+  state.slot_nodes[slots[1]]->distance((distance_01 + distance_12 - distance_02) / 2);
+  state.slot_nodes[slots[2]]->distance((distance_02 + distance_12 - distance_01) / 2);
+
+  for (auto slot : slots) {
+
+    root_node->addOutNode(state.slot_nodes[slot]);
+
+  }
+
+  return root_node;
+
+}
+
@@ -0,0 +1,72 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_STATISTICS_NJ_H
+#define KGL_STATISTICS_NJ_H
+
+
+#include "kgl_statistics_tree.h"
+
+
+namespace kellerberrin::genome {   //  organization level namespace
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Neighbour joining on a packed distance matrix, does not assume a molecular clock.
+// The minimum Q criterion is found using RapidNJ sorted rows; each row holds the distances to the clusters that
+// existed when the row was created in ascending order, so the row search stops when the remaining distances
+// cannot improve on the current minimum (d(i, j) - u(i) - max(u) >= minimum Q).
+// The final three clusters are joined at the (unrooted) tree root.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class NeighbourJoiningTree : public PackedDistanceTree {
+
+public:
+
+  NeighbourJoiningTree() = default;
+  ~NeighbourJoiningTree() override = default;
+
+  void calculateTree(std::shared_ptr<PhyloNodeVector> node_vector_ptr) override;
+
+private:
+
+  struct SortedDistance {
+
+    DistanceType_t distance;
+    size_t cluster;
+
+  };
+  using SortedRow = std::vector<SortedDistance>;
+
+  // Working state of the join, matrix slots are re-used by joined clusters.
+  struct JoinState {
+
+    std::vector<size_t> active_slots;
+    std::vector<size_t> slot_cluster;
+    std::vector<size_t> cluster_slot;
+    std::vector<bool> cluster_active;
+    std::vector<DistanceType_t> row_sum;
+    std::vector<SortedRow> sorted_rows;
+    std::vector<size_t> row_begin;         // Leading inactive entries of a sorted row are skipped.
+    std::vector<std::shared_ptr<PhyloNode>> slot_nodes;
+    size_t next_cluster{0};
+
+  };
+
+  void joinTree();
+  [[nodiscard]] JoinState initialState() const;
+  // The minimum Q pair, row_slot holds the later created cluster.
+  [[nodiscard]] std::pair<size_t, size_t> minimumPair(JoinState& state) const;
+  void joinPair(JoinState& state, size_t row_slot, size_t column_slot);
+  [[nodiscard]] SortedRow sortedRow(const JoinState& state, size_t slot) const;
+  [[nodiscard]] std::shared_ptr<PhyloNode> rootNode(const JoinState& state) const;
+
+};
+
+
+
+}   // end namespace
+
+
+#endif //KGL_STATISTICS_NJ_H
@@ -0,0 +1,265 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_statistics_tree.h"
+
+#include <algorithm>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+
+// Tiles of the strict lower triangle write disjoint matrix elements and are calculated in parallel.
+// The distance range is the minimum and maximum of all elements, so the rescale is independent of the tile order.
+kgl::PackedDistanceMatrix kgl::PackedDistanceTree::nodeDistance(const PhyloNodeVector& node_vector, size_t max_threads) {
+
+  std::optional<PackedDistanceMatrix> batch_matrix_opt = batchDistance(node_vector);
+  const bool calculate_distance = not batch_matrix_opt.has_value();
+  PackedDistanceMatrix distance_matrix = calculate_distance ? PackedDistanceMatrix(node_vector.size()) : std::move(batch_matrix_opt.value());
+  ZeroDistanceVector zero_distance(PackedDistanceMatrix::packedSize(node_vector.size()), 0);
+
+  const size_t tile_count = (node_vector.size() + TILE_NODES_ - 1) / TILE_NODES_;
+  ThreadPool thread_pool(std::max<size_t>(1, std::min(max_threads, ThreadPool::defaultThreads())));
+  std::vector<std::future<bool>> future_vector;
+  for (size_t row_tile = 0; row_tile < tile_count; ++row_tile) {
+
+    for (size_t column_tile = 0; column_tile <= row_tile; ++column_tile) {
+
+      future_vector.push_back(thread_pool.enqueueTask(&PackedDistanceTree::tileDistance,
+                                                      std::cref(node_vector),
+                                                      row_tile,
+                                                      column_tile,
+                                                      calculate_distance,
+                                                      std::ref(distance_matrix),
+                                                      std::ref(zero_distance)));
+
+    }
+
+  }
+
+  // Progress is only reported for large matrices.
+  const bool report_progress = calculate_distance and future_vector.size() >= PROGRESS_MIN_TILES_;
+  size_t tiles_complete{0};
+  size_t next_progress{PROGRESS_PERCENT_};
+  for (auto& future : future_vector) {
+
+    if (not future.get()) {
+
+      ExecEnv::log().error("PackedDistanceTree::nodeDistance; problem calculating distance matrix tile");
+
+    }
+
+    ++tiles_complete;
+    if (report_progress and (tiles_complete * 100) >= (next_progress * future_vector.size())) {
+
+      ExecEnv::log().info("PackedDistanceTree::nodeDistance; {}% of distances calculated for: {} nodes",
+                          (tiles_complete * 100) / future_vector.size(), node_vector.size());
+      next_progress = (((tiles_complete * 100) / future_vector.size()) / PROGRESS_PERCENT_ + 1) * PROGRESS_PERCENT_;
+
+    }
+
+  }
+
+  rescaleDistance(distance_matrix);
+
+  auto& packed_distances = distance_matrix.packedDistances();
+  for (size_t index = 0; index < packed_distances.size(); ++index) {
+
+    if (zero_distance[index] != 0) {
+
+      packed_distances[index] = 0.0;
+
+    }
+
+  }
+
+  return distance_matrix;
+
+}
+
+
+bool kgl::PackedDistanceTree::tileDistance( const PhyloNodeVector& node_vector,
+                                            size_t row_tile,
+                                            size_t column_tile,
+                                            bool calculate_distance,
+                                            PackedDistanceMatrix& distance_matrix,
+                                            ZeroDistanceVector& zero_distance) {
+
+  const size_t row_end = std::min(node_vector.size(), (row_tile + 1) * TILE_NODES_);
+  const size_t column_end = std::min(node_vector.size(), (column_tile + 1) * TILE_NODES_);
+
+  for (size_t row = row_tile * TILE_NODES_; row < row_end; ++row) {
+
+    auto row_node = node_vector[row]->node();
+    for (size_t column = column_tile * TILE_NODES_; column < std::min(row, column_end); ++column) {
+
+      auto column_node = node_vector[column]->node();
+      if (calculate_distance) {
+
+        distance_matrix.setDistance(row, column, row_node->distance(column_node));
+
+      }
+
+      if (row_node->zeroDistance(column_node)) {
+
+        zero_distance[PackedDistanceMatrix::packedIndex(row, column)] = 1;
+
+      }
+
+    }
+
+  }
+
+  return true;
+
+}
+
+
+// If all nodes share a batch distance metric then the distance matrix is calculated as a single (multi-threaded) batch.
+std::optional<kgl::PackedDistanceMatrix> kgl::PackedDistanceTree::batchDistance(const PhyloNodeVector& node_vector) {
+
+  if (node_vector.empty()) {
+
+    return std::nullopt;
+
+  }
+
+  const SequenceDistance* batch_metric = node_vector.front()->node()->batchMetric();
+  if (batch_metric == nullptr) {
+
+    return std::nullopt;
+
+  }
+
+  std::vector<std::string> sequence_vector;
+  sequence_vector.reserve(node_vector.size());
+  for (auto const& phylo_node : node_vector) {
+
+    if (phylo_node->node()->batchMetric() != batch_metric) {
+
+      return std::nullopt;
+
+    }
+
+    auto sequence_opt = phylo_node->node()->batchSequence();
+    if (not sequence_opt) {
+
+      return std::nullopt;
+
+    }
+
+    sequence_vector.push_back(std::move(sequence_opt.value()));
+
+  }
+
+  auto packed_matrix_opt = batch_metric->batchDistance(sequence_vector);
+  if (packed_matrix_opt) {
+
+    ExecEnv::log().info("PackedDistanceTree::batchDistance; {} distance matrix calculated for: {} nodes",
+                        batch_metric->distanceType(), node_vector.size());
+
+  }
+
+  return packed_matrix_opt;
+
+}
+
+
+// The packed distances are held in the same (row major) order as a scan of the strict lower triangle.
+void kgl::PackedDistanceTree::rescaleDistance(PackedDistanceMatrix& distance_matrix) {
+
+  auto& packed_distances = distance_matrix.packedDistances();
+
+  DistanceType_t min{0.0};
+  DistanceType_t max{0.0};
+  if (not packed_distances.empty()) {
+
+    auto [min_iter, max_iter] = std::minmax_element(packed_distances.begin(), packed_distances.end());
+    min = *min_iter;
+    max = *max_iter;
+
+  }
+
+  DistanceType_t range = max - min;
+  if (range == 0.0) {
+
+    ExecEnv::log().error("PackedDistanceTree::rescaleDistance() distance range for all nodes is zero");
+    return;
+
+  }
+
+  for (auto& distance : packed_distances) {
+
+    distance = (distance - min) / range;
+
+  }
+
+}
+
+
+bool kgl::PackedDistanceTree::writeNewick(const std::string& file_name) const {
+
+  std::ofstream newick_file;
+
+  newick_file.open(file_name);
+
+  if (not newick_file.good()) {
+
+    ExecEnv::log().error("I/O error; could not open Newick file: {}", file_name);
+    return false;
+
+  }
+
+  for (const auto& node : *node_vector_ptr_) {
+
+    writeNode(node, newick_file);
+
+  }
+
+  newick_file << ";";
+
+  newick_file.close();
+
+  return true;
+
+}
+
+
+void kgl::PackedDistanceTree::writeNode(const std::shared_ptr<PhyloNode>& node, std::ofstream& newick_file) const {
+
+  if (not node->outNodes().empty()) {
+
+    newick_file << "(";
+
+    bool first_pass = true;
+    for (const auto& child_node : node->outNodes()) {
+
+      if (first_pass) {
+
+        first_pass = false;
+
+      } else {
+
+        newick_file << ",";
+
+      }
+
+      writeNode(child_node.second, newick_file);
+
+    }
+
+    newick_file << ")";
+
+  } else {
+
+    node->node()->writeNode(newick_file);
+
+  }
+
+  newick_file << ":";
+  newick_file << node->distance();
+
+}
+
@@ -0,0 +1,72 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#ifndef KGL_STATISTICS_TREE_H
+#define KGL_STATISTICS_TREE_H
+
+
+#include "kgl_phylogenetic_tree.h"
+#include "kgl_sequence_distance.h"
+#include "kel_thread_pool.h"
+
+
+namespace kellerberrin::genome {   //  organization level namespace
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Base class of the distance trees that are calculated on a contiguous packed (strict lower triangular) matrix.
+// The distance matrix is initialized and normalized in the same manner as UPGMAMatrix and
+// the completed tree (the node vector) is written in Newick format.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class PackedDistanceTree : public DistanceTree {
+
+public:
+
+  PackedDistanceTree() = default;
+  ~PackedDistanceTree() override = default;
+
+  [[nodiscard]] bool writeNewick(const std::string& file_name) const override;
+
+  // The normalized distance matrix of the node vector, also used by UPGMAMatrix.
+  // If all nodes share a batch metric the distances are calculated as a batch, else in parallel over square tiles.
+  // Distances are then rescaled to [0, 1] and zero distances applied; the result does not depend on the thread count.
+  [[nodiscard]] static PackedDistanceMatrix nodeDistance(const PhyloNodeVector& node_vector, size_t max_threads = ThreadPool::defaultThreads());
+
+protected:
+
+  void initializeDistance() { distance_matrix_ = nodeDistance(*node_vector_ptr_); }
+
+  PackedDistanceMatrix distance_matrix_;
+  std::shared_ptr<PhyloNodeVector> node_vector_ptr_;
+
+private:
+
+  // Zero distance flags of the packed matrix elements.
+  using ZeroDistanceVector = std::vector<uint8_t>;
+
+  [[nodiscard]] static std::optional<PackedDistanceMatrix> batchDistance(const PhyloNodeVector& node_vector);
+  [[nodiscard]] static bool tileDistance( const PhyloNodeVector& node_vector,
+                                          size_t row_tile,
+                                          size_t column_tile,
+                                          bool calculate_distance,
+                                          PackedDistanceMatrix& distance_matrix,
+                                          ZeroDistanceVector& zero_distance);
+  static void rescaleDistance(PackedDistanceMatrix& distance_matrix);
+  void writeNode(const std::shared_ptr<PhyloNode>& node, std::ofstream& newick_file) const;
+
+  // Nodes per tile side, each tile covers at most TILE_NODES_ x TILE_NODES_ distances.
+  constexpr static const size_t TILE_NODES_{32};
+  // Progress is reported as each PROGRESS_PERCENT_ of the tiles complete.
+  constexpr static const size_t PROGRESS_PERCENT_{10};
+  constexpr static const size_t PROGRESS_MIN_TILES_{64};
+
+};
+
+
+
+}   // end namespace
+
+
+#endif //KGL_STATISTICS_TREE_H
@@ -234,81 +234,16 @@ size_t kgl::UPGMAMatrix::getLeafCount(size_t leaf_idx) const {
 }
 
 
-kgl::DistanceType_t kgl::UPGMAMatrix::distance(std::shared_ptr<PhyloNode> row_node,
-                                     std::shared_ptr<PhyloNode> column_node) const {
-
-  return row_node->node()->distance(column_node->node());
-
-}
-
-
+// The normalized distances are calculated in parallel on a packed matrix and then copied to the UPGMA matrix.
 void kgl::UPGMAMatrix::initializeDistance() {
 
-  for (size_t row = 0; row < node_vector_ptr_->size(); ++row) {
-
-    for (size_t column = 0; column < row; column++) {
-
-      distance_matrix_.setDistance(row, column, distance(node_vector_ptr_->at(row), node_vector_ptr_->at(column)));
-
-    }
-
-  }
-
-  normalizeDistance();
-
-}
-
-
-void kgl::UPGMAMatrix::normalizeDistance() {
-
-  rescaleDistance();
-  identityZeroDistance();
-
-}
-
-
-
-void kgl::UPGMAMatrix::identityZeroDistance() {
-
-  for (size_t row = 0; row < node_vector_ptr_->size(); ++row) {
-
-    for (size_t column = 0; column < row; column++) {
-
-      if (node_vector_ptr_->at(row)->node()->zeroDistance(node_vector_ptr_->at(column)->node())) {
-
-        distance_matrix_.setDistance(row, column, 0.0);
-
-      }
-
-    }
-
-  }
-
-}
-
-
-void kgl::UPGMAMatrix::rescaleDistance() {
-
-  size_t row;
-  size_t column;
-  DistanceType_t min = distance_matrix_.minimum(row, column);
-  DistanceType_t max = distance_matrix_.maximum(row, column);
-  DistanceType_t range = max - min;
-
-  if (range == 0.0) {
-
-    ExecEnv::log().error("UPGMAMatrix::normalizeDistance() distance range for all nodes is zero");
-    return;
-
-  }
+  PackedDistanceMatrix packed_matrix = PackedDistanceTree::nodeDistance(*node_vector_ptr_);
 
   for (size_t row = 0; row < node_vector_ptr_->size(); ++row) {
 
     for (size_t column = 0; column < row; column++) {
 
-      DistanceType_t raw_distance = distance_matrix_.getDistance(row, column);
-      DistanceType_t adj_distance = (raw_distance - min) / range;
-      distance_matrix_.setDistance(row, column, adj_distance);
+      distance_matrix_.setDistance(row, column, packed_matrix.getDistance(row, column));
 
     }
 
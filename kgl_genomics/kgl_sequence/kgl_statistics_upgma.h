@@ -10,6 +10,7 @@
 #include "kel_utility.h"
 #include "kgl_sequence_distance.h"
 #include "kgl_variant_db_population.h"
+#include "kgl_statistics_tree.h"
 
 
 namespace kellerberrin::genome {   //  organization level namespace
@@ -72,11 +73,7 @@ public:
 
 private:
 
-  [[nodiscard]] DistanceType_t distance(std::shared_ptr<PhyloNode> row_node, std::shared_ptr<PhyloNode> column_node) const;
   void initializeDistance();
-  virtual void normalizeDistance();
-  void rescaleDistance();
-  void identityZeroDistance();
   bool reduceNode(size_t row, size_t column, DistanceType_t minimum);
   void reduceDistance(size_t i, size_t j);
   void writeNode(const std::shared_ptr<PhyloNode>& node, std::ofstream& newick_file) const;
@@ -89,6 +86,39 @@ private:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// UPGMA using the nearest neighbour chain algorithm on a packed distance matrix, O(n^2) time.
+// Average linkage is reducible, so the chain finds the same merges as UPGMAMatrix. The merges are replayed
+// in distance order so that the tree (and Newick output) matches UPGMAMatrix for inputs without distance ties.
+// Can be used in place of UPGMAMatrix by the tree functions in kgl_upgma.h.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ChainUPGMATree : public PackedDistanceTree {
+
+public:
+
+  ChainUPGMATree() = default;
+  ~ChainUPGMATree() override = default;
+
+  void calculateTree(std::shared_ptr<PhyloNodeVector> node_vector_ptr) override;
+
+private:
+
+  // Clusters 0..(leaves - 1) are leaf nodes, merged clusters are numbered from 'leaves' in the order found.
+  struct ClusterMerge {
+
+    size_t cluster_a;
+    size_t cluster_b;
+    DistanceType_t distance;
+
+  };
+
+  [[nodiscard]] std::vector<ClusterMerge> nearestNeighbourChain();
+  void mergeTree(std::vector<ClusterMerge>& merge_vector);
+
+};
+
+
 }   // end namespace
 
 
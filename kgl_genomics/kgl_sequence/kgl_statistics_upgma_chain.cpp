@@ -0,0 +1,208 @@
+//
+// Created by kellerberrin on 18/10/26.
+//
+
+#include "kgl_statistics_upgma.h"
+
+#include <numeric>
+#include <algorithm>
+
+
+namespace kgl = kellerberrin::genome;
+
+
+void kgl::ChainUPGMATree::calculateTree(std::shared_ptr<PhyloNodeVector> node_vector_ptr) {
+
+  node_vector_ptr_ = node_vector_ptr;
+  initializeDistance();
+  auto merge_vector = nearestNeighbourChain();
+  mergeTree(merge_vector);
+
+}
+
+
+// Nearest neighbour chain. The chain is extended by the nearest neighbour of the chain tip until two clusters
+// are reciprocal nearest neighbours, these are merged and the remaining chain is retained.
+// A tie with the previous chain cluster is resolved in favour of the previous cluster so that the chain terminates.
+std::vector<kgl::ChainUPGMATree::ClusterMerge> kgl::ChainUPGMATree::nearestNeighbourChain() {
+
+  const size_t leaf_count = node_vector_ptr_->size();
+  std::vector<ClusterMerge> merge_vector;
+  if (leaf_count < 2) {
+
+    return merge_vector;
+
+  }
+  merge_vector.reserve(leaf_count - 1);
+
+  // Matrix slots are re-used by merged clusters.
+  std::vector<size_t> slot_cluster(leaf_count);
+  std::iota(slot_cluster.begin(), slot_cluster.end(), 0);
+  std::vector<size_t> slot_leaves(leaf_count, 1);
+  std::vector<size_t> active_slots(leaf_count);
+  std::iota(active_slots.begin(), active_slots.end(), 0);
+  std::vector<size_t> chain;
+  chain.reserve(leaf_count);
+
+  while (active_slots.size() > 1) {
+
+    if (chain.empty()) {
+
+      chain.push_back(active_slots.front());
+
+    }
+
+    const size_t tip = chain.back();
+    size_t nearest = tip;
+    DistanceType_t nearest_distance = std::numeric_limits<DistanceType_t>::max();
+    if (chain.size() >= 2) {
+
+      nearest = chain[chain.size() - 2];
+      nearest_distance = distance_matrix_.getDistance(tip, nearest);
+
+    }
+
+    for (auto slot : active_slots) {
+
+      if (slot == tip) {
+
+        continue;
+
+      }
+
+      DistanceType_t slot_distance = distance_matrix_.getDistance(tip, slot);
+      if (slot_distance < nearest_distance) {
+
+        nearest_distance = slot_distance;
+        nearest = slot;
+
+      }
+
+    }
+
+    if (chain.size() < 2 or nearest != chain[chain.size() - 2]) {
+
+      chain.push_back(nearest);
+      continue;
+
+    }
+
+    // Reciprocal nearest neighbours, merge into the tip slot.
+    chain.pop_back();
+    chain.pop_back();
+
+    merge_vector.push_back({slot_cluster[tip], slot_cluster[nearest], nearest_distance});
+    slot_cluster[tip] = leaf_count + merge_vector.size() - 1;
+
+    active_slots.erase(std::find(active_slots.begin(), active_slots.end(), nearest));
+
+    // Average linkage weighted by the leaf count of the merged clusters.
+    auto tip_leaves = static_cast<DistanceType_t>(slot_leaves[tip]);
+    auto nearest_leaves = static_cast<DistanceType_t>(slot_leaves[nearest]);
+    for (auto slot : active_slots) {
+
+      if (slot == tip) {
+
+        continue;
+
+      }
+
+      DistanceType_t merged_distance = (tip_leaves * distance_matrix_.getDistance(tip, slot)) + (nearest_leaves * distance_matrix_.getDistance(nearest, slot));
+      merged_distance = merged_distance / (tip_leaves + nearest_leaves);
+      distance_matrix_.setDistance(tip, slot, merged_distance);
+
+    }
+
+    slot_leaves[tip] += slot_leaves[nearest];
+
+  }
+
+  return merge_vector;
+
+}
+
+
+// UPGMAMatrix merges the minimum distance and inserts the merged node at the front of the node vector.
+// The row (first added) child of each merge is therefore the cluster furthest from the front of the node vector;
+// a leaf before a merged node, the later of two leaves and the earlier of two merged nodes.
+void kgl::ChainUPGMATree::mergeTree(std::vector<ClusterMerge>& merge_vector) {
+
+  if (merge_vector.empty()) {
+
+    node_vector_ptr_ = std::make_shared<PhyloNodeVector>(*node_vector_ptr_);
+    return;
+
+  }
+
+  const size_t leaf_count = node_vector_ptr_->size();
+
+  // The weighted average linkage of tied distances can round below a child merge distance.
+  // Clamping each merge to its child merge distances makes the distances monotone; children precede parents
+  // in the merge vector, so the stable sort below always creates a cluster before its parent.
+  for (auto& merge : merge_vector) {
+
+    for (auto cluster : {merge.cluster_a, merge.cluster_b}) {
+
+      if (cluster >= leaf_count) {
+
+        merge.distance = std::max(merge.distance, merge_vector[cluster - leaf_count].distance);
+
+      }
+
+    }
+
+  }
+
+  // Merged clusters are created in distance order.
+  std::vector<size_t> merge_order(merge_vector.size());
+  std::iota(merge_order.begin(), merge_order.end(), 0);
+  std::stable_sort(merge_order.begin(), merge_order.end(), [&merge_vector](size_t lhs, size_t rhs) {
+    return merge_vector[lhs].distance < merge_vector[rhs].distance;
+  });
+
+  std::vector<std::shared_ptr<PhyloNode>> cluster_nodes(*node_vector_ptr_);
+  cluster_nodes.resize(leaf_count + merge_vector.size());
+  std::vector<size_t> creation_order(merge_vector.size(), 0);
+
+  auto row_first = [leaf_count, &creation_order](size_t lhs, size_t rhs) -> bool {
+
+    const bool lhs_leaf = lhs < leaf_count;
+    const bool rhs_leaf = rhs < leaf_count;
+    if (lhs_leaf and rhs_leaf) return lhs > rhs;
+    if (lhs_leaf != rhs_leaf) return lhs_leaf;
+    return creation_order[lhs - leaf_count] < creation_order[rhs - leaf_count];
+
+  };
+
+  for (size_t order = 0; order < merge_order.size(); ++order) {
+
+    const size_t merge_index = merge_order[order];
+    const ClusterMerge& merge = merge_vector[merge_index];
+    creation_order[merge_index] = order;
+
+    size_t row = merge.cluster_a;
+    size_t column = merge.cluster_b;
+    if (not row_first(row, column)) {
+
+      std::swap(row, column);
+
+    }
+
+    std::shared_ptr<PhyloNode> row_node = cluster_nodes[row];
+    std::shared_ptr<PhyloNode> column_node = cluster_nodes[column];
+
+    DistanceType_t node_distance = merge.distance / 2;
+    row_node->distance(node_distance - row_node->distance());
+    column_node->distance(node_distance - column_node->distance());
+    std::shared_ptr<PhyloNode> merged_node(std::make_shared<PhyloNode>(row_node->node()));
+    merged_node->distance(node_distance);
+    merged_node->addOutNode(row_node);
+    merged_node->addOutNode(column_node);
+    cluster_nodes[leaf_count + merge_index] = merged_node;
+
+  }
+
+  node_vector_ptr_ = std::make_shared<PhyloNodeVector>(1, cluster_nodes[leaf_count + merge_order.back()]);
+
+}
+
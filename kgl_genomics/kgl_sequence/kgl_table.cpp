@@ -33,6 +33,8 @@ bool kgl::AminoTranslationTable::setTranslationTable(const std::string& table_na
 
   }
 
+  createLookup();
+
   return table_found;
 
 }
@@ -127,3 +129,105 @@ bool kgl::AminoTranslationTable::isStartCodon(const Codon& codon) const {
   return amino_table_rows_.amino_table[table_index].start == AminoAcid::START_CODON;
 
 }
+
+
+void kgl::AminoTranslationTable::createLookup() {
+
+  for (size_t table_index = 0; table_index < Tables::AMINO_TABLE_SIZE; ++table_index) {
+
+    const AminoTableColumn& table_column = amino_table_rows_.amino_table[table_index];
+    amino_lookup_[table_index] = AminoAcid::convertChar(table_column.amino_acid);
+    codon_flag_lookup_[table_index] = 0;
+    if (table_column.start == AminoAcid::START_CODON) {
+
+      codon_flag_lookup_[table_index] |= START_FLAG_;
+
+    }
+    if (table_column.start == AminoAcid::STOP_CODON) {
+
+      codon_flag_lookup_[table_index] |= STOP_FLAG_;
+
+    }
+
+  }
+
+  amino_lookup_[LOOKUP_N_INDEX_] = AminoAcid::AMINO_UNKNOWN;
+  codon_flag_lookup_[LOOKUP_N_INDEX_] = 0;
+
+}
+
+
+uint8_t kgl::AminoTranslationTable::baseCode(CodingDNA5::Alphabet base) {
+
+  switch (base) {
+
+    case CodingDNA5::Alphabet::A: return CodingDNA5::A_NUCLEOTIDE_OFFSET;
+    case CodingDNA5::Alphabet::C: return CodingDNA5::C_NUCLEOTIDE_OFFSET;
+    case CodingDNA5::Alphabet::G: return CodingDNA5::G_NUCLEOTIDE_OFFSET;
+    case CodingDNA5::Alphabet::T: return CodingDNA5::T_NUCLEOTIDE_OFFSET;
+    case CodingDNA5::Alphabet::N: return BASE_N_CODE_;
+
+  }
+
+  return BASE_N_CODE_; //  Never reached, to keep the compiler happy.
+
+}
+
+
+// The base codes are combined into the 6 bit table index, the 'N' base code (64) moves the index past the
+// table so that min(index, LOOKUP_N_INDEX_) selects the unknown amino acid without branching.
+kgl::CodonTranslation kgl::AminoTranslationTable::translateSequence(const DNA5SequenceCoding& coding_sequence) const {
+
+  // Base codes of the alphabet, indexed by the underlying char value.
+  static const std::array<uint8_t, 256> base_code_table = []() {
+
+    std::array<uint8_t, 256> code_table{};
+    code_table.fill(BASE_N_CODE_);
+    for (auto base : CodingDNA5::enumerateAlphabet()) {
+
+      code_table[static_cast<unsigned char>(base)] = baseCode(base);
+
+    }
+    return code_table;
+
+  }();
+
+  CodonTranslation translation;
+  const size_t codon_count = Codon::codonLength(coding_sequence);
+  translation.amino_string.reserve(codon_count);
+
+  uint8_t codon_flags{0};
+  bool nonsense_found{false};
+  auto base_iter = coding_sequence.getAlphabetString().begin();
+  for (size_t codon_index = 0; codon_index < codon_count; ++codon_index) {
+
+    const size_t base1 = base_code_table[static_cast<unsigned char>(*base_iter++)];
+    const size_t base2 = base_code_table[static_cast<unsigned char>(*base_iter++)];
+    const size_t base3 = base_code_table[static_cast<unsigned char>(*base_iter++)];
+
+    const size_t codon_code = (base1 * Tables::CODING_NUCLEOTIDE_1) + (base2 * Tables::CODING_NUCLEOTIDE_2) + base3;
+    const size_t lookup_index = std::min(codon_code, LOOKUP_N_INDEX_);
+
+    translation.amino_string.push_back(amino_lookup_[lookup_index]);
+    codon_flags = codon_flag_lookup_[lookup_index];
+
+    if (codon_index == 0) {
+
+      translation.start_codon = (codon_flags & START_FLAG_) != 0;
+
+    }
+
+    if ((codon_flags & STOP_FLAG_) != 0 and not nonsense_found and codon_index + 1 < codon_count) {
+
+      translation.nonsense_index = codon_index;
+      nonsense_found = true;
+
+    }
+
+  }
+
+  translation.stop_codon = codon_count > 0 and (codon_flags & STOP_FLAG_) != 0;
+
+  return translation;
+
+}
@@ -18,6 +18,16 @@ namespace kellerberrin::genome {   //  organization level namespace
 // Coding Table Class
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// The result of a single pass translation of a coding sequence.
+struct CodonTranslation {
+
+  AlphabetString<AminoAcid> amino_string;
+  bool start_codon{false};      // The first codon is a start codon.
+  bool stop_codon{false};       // The last codon is a stop codon.
+  size_t nonsense_index{0};     // First stop codon before the last codon, 0 if none (as TranslateToAmino::checkNonsenseMutation).
+
+};
+
 
 // Amino acid Translation tables
 // Found at https://www.ncbi.nlm.nih.gov/Taxonomy/Utils/wprintgc.cgi
@@ -25,7 +35,7 @@ class AminoTranslationTable {
 
 public:
 
-  explicit AminoTranslationTable() : amino_table_rows_(*Tables::STANDARDTABLE) {}
+  explicit AminoTranslationTable() : amino_table_rows_(*Tables::STANDARDTABLE) { createLookup(); }
   ~AminoTranslationTable() = default;
 
   [[nodiscard]] std::string TableName() const { return amino_table_rows_.table_name; }
@@ -46,13 +56,29 @@ public:
 
   [[nodiscard]] bool isStartCodon(const Codon& codon) const;
 
+  // Translate the whole sequence using the codon lookup tables, start and stop codons are checked in the same pass.
+  [[nodiscard]] CodonTranslation translateSequence(const DNA5SequenceCoding& coding_sequence) const;
+
 private:
 
   constexpr static size_t CONTAINS_BASE_N = 1000;
 
   TranslationTable amino_table_rows_;
 
+  // Codons are encoded as a 6 bit table index, a codon containing an 'N' base is mapped to LOOKUP_N_INDEX_.
+  constexpr static const size_t LOOKUP_N_INDEX_{Tables::AMINO_TABLE_SIZE};
+  constexpr static const size_t LOOKUP_SIZE_{Tables::AMINO_TABLE_SIZE + 1};
+  constexpr static const uint8_t START_FLAG_{0x1};
+  constexpr static const uint8_t STOP_FLAG_{0x2};
+  // The base code of 'N' sets bit 6 of the codon index.
+  constexpr static const uint8_t BASE_N_CODE_{0x40};
+
+  std::array<AminoAcid::Alphabet, LOOKUP_SIZE_> amino_lookup_;
+  std::array<uint8_t, LOOKUP_SIZE_> codon_flag_lookup_;
+
   [[nodiscard]] size_t index(const Codon& Codon) const;
+  void createLookup();
+  [[nodiscard]] static uint8_t baseCode(CodingDNA5::Alphabet base);
 
 };
 